@@ -0,0 +1,69 @@
+// Counts the allocations of a benchmark by replacing the global operator
+// new and delete.  Include it in one file of the program only.
+
+#ifndef TCLAP_BENCH_ALLOCATIONS_H
+#define TCLAP_BENCH_ALLOCATIONS_H
+
+#include <cstdlib>
+#include <new>
+
+// The allocations made so far.
+static unsigned long allocations = 0;
+
+#if __cplusplus >= 201103L
+#define BENCH_THROW_BAD_ALLOC
+#define BENCH_NOTHROW noexcept
+#else
+#define BENCH_THROW_BAD_ALLOC throw(std::bad_alloc)
+#define BENCH_NOTHROW throw()
+#endif
+
+// Not inlined, or the compiler pairs the malloc() and free() inside them
+// with new and delete in the library and warns of a mismatch.
+#if defined(__GNUC__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+BENCH_NOINLINE void* operator new(std::size_t size) BENCH_THROW_BAD_ALLOC
+{
+	allocations++;
+	void* p = std::malloc(size > 0 ? size : 1);
+	if (p == NULL)
+		throw std::bad_alloc();
+	return p;
+}
+
+BENCH_NOINLINE void* operator new[](std::size_t size) BENCH_THROW_BAD_ALLOC
+{
+	allocations++;
+	void* p = std::malloc(size > 0 ? size : 1);
+	if (p == NULL)
+		throw std::bad_alloc();
+	return p;
+}
+
+BENCH_NOINLINE void operator delete(void* p) BENCH_NOTHROW
+{
+	std::free(p);
+}
+
+BENCH_NOINLINE void operator delete[](void* p) BENCH_NOTHROW
+{
+	std::free(p);
+}
+
+#if __cplusplus >= 201402L
+BENCH_NOINLINE void operator delete(void* p, std::size_t) BENCH_NOTHROW
+{
+	std::free(p);
+}
+
+BENCH_NOINLINE void operator delete[](void* p, std::size_t) BENCH_NOTHROW
+{
+	std::free(p);
+}
+#endif
+
+#endif
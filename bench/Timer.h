@@ -0,0 +1,42 @@
+// Minimal wall clock timer shared by the benchmarks.
+
+#ifndef TCLAP_BENCH_TIMER_H
+#define TCLAP_BENCH_TIMER_H
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+class Timer
+{
+	public:
+
+		Timer() : _start(now()) {}
+
+		void restart() { _start = now(); }
+
+		// Seconds since construction or the last restart().
+		double elapsed() const { return now() - _start; }
+
+		static double now()
+		{
+#if defined(_WIN32)
+			LARGE_INTEGER freq, count;
+			QueryPerformanceFrequency(&freq);
+			QueryPerformanceCounter(&count);
+			return static_cast<double>(count.QuadPart) / freq.QuadPart;
+#else
+			struct timeval tv;
+			gettimeofday(&tv, NULL);
+			return tv.tv_sec + tv.tv_usec * 1e-6;
+#endif
+		}
+
+	private:
+
+		double _start;
+};
+
+#endif
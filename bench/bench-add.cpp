@@ -0,0 +1,61 @@
+// Measures how the cost of registering Args with a CmdLine scales with
+// the number of Args, adding them one at a time and all at once.
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+#include "Timer.h"
+
+using namespace TCLAP;
+
+static std::string optName(int n)
+{
+	std::ostringstream os;
+	os << "option" << n;
+	return os.str();
+}
+
+// Returns the time per Arg to add numArgs Args to a new CmdLine.
+static double nsPerArg(int numArgs, int iterations, bool bulk)
+{
+	std::vector<Arg*> args;
+	for (int n = 0; n < numArgs; n++)
+		args.push_back(new ValueArg<int>("", optName(n), "an option",
+		                                 false, 0, "int"));
+
+	double elapsed = 0;
+	Timer timer;
+	for (int it = 0; it < iterations; it++) {
+		CmdLine cmd("add benchmark", ' ', "1.0");
+		timer.restart();
+		if (bulk)
+			cmd.add(args);
+		else
+			for (size_t n = 0; n < args.size(); n++)
+				cmd.add(args[n]);
+		elapsed += timer.elapsed();
+	}
+
+	for (size_t n = 0; n < args.size(); n++)
+		delete args[n];
+
+	return elapsed * 1e9 / (static_cast<double>(iterations) * numArgs);
+}
+
+int main()
+{
+	const int sizes[] = { 100, 1000, 10000 };
+
+	std::printf("%10s %14s %14s\n", "args", "add ns/arg", "bulk ns/arg");
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+		int iterations = 1000000 / (sizes[s] * 10) + 1;
+		std::printf("%10d %14.1f %14.1f\n", sizes[s],
+		            nsPerArg(sizes[s], iterations, false),
+		            nsPerArg(sizes[s], iterations, true));
+	}
+
+	return 0;
+}
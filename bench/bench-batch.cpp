@@ -0,0 +1,82 @@
+// Measures the throughput of parsing a batch of command lines against one
+// CmdLine with BatchParser, for an increasing number of threads.
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+#include "tclap/BatchParser.h"
+#include "Timer.h"
+
+using namespace TCLAP;
+
+// A job line of the kind found in a manifest, every hundredth one invalid.
+static std::vector<std::string> jobLine(int n)
+{
+	std::vector<std::string> line;
+	line.push_back("job");
+
+	std::ostringstream os;
+	os << n;
+	line.push_back("--id");
+	line.push_back(os.str());
+	line.push_back("-t");
+	line.push_back(os.str().substr(0, 2));
+	line.push_back("--input");
+	line.push_back("/data/in/" + os.str() + ".dat");
+	line.push_back("--tag");
+	line.push_back("nightly");
+	line.push_back("--tag");
+	line.push_back(n % 100 == 99 ? "" : "batch");
+	line.push_back(n % 3 ? "-vq" : "-v");
+	line.push_back("/data/out/" + os.str());
+	if (n % 100 == 42)
+		line.push_back("--unknown");
+	return line;
+}
+
+static void run(const CmdLine& cmd,
+                const std::vector< std::vector<std::string> >& lines,
+                unsigned int numThreads, int iterations)
+{
+	BatchParser batch(cmd, numThreads);
+	batch.parse(lines);   // warm up, allocates the results
+
+	Timer timer;
+	for (int it = 0; it < iterations; it++)
+		batch.parse(lines);
+	double elapsed = timer.elapsed();
+
+	double perSecond = static_cast<double>(lines.size()) * iterations / elapsed;
+	std::printf("%10u %14.0f %14.1f %10lu\n", batch.getThreadCount(),
+	            perSecond, 1e9 / perSecond,
+	            static_cast<unsigned long>(batch.getErrorCount()));
+}
+
+int main()
+{
+	CmdLine cmd("batch benchmark", ' ', "1.0");
+	ValueArg<long> id("", "id", "job id", true, 0, "long", cmd);
+	ValueArg<int> threads("t", "threads", "threads", false, 1, "int", cmd);
+	ValueArg<std::string> input("", "input", "input", true, "", "file", cmd);
+	MultiArg<std::string> tags("", "tag", "tags", false, "string", cmd);
+	SwitchArg verbose("v", "verbose", "verbose", cmd);
+	SwitchArg quiet("q", "quiet", "quiet", cmd);
+	UnlabeledValueArg<std::string> output("output", "output", true, "",
+	                                      "dir", cmd);
+
+	std::vector< std::vector<std::string> > lines;
+	for (int n = 0; n < 200000; n++)
+		lines.push_back(jobLine(n));
+
+	const unsigned int counts[] = { 1, 2, 4, 8, 0 };
+
+	std::printf("%10s %14s %14s %10s\n", "threads", "lines/s", "ns/line",
+	            "errors");
+	for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+		run(cmd, lines, counts[c], 5);
+
+	return 0;
+}
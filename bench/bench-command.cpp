@@ -0,0 +1,111 @@
+// Measures parsing a log of a million command lines, each given as one
+// string: split into a vector of strings by white space and parsed, as
+// ad-hoc code would, against parseCommand(), which splits with the quoting
+// rules of sh in a reused buffer.  Splitting alone is timed too.
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+#include "Timer.h"
+
+using namespace TCLAP;
+
+// A line of the kind found in a command log.
+static std::string commandLine(int n)
+{
+	std::ostringstream os;
+	os << "deploy --id " << n << " --env prod -v";
+	if (n % 4 == 0)
+		os << " --message 'nightly build " << n << "'";
+	else
+		os << " --message release-" << n;
+	os << " --tag \"team a\" --tag infra /srv/app/" << n;
+	return os.str();
+}
+
+// Splits at white space, ignoring quotes.
+static void splitWords(const std::string& line,
+                       std::vector<std::string>& words)
+{
+	words.clear();
+	std::istringstream is(line);
+	std::string word;
+	while (is >> word)
+		words.push_back(word);
+}
+
+static void report(const char* name, double elapsed, size_t lines,
+                   size_t bytes)
+{
+	std::printf("%-24s %10.1f %10.1f\n", name, elapsed * 1e9 / lines,
+	            bytes / elapsed / 1e6);
+}
+
+int main()
+{
+	CmdLine cmd("command benchmark", ' ', "1.0");
+	ValueArg<int> id("", "id", "job id", true, 0, "int", cmd);
+	ValueArg<std::string> env("", "env", "environment", false, "", "env", cmd);
+	ValueArg<std::string> message("", "message", "message", false, "",
+	                              "text", cmd);
+	MultiArg<std::string> tags("", "tag", "tags", false, "tag", cmd);
+	SwitchArg verbose("v", "verbose", "verbose", cmd, false);
+	UnlabeledValueArg<std::string> path("path", "path", true, "", "path",
+	                                    cmd);
+
+	std::vector<std::string> log;
+	size_t bytes = 0;
+	for (int n = 0; n < 1000000; n++) {
+		log.push_back(commandLine(n));
+		bytes += log.back().length();
+	}
+
+	std::printf("%-24s %10s %10s\n", "", "ns/line", "MB/s");
+
+	std::vector<std::string> words;
+	size_t count = 0;
+	Timer timer;
+	for (size_t i = 0; i < log.size(); i++) {
+		splitWords(log[i], words);
+		count += words.size();
+	}
+	report("split, istringstream", timer.elapsed(), log.size(), bytes);
+
+	ShellTokenizer tokenizer;
+	timer.restart();
+	for (size_t i = 0; i < log.size(); i++) {
+		tokenizer.tokenize(log[i]);
+		count += tokenizer.size();
+	}
+	report("split, ShellTokenizer", timer.elapsed(), log.size(), bytes);
+
+	ParseResult result;
+	size_t errors = 0;
+	timer.restart();
+	for (size_t i = 0; i < log.size(); i++) {
+		splitWords(log[i], words);
+		if (!cmd.tryParse(words, result))
+			errors++;
+	}
+	report("parse, istringstream", timer.elapsed(), log.size(), bytes);
+
+	size_t commandErrors = 0;
+	timer.restart();
+	for (size_t i = 0; i < log.size(); i++)
+		if (!cmd.tryParseCommand(log[i], result))
+			commandErrors++;
+	report("parse, tryParseCommand", timer.elapsed(), log.size(), bytes);
+
+	// splitting without quotes breaks the quoted values apart, so those
+	// lines are rejected
+	std::printf("%lu words, %lu lines rejected after istringstream, "
+	            "%lu after tryParseCommand\n",
+	            static_cast<unsigned long>(count),
+	            static_cast<unsigned long>(errors),
+	            static_cast<unsigned long>(commandErrors));
+
+	return 0;
+}
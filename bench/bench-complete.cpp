@@ -0,0 +1,103 @@
+// Measures answering "--__complete": the flags and names from their
+// sorted index, the values of a ValuesConstraint, and the values of a
+// CompletionProvider that is slow to ask, looked up each time against
+// read from its cache file.
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+#include "Timer.h"
+
+using namespace TCLAP;
+
+// stands for asking a server for the names of its datasets
+class DatasetProvider : public CompletionProvider
+{
+	public:
+		DatasetProvider(int cacheTime) : CompletionProvider(cacheTime) { }
+
+		virtual void getValues(std::vector<std::string>& values)
+		{
+			for (int i = 0; i < 2000; i++) {
+				std::ostringstream os;
+				os << "dataset-" << (i * 7919) % 2000;
+				values.push_back(os.str());
+			}
+		}
+};
+
+static void run(const char* what, const CmdLine& cmd,
+                const std::vector<std::string>& words, int iterations)
+{
+	std::ostringstream out;
+	Timer timer;
+	for (int it = 0; it < iterations; it++) {
+		out.str("");
+		cmd.complete(words, words.size() - 1, out);
+	}
+	double t = timer.elapsed();
+
+	std::printf("%-24s %14.2f %10lu\n", what, t * 1e6 / iterations,
+	            static_cast<unsigned long>(out.str().length()));
+}
+
+int main()
+{
+	CmdLine cmd("completion benchmark", ' ', "1.0");
+
+	std::vector<std::string> levels;
+	for (int i = 0; i < 100; i++) {
+		std::ostringstream os;
+		os << "level" << i;
+		levels.push_back(os.str());
+	}
+	ValuesConstraint<std::string> allowedLevels(levels);
+
+	std::vector<Arg*> args;
+	for (int i = 0; i < 100; i++) {
+		std::ostringstream os;
+		os << "option" << i;
+		args.push_back(new ValueArg<int>("", os.str(), "an option", false,
+		                                 0, "int"));
+		cmd.add(args.back());
+	}
+	ValueArg<std::string> level("", "level", "the level", false, "level0",
+	                            &allowedLevels, cmd);
+	ValueArg<std::string> direct("", "direct", "a dataset", false, "",
+	                             "dataset", cmd);
+	ValueArg<std::string> cached("", "cached", "a dataset", false, "",
+	                             "dataset", cmd);
+
+	DatasetProvider slow(0);
+	DatasetProvider fast(3600);
+	direct.setCompletionProvider(&slow);
+	cached.setCompletionProvider(&fast);
+
+	std::vector<std::string> words(1, "bench-complete");
+	std::printf("%-24s %14s %10s\n", "completing", "us/completion", "bytes");
+
+	words.push_back("--option1");
+	run("names", cmd, words, 20000);
+
+	words.back() = "--level";
+	words.push_back("level4");
+	run("constraint values", cmd, words, 20000);
+
+	words[1] = "--direct";
+	words.back() = "dataset-19";
+	run("provider values", cmd, words, 200);
+
+	const std::string path = Completion::cachePath(words[0], &cached);
+	if (!path.empty()) {
+		words[1] = "--cached";
+		run("cached provider values", cmd, words, 200);
+		std::remove(path.c_str());
+	}
+
+	for (size_t i = 0; i < args.size(); i++)
+		delete args[i];
+	return 0;
+}
@@ -0,0 +1,59 @@
+// Measures checking many values of a MultiArg against a large set of
+// allowed identifiers, with ValuesConstraint and SortedValuesConstraint,
+// including building the constraint.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+#include "Timer.h"
+
+using namespace TCLAP;
+
+static const int NUM_ALLOWED = 5000;
+static const int NUM_VALUES = 20000;
+
+template<class C>
+static void run(const char* name, const std::vector<std::string>& allowed,
+                const std::vector<std::string>& args)
+{
+	Timer timer;
+	C constraint(allowed);
+	double build = timer.elapsed();
+
+	CmdLine cmd("bench");
+	MultiArg<std::string> tenants("t", "tenant", "tenants", false,
+	                              &constraint, cmd);
+	ParseResult result;
+	timer.restart();
+	cmd.parse(args, result);
+	double parse = timer.elapsed();
+
+	std::printf("%-24s %10.2f %10.1f%s\n", name, build * 1e3,
+	            parse * 1e9 / NUM_VALUES,
+	            tenants.getValue(result).size() ==
+	                static_cast<size_t>(NUM_VALUES) ? "" : "  MISMATCH");
+}
+
+int main()
+{
+	std::vector<std::string> allowed;
+	char s[32];
+	for (int n = 0; n < NUM_ALLOWED; n++) {
+		std::sprintf(s, "tenant-%05d", (n * 7919) % 100000);
+		allowed.push_back(s);
+	}
+
+	std::vector<std::string> args(1, "bench");
+	for (int n = 0; n < NUM_VALUES; n++) {
+		args.push_back("-t");
+		args.push_back(allowed[(n * 31) % NUM_ALLOWED]);
+	}
+
+	std::printf("%-24s %10s %10s\n", "", "build ms", "ns/value");
+	run< ValuesConstraint<std::string> >("ValuesConstraint", allowed, args);
+	run< SortedValuesConstraint<std::string> >("SortedValuesConstraint",
+	                                           allowed, args);
+	return 0;
+}
@@ -0,0 +1,127 @@
+// Measures how the cost of matching labeled arguments scales with the
+// number of Args registered with the CmdLine, and with the number of
+// them given, as ValueArgs and as MultiArgs.
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+#include "Timer.h"
+
+using namespace TCLAP;
+
+static std::string optName(int n)
+{
+	std::ostringstream os;
+	os << "option" << n;
+	return os.str();
+}
+
+static double nsPerToken(int numArgs, int numUsed, int iterations)
+{
+	CmdLine cmd("dispatch benchmark", ' ', "1.0");
+	cmd.setExceptionHandling(false);
+
+	std::vector<ValueArg<int>*> args;
+	for (int n = 0; n < numArgs; n++) {
+		args.push_back(new ValueArg<int>("", optName(n), "an option",
+		                                 false, 0, "int"));
+		cmd.add(args.back());
+	}
+
+	// use options spread evenly over the ones registered
+	std::vector<std::string> line;
+	line.push_back("bench-dispatch");
+	for (int n = 0; n < numUsed; n++) {
+		line.push_back("--" + optName(n * numArgs / numUsed));
+		line.push_back("42");
+	}
+
+	// reset() visits every Arg, so keep it out of the measurement
+	double elapsed = 0;
+	Timer timer;
+	for (int it = 0; it < iterations; it++) {
+		std::vector<std::string> tokens(line);
+		timer.restart();
+		cmd.parse(tokens);
+		elapsed += timer.elapsed();
+		cmd.reset();
+	}
+
+	for (size_t n = 0; n < args.size(); n++)
+		delete args[n];
+
+	return elapsed * 1e9 / (static_cast<double>(iterations) * (line.size() - 1));
+}
+
+// Parses a command line that gives each of numArgs options once.
+template<class A>
+static double msPerParse(int numArgs, int iterations)
+{
+	CmdLine cmd("dispatch benchmark", ' ', "1.0");
+	cmd.setExceptionHandling(false);
+
+	std::vector<A*> args;
+	std::vector<std::string> line;
+	line.push_back("bench-dispatch");
+	for (int n = 0; n < numArgs; n++) {
+		args.push_back(new A("", optName(n), "an option", false, "int"));
+		cmd.add(args.back());
+		line.push_back("--" + optName(n));
+		line.push_back("42");
+	}
+
+	double elapsed = 0;
+	Timer timer;
+	for (int it = 0; it < iterations; it++) {
+		ParseResult result;
+		timer.restart();
+		cmd.parse(line, result);
+		elapsed += timer.elapsed();
+	}
+
+	for (size_t n = 0; n < args.size(); n++)
+		delete args[n];
+
+	return elapsed * 1e3 / iterations;
+}
+
+// a ValueArg with the constructor of a MultiArg, which doesn't override
+// processArg()
+class IntValueArg : public ValueArg<int>
+{
+public:
+	IntValueArg(const std::string& flag, const std::string& name,
+	            const std::string& desc, bool req,
+	            const std::string& typeDesc)
+	: ValueArg<int>(flag, name, desc, req, 0, typeDesc) { }
+};
+
+int main()
+{
+	const int sizes[] = { 10, 100, 1000, 5000 };
+	const int numUsed = 10;
+
+	std::printf("%10s %12s\n", "args", "ns/token");
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+		int iterations = 2000000 / (sizes[s] + 100);
+		std::printf("%10d %12.1f\n", sizes[s],
+		            nsPerToken(sizes[s], numUsed, iterations));
+	}
+
+	// each option given once, the MultiArgs shouldn't scan the command
+	// line for their other values
+	const int given[] = { 2000, 4000, 8000 };
+
+	std::printf("\n%10s %12s %12s\n", "given", "ValueArg ms", "MultiArg ms");
+	for (size_t g = 0; g < sizeof(given) / sizeof(given[0]); g++) {
+		const int iterations = 40000 / given[g];
+		std::printf("%10d %12.2f %12.2f\n", given[g],
+		            msPerParse<IntValueArg>(given[g], iterations),
+		            msPerParse< MultiArg<int> >(given[g], iterations));
+	}
+
+	return 0;
+}
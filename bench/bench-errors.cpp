@@ -0,0 +1,111 @@
+// Measures the cost of rejecting invalid command lines: parse() throwing an
+// ArgException against tryParse() recording the error, with and without
+// formatting the message.  One line in five is invalid.
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+#include "Timer.h"
+
+using namespace TCLAP;
+
+static std::vector<std::string> jobLine(int n)
+{
+	std::vector<std::string> line;
+	line.push_back("job");
+
+	std::ostringstream os;
+	os << n;
+	line.push_back("--id");
+	line.push_back(os.str());
+	line.push_back("--level");
+	switch (n % 10) {
+		case 3: line.push_back("high"); break;     // can't be read
+		case 7: line.push_back("1000"); break;     // out of range
+		default: line.push_back(os.str().substr(0, 1)); break;
+	}
+	line.push_back("--tag");
+	line.push_back("nightly");
+	line.push_back("-v");
+	return line;
+}
+
+static void report(const char* name, double elapsed, size_t lines,
+                   size_t errors)
+{
+	std::printf("%-24s %14.1f %10lu\n", name, elapsed * 1e9 / lines,
+	            static_cast<unsigned long>(errors));
+}
+
+int main()
+{
+	CmdLine cmd("errors benchmark", ' ', "1.0");
+	cmd.setExceptionHandling(false);
+
+	ValueArg<int> id("", "id", "job id", true, 0, "int", cmd);
+	RangeConstraint<int> levels(0, 9);
+	ValueArg<int> level("", "level", "level", false, 0, &levels, cmd);
+	MultiArg<std::string> tags("", "tag", "tags", false, "tag", cmd);
+	SwitchArg verbose("v", "verbose", "verbose", cmd, false);
+
+	std::vector< std::vector<std::string> > lines;
+	for (int n = 0; n < 10000; n++)
+		lines.push_back(jobLine(n));
+
+	const int iterations = 20;
+	const size_t total = lines.size() * iterations;
+
+	std::printf("%-24s %14s %10s\n", "", "ns/line", "errors");
+
+	size_t errors = 0;
+	size_t length = 0;
+	Timer timer;
+	for (int it = 0; it < iterations; it++) {
+		for (size_t i = 0; i < lines.size(); i++) {
+			std::vector<std::string> tokens(lines[i]);
+			try {
+				cmd.parse(tokens);
+			} catch (ArgException& e) {
+				length += e.error().length();
+				errors++;
+			}
+			cmd.reset();
+		}
+	}
+	report("parse, throwing", timer.elapsed(), total, errors);
+
+	// copies the lines too, like parse() above
+	ParseResult result;
+	errors = 0;
+	timer.restart();
+	for (int it = 0; it < iterations; it++) {
+		for (size_t i = 0; i < lines.size(); i++) {
+			std::vector<std::string> tokens(lines[i]);
+			if (!cmd.tryParse(tokens, result))
+				errors++;
+		}
+	}
+	report("tryParse, code only", timer.elapsed(), total, errors);
+
+	errors = 0;
+	timer.restart();
+	for (int it = 0; it < iterations; it++) {
+		for (size_t i = 0; i < lines.size(); i++) {
+			std::vector<std::string> tokens(lines[i]);
+			if (!cmd.tryParse(tokens, result)) {
+				length += result.getError().length();
+				errors++;
+			}
+		}
+	}
+	report("tryParse, message", timer.elapsed(), total, errors);
+
+	// keep the messages from being optimized away
+	if (length == 0)
+		std::printf("no messages\n");
+
+	return 0;
+}
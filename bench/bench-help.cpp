@@ -0,0 +1,153 @@
+// Measures printing the usage of a CmdLine with thousands of Args: the way
+// StdOutput used to, copying the list of Args and flushing each line,
+// against rendering into one buffer written at once, and against printing
+// the usage kept from the last time.
+
+#include <cstdio>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+#include "Timer.h"
+
+using namespace TCLAP;
+
+// Discards what is written and counts the writes and flushes.
+class CountingBuf : public std::streambuf
+{
+	public:
+		CountingBuf() : std::streambuf(), writes(0), flushes(0), bytes(0) { }
+
+		unsigned long writes;
+		unsigned long flushes;
+		unsigned long bytes;
+
+	protected:
+		virtual int overflow(int c)
+		{
+			writes++;
+			bytes++;
+			return c;
+		}
+
+		virtual std::streamsize xsputn(const char*, std::streamsize n)
+		{
+			writes++;
+			bytes += static_cast<unsigned long>(n);
+			return n;
+		}
+
+		virtual int sync()
+		{
+			flushes++;
+			return 0;
+		}
+};
+
+// The usage as StdOutput printed it before it was buffered.
+class LegacyOutput : public StdOutput
+{
+	public:
+		virtual void usage(CmdLineInterface& c)
+		{
+			std::cout << std::endl << "USAGE: " << std::endl << std::endl;
+			std::list<Arg*> argList = c.getArgList();
+			std::string s = c.getProgramName() + " ";
+			for (ArgListIterator it = argList.begin(); it != argList.end(); it++)
+				s += " " + (*it)->shortID();
+			print(s, 3, static_cast<int>(c.getProgramName().length()) + 2);
+			std::cout << std::endl << std::endl << "Where: " << std::endl
+			          << std::endl;
+			argList = c.getArgList();
+			for (ArgListIterator it = argList.begin(); it != argList.end(); it++) {
+				print((*it)->longID(), 3, 3);
+				print((*it)->getDescription(), 5, 0);
+				std::cout << std::endl;
+			}
+			std::cout << std::endl;
+			print(c.getMessage(), 3, 0);
+			std::cout << std::endl;
+		}
+
+	private:
+		void print(const std::string& s, int indent, int offset)
+		{
+			int len = static_cast<int>(s.length());
+			int allowed = 75 - indent;
+			int start = 0;
+			while (start < len) {
+				int n = std::min(len - start, allowed);
+				if (n == allowed)
+					while (n >= 0 && s[n + start] != ' ' && s[n + start] != ',' &&
+					       s[n + start] != '|')
+						n--;
+				if (n <= 0)
+					n = allowed;
+				for (int i = 0; i < indent; i++)
+					std::cout << " ";
+				if (start == 0) {
+					indent += offset;
+					allowed -= offset;
+				}
+				std::cout << s.substr(start, n) << std::endl;
+				while (s[n + start] == ' ' && start < len)
+					start++;
+				start += n;
+			}
+		}
+};
+
+static void run(const char* what, CmdLine& cmd, StdOutput& output,
+                bool fresh, int iterations)
+{
+	CountingBuf buf;
+	std::streambuf* old = std::cout.rdbuf(&buf);
+
+	Timer timer;
+	for (int it = 0; it < iterations; it++) {
+		if (fresh) {
+			// a new output has nothing kept yet
+			StdOutput first(output);
+			first.usage(cmd);
+		} else
+			output.usage(cmd);
+	}
+	double t = timer.elapsed();
+	std::cout.rdbuf(old);
+
+	std::printf("%-10s %12.3f %10lu %10lu %10lu\n", what,
+	            t * 1e3 / iterations, buf.writes / iterations,
+	            buf.flushes / iterations, buf.bytes / iterations);
+}
+
+int main()
+{
+	CmdLine cmd("A tool with very many options, each with a description that "
+	            "takes more than one line of the usage.", ' ', "1.0");
+
+	std::vector<Arg*> args;
+	for (int i = 0; i < 3000; i++) {
+		std::ostringstream name;
+		name << "option-" << i;
+		args.push_back(new ValueArg<int>("", name.str(),
+		    "Sets the option of the same name, which takes an integer "
+		    "that is checked against its range when it is parsed.",
+		    false, 0, "int"));
+		cmd.add(args.back());
+	}
+
+	StdOutput buffered;
+	LegacyOutput legacy;
+
+	std::printf("%-10s %12s %10s %10s %10s\n", "usage", "ms/usage",
+	            "writes", "flushes", "bytes");
+	run("legacy", cmd, legacy, false, 20);
+	run("rendered", cmd, buffered, true, 20);
+	run("cached", cmd, buffered, false, 20);
+
+	for (size_t i = 0; i < args.size(); i++)
+		delete args[i];
+	return 0;
+}
@@ -0,0 +1,90 @@
+// Measures checking a command line after each argument as it is typed:
+// parsing all the arguments so far again each time, which is quadratic
+// in the length of the line, against IncrementalParser, which parses each
+// argument once.
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+#include "tclap/IncrementalParser.h"
+#include "Timer.h"
+
+using namespace TCLAP;
+
+static std::vector<std::string> typedLine(int numArgs)
+{
+	std::vector<std::string> line;
+	line.push_back("copy");
+	line.push_back("--count");
+	line.push_back("3");
+	for (int n = 0; static_cast<int>(line.size()) <= numArgs; n++) {
+		std::ostringstream os;
+		os << "/data/in/" << n << ".dat";
+		if (n % 3 == 0)
+			line.push_back("-v");
+		line.push_back("--include");
+		line.push_back(os.str());
+	}
+	line.push_back("/data/out");
+	return line;
+}
+
+static void run(const CmdLine& cmd, int numArgs, int iterations)
+{
+	const std::vector<std::string> line = typedLine(numArgs);
+	const size_t checks = (line.size() - 1) * iterations;
+
+	ParseResult result;
+	std::vector<std::string> prefix;
+	size_t valid = 0;
+	Timer timer;
+	for (int it = 0; it < iterations; it++) {
+		prefix.assign(1, line[0]);
+		for (size_t i = 1; i < line.size(); i++) {
+			prefix.push_back(line[i]);
+			if (cmd.tryParse(prefix, result))
+				valid++;
+		}
+	}
+	double reparseTime = timer.elapsed();
+
+	IncrementalParser parser(cmd);
+	timer.restart();
+	for (int it = 0; it < iterations; it++) {
+		parser.begin(line[0]);
+		for (size_t i = 1; i < line.size(); i++) {
+			parser.add(line[i]);
+			if (parser.isComplete())
+				valid++;
+		}
+	}
+	double incrementalTime = timer.elapsed();
+
+	std::printf("%10lu %18.1f %18.1f %8lu\n",
+	            static_cast<unsigned long>(line.size() - 1),
+	            reparseTime * 1e9 / checks, incrementalTime * 1e9 / checks,
+	            static_cast<unsigned long>(valid));
+}
+
+int main()
+{
+	CmdLine cmd("incremental benchmark", ' ', "1.0");
+	ValueArg<int> count("", "count", "copies", true, 1, "int", cmd);
+	MultiSwitchArg verbose("v", "verbose", "more output", cmd);
+	MultiArg<std::string> include("", "include", "files to include", false,
+	                              "file", cmd);
+	UnlabeledValueArg<std::string> target("target", "where to copy", false,
+	                                      "", "dir", cmd);
+
+	const int sizes[] = { 10, 100, 1000 };
+
+	std::printf("%10s %18s %18s %8s\n", "args", "reparse ns/arg",
+	            "incremental ns/arg", "valid");
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+		run(cmd, sizes[s], 100000 / (sizes[s] * sizes[s] / 10 + 10) + 1);
+
+	return 0;
+}
@@ -0,0 +1,58 @@
+// Measures parsing a command line that gives a value for each of many
+// options when the program only reads two of them, with the values
+// converted as they are parsed and converted lazily when read.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+#include "Timer.h"
+
+using namespace TCLAP;
+
+static const int NUM_OPTIONS = 40;
+static const int ITERATIONS = 5000;
+
+static double run(bool lazy, double& sum)
+{
+	CmdLine cmd("bench");
+	cmd.setLazyConversion(lazy);
+
+	std::vector<ValueArg<double>*> options;
+	std::vector<std::string> args(1, "bench");
+	char name[32], value[32];
+	for (int n = 0; n < NUM_OPTIONS; n++) {
+		std::sprintf(name, "option%d", n);
+		std::sprintf(value, "%.6e", n * 1.25);
+		options.push_back(new ValueArg<double>("", name, "an option", false,
+		                                       0.0, "float", cmd));
+		args.push_back(std::string("--") + name);
+		args.push_back(value);
+	}
+
+	ParseResult result;
+	Timer timer;
+	for (int it = 0; it < ITERATIONS; it++) {
+		cmd.parse(args, result);
+		sum += options[3]->getValue(result) + options[17]->getValue(result);
+	}
+	double t = timer.elapsed();
+
+	for (size_t k = 0; k < options.size(); k++)
+		delete options[k];
+	return t * 1e6 / ITERATIONS;
+}
+
+int main()
+{
+	double sum1 = 0, sum2 = 0;
+	double eager = run(false, sum1);
+	double lazy = run(true, sum2);
+	std::printf("%-24s %10s\n", "", "us/parse");
+	std::printf("%-24s %10.2f\n", "converted when parsed", eager);
+	std::printf("%-24s %10.2f\n", "converted when read", lazy);
+	if (sum1 != sum2)
+		std::printf("MISMATCH\n");
+	return 0;
+}
@@ -0,0 +1,82 @@
+// Measures reading a long list of integers into a MultiArg, given as one
+// delimited value in list mode, as a flag per value, and as one value
+// that the program splits itself.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+#include "Timer.h"
+
+using namespace TCLAP;
+
+static const int NUM_VALUES = 200000;
+
+static double parseList(std::vector<std::string> args, char sep,
+                        size_t& count)
+{
+	Timer timer;
+	CmdLine cmd("bench");
+	MultiArg<int> ids("i", "ids", "ids", false, "int", cmd);
+	if (sep != '\0')
+		ids.setListSeparator(sep);
+	cmd.parse(args);
+	count = ids.getValue().size();
+	return timer.elapsed();
+}
+
+static double parseSplit(std::vector<std::string> args, size_t& count)
+{
+	Timer timer;
+	CmdLine cmd("bench");
+	ValueArg<std::string> list("i", "ids", "ids", false, "", "list", cmd);
+	cmd.parse(args);
+
+	std::vector<int> ids;
+	std::istringstream is(list.getValue());
+	std::string item;
+	while (std::getline(is, item, ',')) {
+		int v;
+		ExtractValue(v, item, ValueLike());
+		ids.push_back(v);
+	}
+	count = ids.size();
+	return timer.elapsed();
+}
+
+int main()
+{
+	std::string list;
+	std::vector<std::string> repeated(1, "bench");
+	char s[32];
+	for (int n = 0; n < NUM_VALUES; n++) {
+		std::sprintf(s, "%d", (n * 7919) % 100000);
+		if (n > 0)
+			list += ',';
+		list += s;
+		repeated.push_back("-i");
+		repeated.push_back(s);
+	}
+
+	std::vector<std::string> single(1, "bench");
+	single.push_back("--ids");
+	single.push_back(list);
+
+	size_t c1, c2, c3;
+	double t1 = parseList(single, ',', c1);
+	double t2 = parseList(repeated, '\0', c2);
+	double t3 = parseSplit(single, c3);
+
+	std::printf("%-24s %10s %10s\n", "", "ms", "ns/value");
+	std::printf("%-24s %10.2f %10.1f\n", "list separator", t1 * 1e3,
+	            t1 * 1e9 / c1);
+	std::printf("%-24s %10.2f %10.1f\n", "repeated flag", t2 * 1e3,
+	            t2 * 1e9 / c2);
+	std::printf("%-24s %10.2f %10.1f\n", "split by the program", t3 * 1e3,
+	            t3 * 1e9 / c3);
+
+	if (c1 != NUM_VALUES || c2 != NUM_VALUES || c3 != NUM_VALUES)
+		std::printf("MISMATCH\n");
+	return 0;
+}
@@ -0,0 +1,94 @@
+// Measures reading numeric values per type, through the number parser
+// that numeric types now use and through the stream that ValueLike types
+// use.
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+#include "Timer.h"
+
+using namespace TCLAP;
+
+// Values of the kind given on command lines: small and large, signed
+// and, for the floating point types, fractions and exponents.
+static std::vector<std::string> values(bool floating, bool negative)
+{
+	std::vector<std::string> v;
+	std::srand(1);
+	char s[64];
+	for (int n = 0; n < 10000; n++) {
+		int r = std::rand();
+		int sign = negative && r % 3 == 0 ? -1 : 1;
+		if (floating && r % 4 == 0)
+			std::sprintf(s, "%.6e", sign * r / 1000.0);
+		else if (floating)
+			std::sprintf(s, "%.3f", sign * (r % 100000) / 7.0);
+		else
+			std::sprintf(s, "%d", sign * (r % 2 ? r % 30000 : r % 100));
+		v.push_back(s);
+	}
+	return v;
+}
+
+template<typename T, typename Category>
+static double perValue(const std::vector<std::string>& v, int iterations,
+                       T& sum)
+{
+	Timer timer;
+	for (int it = 0; it < iterations; it++)
+		for (size_t i = 0; i < v.size(); i++) {
+			T t = T();
+			ExtractValue(t, v[i], Category());
+			sum += t;
+		}
+	return timer.elapsed() * 1e9 / (static_cast<double>(iterations) * v.size());
+}
+
+template<typename T>
+static void run(const char* name, bool floating, bool negative)
+{
+	std::vector<std::string> v = values(floating, negative);
+	T sum1 = T(), sum2 = T();
+	double number = perValue<T, NumberLike>(v, 50, sum1);
+	double stream = perValue<T, ValueLike>(v, 50, sum2);
+	std::printf("%-20s %12.1f %12.1f %8.1fx%s\n", name, number, stream,
+	            stream / number, sum1 == sum2 ? "" : "  MISMATCH");
+}
+
+// bools are only 0 or 1
+template<>
+void run<bool>(const char* name, bool, bool)
+{
+	std::vector<std::string> v(10000, "1");
+	for (size_t i = 0; i < v.size(); i += 2)
+		v[i] = "0";
+
+	int sum1 = 0, sum2 = 0;
+	double number = perValue<int, NumberLike>(v, 50, sum1);
+	double stream = perValue<int, ValueLike>(v, 50, sum2);
+	std::printf("%-20s %12.1f %12.1f %8.1fx%s\n", name, number, stream,
+	            stream / number, sum1 == sum2 ? "" : "  MISMATCH");
+}
+
+int main()
+{
+	std::printf("%-20s %12s %12s %9s\n", "type", "parser ns", "stream ns",
+	            "speedup");
+	run<bool>("bool", false, false);
+	run<short>("short", false, true);
+	run<unsigned short>("unsigned short", false, false);
+	run<int>("int", false, true);
+	run<unsigned int>("unsigned int", false, false);
+	run<long>("long", false, true);
+	run<unsigned long>("unsigned long", false, false);
+#ifdef TCLAP_HAS_LONG_LONG
+	run<long long>("long long", false, true);
+	run<unsigned long long>("unsigned long long", false, false);
+#endif
+	run<float>("float", true, true);
+	run<double>("double", true, true);
+	return 0;
+}
@@ -0,0 +1,104 @@
+// Measures checking values against a pattern with PatternConstraint and
+// with std::regex, for hostnames and for a pattern on which a
+// backtracking matcher takes time exponential in the length of the
+// value.  std::regex needs C++11, without it only PatternConstraint is
+// measured.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#if __cplusplus >= 201103L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201103L)
+#define BENCH_HAVE_REGEX
+#include <regex>
+#endif
+
+#include "tclap/CmdLine.h"
+#include "Timer.h"
+
+using namespace TCLAP;
+
+static const int NUM_HOSTS = 100000;
+
+static const char* const HOSTNAME =
+	"[a-z0-9]([a-z0-9-]{0,61}[a-z0-9])?(\\.[a-z0-9]([a-z0-9-]{0,61}[a-z0-9])?)*";
+
+// Nested repeats that can split a run of 'a's in exponentially many ways
+// before failing.
+static const char* const NESTED = "(a+)+b";
+
+static void hosts(const std::vector<std::string>& values)
+{
+	Timer timer;
+	PatternConstraint pattern(HOSTNAME);
+	double compile = timer.elapsed();
+	timer.restart();
+	size_t matched = 0;
+	for (size_t i = 0; i < values.size(); i++)
+		matched += pattern.check(values[i]);
+	std::printf("%-28s %12.1f %12.1f %8lu\n", "PatternConstraint hostname",
+	            compile * 1e6, timer.elapsed() * 1e9 / values.size(),
+	            static_cast<unsigned long>(matched));
+
+#ifdef BENCH_HAVE_REGEX
+	timer.restart();
+	std::regex regex(HOSTNAME);
+	compile = timer.elapsed();
+	timer.restart();
+	matched = 0;
+	for (size_t i = 0; i < values.size(); i++)
+		matched += std::regex_match(values[i], regex);
+	std::printf("%-28s %12.1f %12.1f %8lu\n", "std::regex hostname",
+	            compile * 1e6, timer.elapsed() * 1e9 / values.size(),
+	            static_cast<unsigned long>(matched));
+#endif
+}
+
+static void nested(size_t length, int repeat)
+{
+	const std::string value(length, 'a');
+	char name[64];
+
+	PatternConstraint pattern(NESTED);
+	Timer timer;
+	int matched = 0;
+	for (int r = 0; r < repeat; r++)
+		matched += pattern.check(value);
+	std::sprintf(name, "PatternConstraint %lu a's",
+	             static_cast<unsigned long>(length));
+	std::printf("%-28s %12s %12.1f %8d\n", name, "",
+	            timer.elapsed() * 1e9 / repeat, matched);
+
+#ifdef BENCH_HAVE_REGEX
+	// backtracking a long value would take forever
+	if (length > 24)
+		return;
+
+	std::regex regex(NESTED);
+	timer.restart();
+	matched = std::regex_match(value, regex);
+	std::sprintf(name, "std::regex %lu a's", static_cast<unsigned long>(length));
+	std::printf("%-28s %12s %12.1f %8d\n", name, "",
+	            timer.elapsed() * 1e9, matched);
+#endif
+}
+
+int main()
+{
+	std::vector<std::string> values;
+	char s[64];
+	for (int n = 0; n < NUM_HOSTS; n++) {
+		std::sprintf(s, n % 10 ? "build-%04d.ci%d.example.com"
+		                       : "build_%04d.ci%d.example.com",
+		             n % 10000, n % 7);
+		values.push_back(s);
+	}
+
+	std::printf("%-28s %12s %12s %8s\n", "", "compile us", "ns/value",
+	            "matched");
+	hosts(values);
+	for (size_t length = 16; length <= 24; length += 4)
+		nested(length, 100000);
+	nested(1000000, 10);
+	return 0;
+}
@@ -0,0 +1,101 @@
+// Measures checking many values against a range, with RangeConstraint,
+// which checks a whole list at once, and with a Constraint that only
+// implements check(), on their own for ints and doubles and when a long
+// list of doubles given as one value is read into a MultiArg.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+#include "Timer.h"
+
+using namespace TCLAP;
+
+static const int NUM_VALUES = 1000000;
+static const int REPEAT = 20;
+
+// What a program would write without RangeConstraint.
+template<class T>
+class BetweenConstraint : public Constraint<T>
+{
+	public:
+
+		BetweenConstraint(T low, T high) : _low(low), _high(high) {}
+
+		virtual std::string description() const { return "between"; }
+
+		virtual std::string shortID() const { return "between"; }
+
+		virtual bool check(const T& value) const
+		{
+			return _low <= value && value <= _high;
+		}
+
+	private:
+
+		T _low;
+		T _high;
+};
+
+template<class T>
+static double checkOnly(const Constraint<T>& constraint,
+                        const std::vector<T>& values)
+{
+	Timer timer;
+	size_t bad = 0;
+	for (int r = 0; r < REPEAT; r++)
+		bad += constraint.checkAll(&values[0], values.size()) -
+		       values.size();
+	double t = timer.elapsed();
+	return bad == 0 ? t / REPEAT : -1;
+}
+
+static double parseList(Constraint<double>& constraint,
+                        std::vector<std::string> args)
+{
+	Timer timer;
+	CmdLine cmd("bench");
+	MultiArg<double> weights("w", "weights", "weights", false, &constraint,
+	                         cmd);
+	weights.setListSeparator(',');
+	cmd.parse(args);
+	double t = timer.elapsed();
+	return weights.getValue().size() == static_cast<size_t>(NUM_VALUES)
+		? t : -1;
+}
+
+int main()
+{
+	std::vector<int> ints;
+	std::vector<double> values;
+	std::string list;
+	char s[32];
+	for (int n = 0; n < NUM_VALUES; n++) {
+		ints.push_back(n % 1000);
+		values.push_back((n % 1000) / 1000.0);
+		std::sprintf(s, "%s%g", n > 0 ? "," : "", values.back());
+		list += s;
+	}
+
+	std::vector<std::string> args(1, "bench");
+	args.push_back("-w");
+	args.push_back(list);
+
+	RangeConstraint<int> intRange(0, 999);
+	BetweenConstraint<int> intBetween(0, 999);
+	RangeConstraint<double> range(0.0, 1.0);
+	BetweenConstraint<double> between(0.0, 1.0);
+
+	std::printf("%-18s %12s %12s %12s\n", "", "int ns", "double ns",
+	            "parse ns");
+	std::printf("%-18s %12.3f %12.3f %12.1f\n", "RangeConstraint",
+	            checkOnly(intRange, ints) * 1e9 / NUM_VALUES,
+	            checkOnly(range, values) * 1e9 / NUM_VALUES,
+	            parseList(range, args) * 1e9 / NUM_VALUES);
+	std::printf("%-18s %12.3f %12.3f %12.1f\n", "check() per value",
+	            checkOnly(intBetween, ints) * 1e9 / NUM_VALUES,
+	            checkOnly(between, values) * 1e9 / NUM_VALUES,
+	            parseList(between, args) * 1e9 / NUM_VALUES);
+	return 0;
+}
@@ -0,0 +1,77 @@
+// Measures expanding a response file of 1M file names into an
+// UnlabeledMultiArg, against passing the same names as arguments.
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+#include "Timer.h"
+
+using namespace TCLAP;
+
+static const char* const responseFile = "bench-response.rsp";
+
+static std::string fileName(int n)
+{
+	char name[32];
+	std::sprintf(name, "/data/in/%07d.dat", n);
+	return name;
+}
+
+static void report(const char* label, double elapsed, int entries,
+                   const UnlabeledMultiArg<std::string>& files,
+                   const ParseResult& result)
+{
+	std::printf("%-12s %10.1f %12.1f %10lu\n", label, elapsed * 1e3,
+	            elapsed * 1e9 / entries,
+	            static_cast<unsigned long>(files.getValue(result).size()));
+}
+
+int main()
+{
+	const int entries = 1000000;
+	const int iterations = 3;
+
+	CmdLine cmd("response file benchmark", ' ', "1.0");
+	SwitchArg verbose("v", "verbose", "verbose", cmd);
+	UnlabeledMultiArg<std::string> files("file", "files", false, "file", cmd);
+
+	std::vector<std::string> args;
+	args.push_back("bench-response");
+	{
+		std::ofstream out(responseFile);
+		for (int n = 0; n < entries; n++) {
+			args.push_back(fileName(n));
+			out << args.back() << '\n';
+		}
+	}
+
+	std::printf("%-12s %10s %12s %10s\n", "source", "ms", "ns/entry",
+	            "files");
+
+	ParseResult result;
+	Timer timer;
+	for (int it = 0; it < iterations; it++)
+		cmd.tryParse(args, result);
+	report("arguments", timer.elapsed() / iterations, entries, files, result);
+
+	const std::string at = std::string("@") + responseFile;
+	const char* argv[] = { "bench-response", "-v", at.c_str() };
+	const ResponseFile::Format formats[] = { ResponseFile::LINES,
+	                                         ResponseFile::SHELL };
+	const char* labels[] = { "@file lines", "@file shell" };
+	for (int f = 0; f < 2; f++) {
+		cmd.setResponseFiles(formats[f]);
+		timer.restart();
+		for (int it = 0; it < iterations; it++)
+			if (!cmd.tryParse(3, argv, result))
+				std::printf("error: %s\n", result.getError().c_str());
+		report(labels[f], timer.elapsed() / iterations, entries, files,
+		       result);
+	}
+
+	std::remove(responseFile);
+	return 0;
+}
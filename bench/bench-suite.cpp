@@ -0,0 +1,710 @@
+// Runs a fixed set of parse scenarios and reports, for each, the time per
+// argument and the allocations per parse, of TCLAP and of getopt_long()
+// parsing the same command line.  The iteration counts are fixed and the
+// best of three runs is kept, so runs on the same machine are comparable.
+// With --json the results are written as JSON, to be kept per commit.
+
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+#include "Timer.h"
+#include "Allocations.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BENCH_GETOPT
+#include <getopt.h>
+#endif
+
+using namespace TCLAP;
+
+static std::string numbered(const std::string& s, int n)
+{
+	std::ostringstream os;
+	os << s << n;
+	return os.str();
+}
+
+#ifdef BENCH_GETOPT
+// Makes getopt_long() start again at the first argument.
+static void resetGetopt()
+{
+#if defined(__GLIBC__)
+	optind = 0;
+#else
+	optreset = 1;
+	optind = 1;
+#endif
+	opterr = 0;
+}
+#endif
+
+// A command line, the CmdLine that parses it, and the getopt_long() code
+// that parses it the same way.
+class Scenario
+{
+	public:
+		Scenario(const std::string& name, int iterations)
+		: _line(1, "bench-suite"), _name(name), _iterations(iterations),
+		  _argv(), _mutableArgv()
+		{ }
+
+		virtual ~Scenario() { }
+
+		const std::string& name() const { return _name; }
+
+		int iterations() const { return _iterations; }
+
+		// What ns/token is per: the arguments after the program name.
+		virtual std::size_t tokens() const { return _line.size() - 1; }
+
+		// Parses the command line with TCLAP, false if it isn't valid.
+		virtual bool parse() = 0;
+
+		virtual bool hasBaseline() const { return false; }
+
+		// Parses the command line with getopt_long().
+		virtual bool baseline() { return false; }
+
+		// Points argv at the arguments, once they are all added.
+		void prepare()
+		{
+			_argv.clear();
+			_mutableArgv.clear();
+			for (std::size_t i = 0; i < _line.size(); i++) {
+				_argv.push_back(_line[i].c_str());
+				_mutableArgv.push_back(&_line[i][0]);
+			}
+			_mutableArgv.push_back(NULL);
+		}
+
+	protected:
+		int argc() const { return static_cast<int>(_line.size()); }
+
+		const char* const* argv() const { return &_argv[0]; }
+
+		// getopt_long() takes char* const*, "+" keeps it from permuting.
+		char** mutableArgv() { return &_mutableArgv[0]; }
+
+		std::vector<std::string> _line;
+
+	private:
+		std::string _name;
+		int _iterations;
+		std::vector<const char*> _argv;
+		std::vector<char*> _mutableArgv;
+};
+
+// numArgs ValueArgs, of which 10 are given: "--option<n> 42".
+class DispatchScenario : public Scenario
+{
+	public:
+		DispatchScenario(int numArgs, int iterations)
+		: Scenario(numbered("dispatch-", numArgs), iterations),
+		  _cmd("dispatch", ' ', "1.0", false), _args(), _names(), _result(),
+		  _values(numArgs)
+#ifdef BENCH_GETOPT
+		  , _options()
+#endif
+		{
+			for (int n = 0; n < numArgs; n++) {
+				_names.push_back(numbered("option", n));
+				_args.push_back(new ValueArg<int>("", _names.back(),
+				                                  "an option", false, 0,
+				                                  "int"));
+				_cmd.add(_args.back());
+			}
+
+			for (int n = 0; n < 10; n++) {
+				_line.push_back("--" + _names[n * numArgs / 10]);
+				_line.push_back("42");
+			}
+
+#ifdef BENCH_GETOPT
+			for (int n = 0; n < numArgs; n++) {
+				struct option o = { _names[n].c_str(), required_argument,
+				                    NULL, 0 };
+				_options.push_back(o);
+			}
+			struct option end = { NULL, 0, NULL, 0 };
+			_options.push_back(end);
+#endif
+		}
+
+		virtual ~DispatchScenario()
+		{
+			for (std::size_t n = 0; n < _args.size(); n++)
+				delete _args[n];
+		}
+
+		virtual bool parse() { return _cmd.tryParse(argc(), argv(), _result); }
+
+#ifdef BENCH_GETOPT
+		virtual bool hasBaseline() const { return true; }
+
+		virtual bool baseline()
+		{
+			resetGetopt();
+			int c, index;
+			while ((c = getopt_long(argc(), mutableArgv(), "+", &_options[0],
+			                        &index)) != -1) {
+				if (c != 0)
+					return false;
+				_values[index] = static_cast<int>(std::strtol(optarg, NULL, 10));
+			}
+			return optind == argc();
+		}
+#endif
+
+	private:
+		CmdLine _cmd;
+		std::vector<ValueArg<int>*> _args;
+		std::vector<std::string> _names;
+		ParseResult _result;
+		std::vector<int> _values;
+#ifdef BENCH_GETOPT
+		std::vector<struct option> _options;
+#endif
+};
+
+// The switches -a to -z, given as "--switch-a ...", "-a ..." or as a
+// single "-abc...z".
+class SwitchScenario : public Scenario
+{
+	public:
+		SwitchScenario(const std::string& style, int iterations)
+		: Scenario("switches-" + style, iterations),
+		  _cmd("switches", ' ', "1.0", false), _args(), _names(), _result(),
+		  _set(26, false)
+#ifdef BENCH_GETOPT
+		  , _options()
+#endif
+		{
+			std::string combined = "-";
+			for (char c = 'a'; c <= 'z'; c++) {
+				const std::string flag(1, c);
+				_names.push_back("switch-" + flag);
+				_args.push_back(new SwitchArg(flag, _names.back(),
+				                              "a switch", false));
+				_cmd.add(_args.back());
+
+				if (style == "long")
+					_line.push_back("--" + _names.back());
+				else if (style == "short")
+					_line.push_back("-" + flag);
+				combined += flag;
+			}
+			if (style == "combined")
+				_line.push_back(combined);
+
+#ifdef BENCH_GETOPT
+			for (std::size_t n = 0; n < _names.size(); n++) {
+				struct option o = { _names[n].c_str(), no_argument, NULL,
+				                    'a' + static_cast<int>(n) };
+				_options.push_back(o);
+			}
+			struct option end = { NULL, 0, NULL, 0 };
+			_options.push_back(end);
+#endif
+		}
+
+		virtual ~SwitchScenario()
+		{
+			for (std::size_t n = 0; n < _args.size(); n++)
+				delete _args[n];
+		}
+
+		virtual bool parse() { return _cmd.tryParse(argc(), argv(), _result); }
+
+#ifdef BENCH_GETOPT
+		virtual bool hasBaseline() const { return true; }
+
+		virtual bool baseline()
+		{
+			resetGetopt();
+			_set.assign(_set.size(), false);
+			int c;
+			while ((c = getopt_long(argc(), mutableArgv(),
+			                        "+abcdefghijklmnopqrstuvwxyz",
+			                        &_options[0], NULL)) != -1) {
+				if (c < 'a' || c > 'z')
+					return false;
+				_set[c - 'a'] = true;
+			}
+			return optind == argc();
+		}
+#endif
+
+	private:
+		CmdLine _cmd;
+		std::vector<SwitchArg*> _args;
+		std::vector<std::string> _names;
+		ParseResult _result;
+		std::vector<bool> _set;
+#ifdef BENCH_GETOPT
+		std::vector<struct option> _options;
+#endif
+};
+
+// The ValueArgs -a to -z, each given once: "-a 1 -b 2 ...".
+class ValueScenario : public Scenario
+{
+	public:
+		explicit ValueScenario(int iterations)
+		: Scenario("value-arg", iterations),
+		  _cmd("values", ' ', "1.0", false), _args(), _result(), _values(26)
+		{
+			for (char c = 'a'; c <= 'z'; c++) {
+				const std::string flag(1, c);
+				_args.push_back(new ValueArg<int>(flag, "value-" + flag,
+				                                  "a value", false, 0, "int"));
+				_cmd.add(_args.back());
+				_line.push_back("-" + flag);
+				_line.push_back(numbered("", c - 'a'));
+			}
+		}
+
+		virtual ~ValueScenario()
+		{
+			for (std::size_t n = 0; n < _args.size(); n++)
+				delete _args[n];
+		}
+
+		virtual bool parse() { return _cmd.tryParse(argc(), argv(), _result); }
+
+#ifdef BENCH_GETOPT
+		virtual bool hasBaseline() const { return true; }
+
+		virtual bool baseline()
+		{
+			resetGetopt();
+			int c;
+			while ((c = getopt(argc(), mutableArgv(),
+			                   "+a:b:c:d:e:f:g:h:i:j:k:l:m:n:o:p:q:r:s:t:u:v:"
+			                   "w:x:y:z:")) != -1) {
+				if (c < 'a' || c > 'z')
+					return false;
+				_values[c - 'a'] = static_cast<int>(std::strtol(optarg, NULL, 10));
+			}
+			return optind == argc();
+		}
+#endif
+
+	private:
+		CmdLine _cmd;
+		std::vector<ValueArg<int>*> _args;
+		ParseResult _result;
+		std::vector<int> _values;
+};
+
+// numValues values of a MultiArg, "-i 0 -i 1 ...", or of an
+// UnlabeledMultiArg, "0 1 ...".
+class MultiScenario : public Scenario
+{
+	public:
+		MultiScenario(bool labeled, int numValues, int iterations)
+		: Scenario(labeled ? "multi-arg" : "unlabeled-multi-arg", iterations),
+		  _cmd("multi", ' ', "1.0", false),
+		  _multi("i", "int", "the values", false, "int"),
+		  _unlabeled("ints", "the values", false, "int"),
+		  _result(), _values(), _labeled(labeled)
+		{
+			if (labeled)
+				_cmd.add(_multi);
+			else
+				_cmd.add(_unlabeled);
+			for (int n = 0; n < numValues; n++) {
+				if (labeled)
+					_line.push_back("-i");
+				_line.push_back(numbered("", n % 1000));
+			}
+		}
+
+		virtual bool parse() { return _cmd.tryParse(argc(), argv(), _result); }
+
+#ifdef BENCH_GETOPT
+		virtual bool hasBaseline() const { return true; }
+
+		virtual bool baseline()
+		{
+			resetGetopt();
+			_values.clear();
+			int c;
+			while ((c = getopt(argc(), mutableArgv(), "+i:")) != -1) {
+				if (c != 'i')
+					return false;
+				_values.push_back(static_cast<int>(std::strtol(optarg, NULL, 10)));
+			}
+			if (_labeled)
+				return optind == argc();
+
+			for (int i = optind; i < argc(); i++)
+				_values.push_back(static_cast<int>(
+					std::strtol(mutableArgv()[i], NULL, 10)));
+			return true;
+		}
+#endif
+
+	private:
+		CmdLine _cmd;
+		MultiArg<int> _multi;
+		UnlabeledMultiArg<int> _unlabeled;
+		ParseResult _result;
+		std::vector<int> _values;
+		bool _labeled;
+};
+
+// 100 groups of 10 xor'd switches, one of each given: "--g<n>-<k>".
+class XorScenario : public Scenario
+{
+	public:
+		explicit XorScenario(int iterations)
+		: Scenario("xor", iterations),
+		  _cmd("xor", ' ', "1.0", false), _args(), _names(), _result(),
+		  _seen(100, false)
+#ifdef BENCH_GETOPT
+		  , _options()
+#endif
+		{
+			for (int g = 0; g < 100; g++) {
+				std::vector<Arg*> group;
+				for (int k = 0; k < 10; k++) {
+					_names.push_back(numbered(numbered("g", g) + "-", k));
+					_args.push_back(new SwitchArg("", _names.back(),
+					                              "a switch", false));
+					group.push_back(_args.back());
+				}
+				_cmd.xorAdd(group);
+				_line.push_back("--" + _names[g * 10 + g % 10]);
+			}
+
+#ifdef BENCH_GETOPT
+			for (std::size_t n = 0; n < _names.size(); n++) {
+				struct option o = { _names[n].c_str(), no_argument, NULL, 0 };
+				_options.push_back(o);
+			}
+			struct option end = { NULL, 0, NULL, 0 };
+			_options.push_back(end);
+#endif
+		}
+
+		virtual ~XorScenario()
+		{
+			for (std::size_t n = 0; n < _args.size(); n++)
+				delete _args[n];
+		}
+
+		virtual bool parse() { return _cmd.tryParse(argc(), argv(), _result); }
+
+#ifdef BENCH_GETOPT
+		virtual bool hasBaseline() const { return true; }
+
+		// getopt_long() has no groups, they are checked by hand
+		virtual bool baseline()
+		{
+			resetGetopt();
+			_seen.assign(_seen.size(), false);
+			int c, index;
+			while ((c = getopt_long(argc(), mutableArgv(), "+", &_options[0],
+			                        &index)) != -1) {
+				if (c != 0 || _seen[index / 10])
+					return false;
+				_seen[index / 10] = true;
+			}
+			return optind == argc();
+		}
+#endif
+
+	private:
+		CmdLine _cmd;
+		std::vector<SwitchArg*> _args;
+		std::vector<std::string> _names;
+		ParseResult _result;
+		std::vector<bool> _seen;
+#ifdef BENCH_GETOPT
+		std::vector<struct option> _options;
+#endif
+};
+
+// Renders the usage of numArgs ValueArgs at 75 columns, the time is per
+// Arg.  getopt has no usage.
+class HelpScenario : public Scenario
+{
+	public:
+		HelpScenario(int numArgs, int iterations)
+		: Scenario(numbered("help-", numArgs), iterations),
+		  _cmd("Renders the usage of many options.", ' ', "1.0"),
+		  _args(), _output(), _text()
+		{
+			for (int n = 0; n < numArgs; n++) {
+				_args.push_back(new ValueArg<int>("", numbered("option", n),
+				    "an option whose description is long enough to be "
+				    "wrapped onto a second line", false, 0, "int"));
+				_cmd.add(_args.back());
+			}
+		}
+
+		virtual ~HelpScenario()
+		{
+			for (std::size_t n = 0; n < _args.size(); n++)
+				delete _args[n];
+		}
+
+		virtual std::size_t tokens() const { return _args.size(); }
+
+		virtual bool parse()
+		{
+			_text.clear();
+			_output.renderUsage(_cmd, 75, _text);
+			return !_text.empty();
+		}
+
+	private:
+		CmdLine _cmd;
+		std::vector<ValueArg<int>*> _args;
+		StdOutput _output;
+		std::string _text;
+};
+
+// The scenarios, in the order they run, with their iterations.
+struct ScenarioSpec
+{
+	const char* name;
+	int iterations;
+};
+
+static const ScenarioSpec scenarios[] = {
+	{ "dispatch-10", 50000 },
+	{ "dispatch-100", 50000 },
+	{ "dispatch-10000", 500 },
+	{ "switches-long", 40000 },
+	{ "switches-short", 40000 },
+	{ "switches-combined", 200000 },
+	{ "value-arg", 20000 },
+	{ "multi-arg", 3 },
+	{ "unlabeled-multi-arg", 3 },
+	{ "xor", 10000 },
+	{ "help-100", 2000 }
+};
+
+static Scenario* createScenario(const std::string& name, int iterations)
+{
+	if (name == "dispatch-10")
+		return new DispatchScenario(10, iterations);
+	if (name == "dispatch-100")
+		return new DispatchScenario(100, iterations);
+	if (name == "dispatch-10000")
+		return new DispatchScenario(10000, iterations);
+	if (name == "switches-long")
+		return new SwitchScenario("long", iterations);
+	if (name == "switches-short")
+		return new SwitchScenario("short", iterations);
+	if (name == "switches-combined")
+		return new SwitchScenario("combined", iterations);
+	if (name == "value-arg")
+		return new ValueScenario(iterations);
+	if (name == "multi-arg")
+		return new MultiScenario(true, 500000, iterations);
+	if (name == "unlabeled-multi-arg")
+		return new MultiScenario(false, 1000000, iterations);
+	if (name == "xor")
+		return new XorScenario(iterations);
+	return new HelpScenario(100, iterations);
+}
+
+struct Measurement
+{
+	double nsPerToken;
+	double allocsPerParse;
+	unsigned long allocsFirstParse;
+};
+
+// Runs the TCLAP parse or the baseline of s, false if it failed.
+static bool measure(Scenario& s, bool baseline, Measurement& m)
+{
+	// the first parse grows the storage the others reuse
+	unsigned long before = allocations;
+	if (!(baseline ? s.baseline() : s.parse()))
+		return false;
+	m.allocsFirstParse = allocations - before;
+
+	double best = 0;
+	unsigned long allocs = 0;
+	for (int run = 0; run < 3; run++) {
+		bool ok = true;
+		before = allocations;
+		Timer timer;
+		for (int it = 0; it < s.iterations(); it++)
+			ok = (baseline ? s.baseline() : s.parse()) && ok;
+		const double elapsed = timer.elapsed();
+		allocs = allocations - before;
+
+		if (!ok)
+			return false;
+		if (run == 0 || elapsed < best)
+			best = elapsed;
+	}
+
+	m.nsPerToken = best * 1e9 /
+		(static_cast<double>(s.iterations()) * s.tokens());
+	m.allocsPerParse = static_cast<double>(allocs) / s.iterations();
+	return true;
+}
+
+struct Row
+{
+	explicit Row(const Scenario& s)
+	: name(s.name()), tokens(s.tokens()), iterations(s.iterations()),
+	  tclap(), hasBaseline(s.hasBaseline()), getopt()
+	{ }
+
+	std::string name;
+	std::size_t tokens;
+	int iterations;
+	Measurement tclap;
+	bool hasBaseline;
+	Measurement getopt;
+};
+
+static std::string jsonString(const std::string& s)
+{
+	std::string out = "\"";
+	for (std::size_t i = 0; i < s.length(); i++) {
+		const unsigned char c = static_cast<unsigned char>(s[i]);
+		if (c == '"' || c == '\\') {
+			out += '\\';
+			out += s[i];
+		}
+		else if (c < ' ') {
+			char u[7];
+			std::sprintf(u, "\\u%04x", c);
+			out += u;
+		}
+		else
+			out += s[i];
+	}
+	return out + "\"";
+}
+
+static void printMeasurement(std::FILE* f, const Measurement& m)
+{
+	std::fprintf(f, "{ \"ns_per_token\": %.2f, \"allocs_per_parse\": %.2f, "
+	             "\"allocs_first_parse\": %lu }",
+	             m.nsPerToken, m.allocsPerParse, m.allocsFirstParse);
+}
+
+static void printJson(std::FILE* f, const std::vector<Row>& rows,
+                      const std::string& label, bool quick)
+{
+	std::fprintf(f, "{\n  \"suite\": \"bench-suite\",\n  \"label\": %s,\n"
+	             "  \"quick\": %s,\n  \"scenarios\": [",
+	             jsonString(label).c_str(), quick ? "true" : "false");
+	for (std::size_t i = 0; i < rows.size(); i++) {
+		std::fprintf(f, "%s\n    { \"name\": %s, \"tokens\": %lu, "
+		             "\"iterations\": %d,\n      \"tclap\": ",
+		             i > 0 ? "," : "", jsonString(rows[i].name).c_str(),
+		             static_cast<unsigned long>(rows[i].tokens),
+		             rows[i].iterations);
+		printMeasurement(f, rows[i].tclap);
+		std::fprintf(f, ",\n      \"getopt_long\": ");
+		if (rows[i].hasBaseline)
+			printMeasurement(f, rows[i].getopt);
+		else
+			std::fprintf(f, "null");
+		std::fprintf(f, " }");
+	}
+	std::fprintf(f, "\n  ]\n}\n");
+}
+
+int main(int argc, char** argv)
+{
+	const std::size_t numScenarios = sizeof(scenarios) / sizeof(scenarios[0]);
+	std::vector<std::string> names;
+	for (std::size_t i = 0; i < numScenarios; i++)
+		names.push_back(scenarios[i].name);
+	ValuesConstraint<std::string> allowedNames(names);
+
+	CmdLine cmd("Parse throughput benchmarks", ' ', "1.0");
+	SwitchArg jsonArg("j", "json", "write the results as JSON", false);
+	SwitchArg quickArg("q", "quick", "run a tenth of the iterations", false);
+	ValueArg<std::string> outputArg("o", "output",
+		"write the results to this file instead of stdout", false, "", "file");
+	ValueArg<std::string> labelArg("l", "label",
+		"a label for the JSON results, e.g. the commit", false, "", "label");
+	UnlabeledMultiArg<std::string> scenarioArg("scenario",
+		"run only these scenarios", false, &allowedNames);
+	cmd.add(jsonArg);
+	cmd.add(quickArg);
+	cmd.add(outputArg);
+	cmd.add(labelArg);
+	cmd.add(scenarioArg);
+	cmd.parse(argc, argv);
+
+	const std::vector<std::string>& selected = scenarioArg.getValue();
+	const int divisor = quickArg.getValue() ? 10 : 1;
+
+	std::FILE* f = stdout;
+	if (!outputArg.getValue().empty()) {
+		f = std::fopen(outputArg.getValue().c_str(), "w");
+		if (f == NULL) {
+			std::fprintf(stderr, "can't write %s\n",
+			             outputArg.getValue().c_str());
+			return 1;
+		}
+	}
+
+	if (!jsonArg.getValue())
+		std::fprintf(f, "%-20s %8s %9s %10s %10s %10s %10s %10s\n",
+		             "scenario", "tokens", "runs", "ns/token", "allocs",
+		             "first", "getopt ns", "allocs");
+
+	std::vector<Row> rows;
+	for (std::size_t i = 0; i < numScenarios; i++) {
+		if (!selected.empty() &&
+		    std::find(selected.begin(), selected.end(),
+		              scenarios[i].name) == selected.end())
+			continue;
+
+		const int iterations = scenarios[i].iterations / divisor;
+		Scenario* s = createScenario(scenarios[i].name,
+		                             iterations > 0 ? iterations : 1);
+		s->prepare();
+
+		Row row(*s);
+		const bool ok = measure(*s, false, row.tclap) &&
+			( !row.hasBaseline || measure(*s, true, row.getopt) );
+		delete s;
+
+		if (!ok) {
+			std::fprintf(stderr, "%s: the command line wasn't parsed\n",
+			             row.name.c_str());
+			return 1;
+		}
+		rows.push_back(row);
+
+		if (jsonArg.getValue())
+			continue;
+
+		std::fprintf(f, "%-20s %8lu %9d %10.1f %10.1f %10lu",
+		             row.name.c_str(), static_cast<unsigned long>(row.tokens),
+		             row.iterations, row.tclap.nsPerToken,
+		             row.tclap.allocsPerParse, row.tclap.allocsFirstParse);
+		if (row.hasBaseline)
+			std::fprintf(f, " %10.1f %10.1f\n", row.getopt.nsPerToken,
+			             row.getopt.allocsPerParse);
+		else
+			std::fprintf(f, " %10s %10s\n", "-", "-");
+		std::fflush(f);
+	}
+
+	if (jsonArg.getValue())
+		printJson(f, rows, labelArg.getValue(), quickArg.getValue());
+
+	if (f != stdout)
+		std::fclose(f);
+	return 0;
+}
@@ -0,0 +1,53 @@
+// Counts the allocations and measures the time taken to read many values
+// into a MultiArg, one flag per value, for strings too long to be stored
+// in the string object itself and for ints.
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+#include "Timer.h"
+#include "Allocations.h"
+
+using namespace TCLAP;
+
+static const int NUM_VALUES = 100000;
+
+template<typename T>
+static void run(const char* name, const char* format)
+{
+	std::vector<std::string> args(1, "bench");
+	char s[64];
+	for (int n = 0; n < NUM_VALUES; n++) {
+		std::sprintf(s, format, n);
+		args.push_back("-v");
+		args.push_back(s);
+	}
+
+	CmdLine cmd("bench");
+	MultiArg<T> values("v", "values", "values", false, "value", cmd);
+
+	ParseResult result;
+	unsigned long before = allocations;
+	Timer timer;
+	cmd.parse(args, result);
+	double t = timer.elapsed();
+	unsigned long count = allocations - before;
+
+	size_t n = values.getValue(result).size();
+	std::printf("%-10s %10lu %14.2f %10.1f\n", name, count,
+	            static_cast<double>(count) / n, t * 1e9 / n);
+	if (n != static_cast<size_t>(NUM_VALUES))
+		std::printf("MISMATCH\n");
+}
+
+int main()
+{
+	std::printf("%-10s %10s %14s %10s\n", "type", "allocs", "allocs/value",
+	            "ns/value");
+	run<std::string>("string", "a-value-too-long-for-sso-%08d");
+	run<int>("int", "%d");
+	return 0;
+}
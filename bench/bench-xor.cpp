@@ -0,0 +1,92 @@
+// Measures how the cost of parsing and of rendering the usage scales with
+// the number of xor'd groups of Args registered with the CmdLine.
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+#include "Timer.h"
+
+using namespace TCLAP;
+
+// Renders the long usage into a string instead of printing it.
+class UsageOutput : public StdOutput
+{
+	public:
+
+		std::string longUsage(CmdLineInterface& cmd) const
+		{
+			std::ostringstream os;
+			_longUsage(cmd, os);
+			return os.str();
+		}
+};
+
+static std::string modeName(int n, const char* which)
+{
+	std::ostringstream os;
+	os << "mode" << n << "-" << which;
+	return os.str();
+}
+
+// Registers numGroups pairs of xor'd switches, parses a command line that
+// uses one switch of every group and renders the usage.  Reports the time
+// per argument for both.
+static void run(int numGroups, int iterations)
+{
+	CmdLine cmd("xor benchmark", ' ', "1.0");
+	cmd.setExceptionHandling(false);
+
+	std::vector<SwitchArg*> args;
+	for (int n = 0; n < numGroups; n++) {
+		args.push_back(new SwitchArg("", modeName(n, "on"), "enable", false));
+		args.push_back(new SwitchArg("", modeName(n, "off"), "disable", false));
+		cmd.xorAdd(*args[args.size() - 2], *args.back());
+	}
+
+	std::vector<std::string> line;
+	line.push_back("bench-xor");
+	for (int n = 0; n < numGroups; n++)
+		line.push_back("--" + modeName(n, n % 2 ? "on" : "off"));
+
+	double parseTime = 0;
+	Timer timer;
+	for (int it = 0; it < iterations; it++) {
+		std::vector<std::string> tokens(line);
+		timer.restart();
+		cmd.parse(tokens);
+		parseTime += timer.elapsed();
+		cmd.reset();
+	}
+
+	UsageOutput out;
+	size_t length = 0;
+	timer.restart();
+	for (int it = 0; it < iterations; it++)
+		length += out.longUsage(cmd).length();
+	double usageTime = timer.elapsed();
+
+	for (size_t n = 0; n < args.size(); n++)
+		delete args[n];
+
+	std::printf("%10d %14.1f %14.1f\n", numGroups,
+	            parseTime * 1e9 / (static_cast<double>(iterations) * numGroups),
+	            usageTime * 1e9 / (static_cast<double>(iterations) * args.size()));
+
+	// keep the rendering from being optimized away
+	if (length == 0)
+		std::printf("no usage\n");
+}
+
+int main()
+{
+	const int sizes[] = { 10, 100, 1000, 5000 };
+
+	std::printf("%10s %14s %14s\n", "groups", "parse ns/arg", "usage ns/arg");
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+		run(sizes[s], 200000 / (sizes[s] * 4 + 100) + 1);
+
+	return 0;
+}
@@ -19,6 +19,14 @@ int main(int argc, char** argv)
 
     SwitchArg atmcSwitch("a", "atmc", "aContinuous time semantics", false);
     SwitchArg btmcSwitch("b", "btmc", "bDiscrete time semantics",   false);
+
+    // the switches are xor'd in another CmdLine too, in another list
+    CmdLine other("Another command", '=', "0.9");
+    SwitchArg fastSwitch("f", "fast", "Fast", false);
+    SwitchArg slowSwitch("s", "slow", "Slow", false);
+    other.xorAdd(fastSwitch, slowSwitch);
+    other.xorAdd(atmcSwitch, btmcSwitch);
+
     cmd.xorAdd(atmcSwitch, btmcSwitch);
 
     // Parse the args.
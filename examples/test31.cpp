@@ -0,0 +1,43 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <tclap/CmdLine.h>
+
+using namespace TCLAP;
+using namespace std;
+
+int main(int argc, char** argv)
+{
+    try {
+
+    CmdLine cmd("Command description message", ' ', "0.9");
+
+    ValueArg<int> countArg("c", "count", "Number of things", false, 1, "int");
+    ValueArg<string> nameArg("n", "name", "Name to print", false, "homer",
+                             "string");
+    SwitchArg countSwitch("", "count", "Clashes with --count", false);
+
+    // adding several Args at once adds none of them if one clashes
+    vector<Arg*> args;
+    args.push_back(&countArg);
+    args.push_back(&nameArg);
+    args.push_back(&countSwitch);
+    try {
+        cmd.add(args);
+    } catch (SpecificationException &e) {
+        cout << "error: " << e.error() << " for arg " << e.argId() << endl;
+    }
+
+    args.pop_back();
+    cmd.add(args);
+
+    cmd.parse( argc, argv );
+
+    cout << "count: " << countArg.getValue() << endl;
+    cout << "name: " << nameArg.getValue() << endl;
+
+    } catch (ArgException &e)  // catch any exceptions
+    { cerr << "error: " << e.error() << " for arg " << e.argId() << endl; }
+}
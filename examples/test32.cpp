@@ -0,0 +1,128 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <tclap/CmdLine.h>
+
+using namespace TCLAP;
+using namespace std;
+
+static void print(const string& label, const ParseResult& result,
+                  const ValueArg<int>& count, const SwitchArg& verbose,
+                  const MultiArg<string>& names,
+                  const UnlabeledValueArg<string>& file)
+{
+    cout << label << ": count=" << count.getValue(result)
+         << " verbose=" << verbose.getValue(result) << " names=";
+
+    const vector<string>& v = names.getValue(result);
+    for (size_t i = 0; i < v.size(); i++)
+        cout << (i > 0 ? "," : "") << v[i];
+
+    cout << " file=" << file.getValue(result) << endl;
+}
+
+// an Arg of a class derived from ValueArg that overrides processArg(),
+// which the parse still calls
+class LoggedArg : public ValueArg<int>
+{
+public:
+    LoggedArg(const string& flag, const string& name, const string& desc,
+              CmdLine& parser)
+    : ValueArg<int>(flag, name, desc, false, 0, "int", parser) { }
+
+    virtual bool processArg(int* i, vector<string>& args)
+    {
+        cout << "processArg: " << args[*i] << endl;
+        return ValueArg<int>::processArg(i, args);
+    }
+
+    // processArg() is only called if the Arg doesn't parse tokens
+    virtual bool parsesTokens() const { return false; }
+};
+
+int main(int argc, char** argv)
+{
+    try {
+
+    CmdLine cmd("Command description message", ' ', "0.9");
+    cmd.setExceptionHandling(false);
+
+    ValueArg<int> count("c", "count", "Number of things", false, 1, "int",
+                        cmd);
+    SwitchArg verbose("v", "verbose", "Talk a lot", cmd, false);
+    MultiArg<string> names("n", "name", "Names to print", false, "string",
+                           cmd);
+    UnlabeledValueArg<string> file("file", "File to read", false, "none",
+                                   "file", cmd);
+
+    // each parse has its own result, the CmdLine and its Args are only
+    // read, so the parses could be in different threads
+    ParseResult a;
+    cmd.parse(argc, argv, a);
+
+    vector<string> line;
+    line.push_back("other");
+    line.push_back("-c");
+    line.push_back("7");
+    line.push_back("--");
+    line.push_back("-v");
+    ParseResult b;
+    cmd.parse(line, b);
+
+    print("a", a, count, verbose, names, file);
+    print("b", b, count, verbose, names, file);
+
+    // "--" in one parse doesn't affect the next one
+    cmd.parse(argc, argv, b);
+    print("b again", b, count, verbose, names, file);
+
+    cout << "args: count=" << count.getValue() << " set=" << count.isSet()
+         << endl;
+
+    // the order of unlabeled Args is checked per CmdLine
+    CmdLine other("Another command", ' ', "0.9");
+    UnlabeledValueArg<string> input("input", "File to read", false, "none",
+                                    "file", other);
+    cout << "other: " << input.getName() << endl;
+
+    // a result is reset for the next parse, also of another CmdLine
+    vector<string> otherLine;
+    otherLine.push_back("other");
+    otherLine.push_back("in.txt");
+    other.parse(otherLine, b);
+    cout << "other: " << input.getValue(b) << endl;
+
+    cmd.parse(line, b);
+    print("b reused", b, count, verbose, names, file);
+
+    // an Arg can be added to several CmdLines, each finds it by the
+    // index it gave the Arg
+    other.add(count);
+    otherLine.push_back("-c");
+    otherLine.push_back("3");
+    ParseResult c;
+    other.parse(otherLine, c);
+    cmd.parse(line, b);
+    cout << "shared: " << count.getValue(c) << " " << count.getValue(b)
+         << endl;
+
+    vector<string> into(otherLine);
+    other.parse(into);
+    cout << "shared args: " << count.getValue() << endl;
+
+    CmdLine logged("Logged command", ' ', "0.9");
+    LoggedArg level("l", "level", "Level", logged);
+    vector<string> levelLine;
+    levelLine.push_back("logged");
+    levelLine.push_back("-l");
+    levelLine.push_back("5");
+    logged.parse(levelLine, c);
+    cout << "logged: " << level.getValue(c) << endl;
+    logged.parse(levelLine);
+    cout << "logged args: " << level.getValue() << endl;
+
+    } catch (ArgException &e)  // catch any exceptions
+    { cerr << "error: " << e.error() << " for arg " << e.argId() << endl; }
+}
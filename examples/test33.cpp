@@ -0,0 +1,102 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+#include <tclap/CmdLine.h>
+#include <tclap/BatchParser.h>
+
+using namespace TCLAP;
+using namespace std;
+
+int main(int argc, char** argv)
+{
+    CmdLine cmd("Command description message", ' ', "0.9");
+
+    ValueArg<int> count("c", "count", "Number of things", true, 1, "int",
+                        cmd);
+    SwitchArg verbose("v", "verbose", "Talk a lot", cmd, false);
+    MultiArg<string> names("n", "name", "Names to print", false, "string",
+                           cmd);
+
+    // a manifest of many jobs, every tenth of them invalid
+    ostringstream manifest;
+    for (int i = 0; i < 500; i++) {
+        if (i % 10 == 3)
+            manifest << "job -c " << i << " --bogus\n";
+        else if (i % 10 == 7)
+            manifest << "job -n x" << i << "\n\n";
+        else
+            manifest << "job\t-c " << i << (i % 2 ? " -v" : "")
+                     << " -n x" << i << "\n";
+    }
+
+    BatchParser batch(cmd, argc > 1 ? atoi(argv[1]) : 0);
+    istringstream in(manifest.str());
+    batch.parse(in);
+
+    cout << "lines=" << batch.size() << " errors=" << batch.getErrorCount()
+         << endl;
+
+    // the results are in the order of the manifest
+    int wrong = 0;
+    for (size_t i = 0; i < batch.size(); i++) {
+        const ParseResult& r = batch.getResult(i);
+        if (i % 10 == 3 || i % 10 == 7) {
+            if (!r.hasError())
+                wrong++;
+        } else if (r.hasError() ||
+                   count.getValue(r) != static_cast<int>(i) ||
+                   verbose.getValue(r) != (i % 2 == 1) ||
+                   names.getValue(r).size() != 1) {
+            wrong++;
+        }
+    }
+    cout << "wrong=" << wrong << endl;
+
+    for (size_t i = 2; i < 8; i++) {
+        const ParseResult& r = batch.getResult(i);
+        if (r.hasError())
+            cout << i << ": error: " << r.getError() << " for arg "
+                 << r.getErrorArgId() << endl;
+        else
+            cout << i << ": count=" << count.getValue(r) << " verbose="
+                 << verbose.getValue(r) << " name="
+                 << names.getValue(r).front() << endl;
+    }
+
+    // --help and --version only stop their line, nothing is printed
+    BatchParser quiet(cmd, argc > 1 ? atoi(argv[1]) : 0);
+    istringstream help("job --help\njob -c 1 --version -v\njob -c 2\n");
+    quiet.parse(help);
+    for (size_t i = 0; i < quiet.size(); i++) {
+        const ParseResult& r = quiet.getResult(i);
+        cout << "quiet " << i << ": exit=" << r.exitRequested() << " status="
+             << r.getExitStatus() << " error="
+             << (r.hasError() ? r.getError() : "none") << endl;
+    }
+    cout << "exits=" << quiet.getExitCount() << " errors="
+         << quiet.getErrorCount() << endl;
+
+    // the arguments of a manifest line are quoted as for sh
+    BatchParser quoted(cmd, argc > 1 ? atoi(argv[1]) : 0);
+    istringstream jobs("job -c 1 -n 'two words' -n a\\ b -n \"\"\n"
+                       "job -c 2 -n \"open\n");
+    quoted.parse(jobs);
+    for (size_t i = 0; i < quoted.size(); i++) {
+        const ParseResult& r = quoted.getResult(i);
+        cout << "quoted " << i << ":";
+        if (r.hasError())
+            cout << " error: " << r.getError();
+        else
+            for (size_t k = 0; k < names.getValue(r).size(); k++)
+                cout << " [" << names.getValue(r)[k] << "]";
+        cout << endl;
+    }
+
+    // the Args are left as they are
+    cout << "args: count=" << count.getValue() << " set=" << count.isSet()
+         << endl;
+}
@@ -0,0 +1,107 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <tclap/CmdLine.h>
+
+using namespace TCLAP;
+using namespace std;
+
+static void write(const char* name, const string& contents)
+{
+    ofstream out(name, ios::out | ios::binary);
+    out << contents;
+}
+
+// the value with a NUL shown as "\0"
+static string show(const string& value)
+{
+    string s;
+    for (size_t i = 0; i < value.size(); i++)
+        if (value[i] == '\0')
+            s += "\\0";
+        else
+            s += value[i];
+    return s;
+}
+
+static void parse(const CmdLine& cmd, const string& label,
+                  const SwitchArg& verbose, const MultiArg<string>& names,
+                  const UnlabeledMultiArg<string>& files,
+                  int argc, const char* const* argv)
+{
+    ParseResult result;
+    if (!cmd.tryParse(argc, argv, result)) {
+        cout << label << ": error: " << result.getError() << " for arg "
+             << result.getErrorArgId() << endl;
+        return;
+    }
+
+    cout << label << ": verbose=" << verbose.getValue(result) << " names=";
+    const vector<string>& n = names.getValue(result);
+    for (size_t i = 0; i < n.size(); i++)
+        cout << (i > 0 ? "," : "") << "[" << n[i] << "]";
+
+    cout << " files=";
+    const vector<string>& f = files.getValue(result);
+    for (size_t i = 0; i < f.size(); i++)
+        cout << (i > 0 ? "," : "") << "[" << show(f[i]) << "]";
+    cout << endl;
+}
+
+int main(int argc, char** argv)
+{
+    CmdLine cmd("Command description message", ' ', "0.9");
+
+    SwitchArg verbose("v", "verbose", "Talk a lot", cmd, false);
+    MultiArg<string> names("n", "name", "Names to print", false, "string",
+                           cmd);
+    UnlabeledMultiArg<string> files("file", "Files to read", false, "file",
+                                    cmd);
+
+    write("test34-shell.rsp",
+          "-v --name 'homer simpson' # a comment @not-a-file\n"
+          "\"a \\\"quoted\\\" file\" @test34-inner.rsp\n"
+          "last\\ one \"\" x\\\ny\n");
+    write("test34-inner.rsp", "inner1\tinner2");
+    write("test34-lines.rsp", "-n\r\nmarge simpson\n\n@test34-inner.rsp\nend");
+    write("test34-self.rsp", "@test34-self.rsp");
+    write("test34-quote.rsp", "'open");
+    // a backslash before a NUL is kept inside double quotes
+    write("test34-nul.rsp", string("\"a\\\0b\"", 6));
+
+    // "@file" is an ordinary argument until response files are enabled
+    parse(cmd, "off", verbose, names, files, argc, argv);
+
+    cmd.setResponseFiles(ResponseFile::SHELL);
+    parse(cmd, "shell", verbose, names, files, argc, argv);
+
+    const char* self[] = { "test34", "@test34-self.rsp" };
+    parse(cmd, "self", verbose, names, files, 2, self);
+
+    const char* quote[] = { "test34", "@test34-quote.rsp" };
+    parse(cmd, "quote", verbose, names, files, 2, quote);
+
+    const char* nul[] = { "test34", "@test34-nul.rsp" };
+    parse(cmd, "nul", verbose, names, files, 2, nul);
+
+    const char* missing[] = { "test34", "@test34-missing.rsp" };
+    parse(cmd, "missing", verbose, names, files, 2, missing);
+
+    cmd.setResponseFiles(ResponseFile::LINES);
+    const char* lines[] = { "test34", "first", "@test34-lines.rsp", "@" };
+    parse(cmd, "lines", verbose, names, files, 4, lines);
+
+    cmd.setResponseFileLimit(40);
+    parse(cmd, "limit", verbose, names, files, 4, lines);
+
+    remove("test34-shell.rsp");
+    remove("test34-inner.rsp");
+    remove("test34-lines.rsp");
+    remove("test34-self.rsp");
+    remove("test34-quote.rsp");
+    remove("test34-nul.rsp");
+}
@@ -0,0 +1,51 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <tclap/CmdLine.h>
+
+using namespace TCLAP;
+using namespace std;
+
+template<class T>
+static void print(const string& label, const vector<T>& values)
+{
+    cout << label << ":";
+    for (size_t i = 0; i < values.size(); i++)
+        cout << " " << values[i];
+    cout << endl;
+}
+
+int main(int argc, char** argv)
+{
+    try {
+
+    CmdLine cmd("Command description message", ' ', "0.9");
+
+    vector<int> allowed;
+    allowed.push_back(3);
+    allowed.push_back(17);
+    allowed.push_back(42);
+    allowed.push_back(99);
+    ValuesConstraint<int> known(allowed);
+
+    MultiArg<int> ids("i", "ids", "Ids to process", false, &known, cmd);
+    ids.setListSeparator(',');
+
+    MultiArg<double> weights("w", "weights", "Weights", false, "float",
+                             cmd);
+    weights.setListSeparator(':');
+
+    MultiArg<string> tags("t", "tags", "Tags", false, "tag", cmd);
+    tags.setListSeparator(',');
+
+    cmd.parse(argc, argv);
+
+    print("ids", ids.getValue());
+    print("weights", weights.getValue());
+    print("tags", tags.getValue());
+
+    } catch (ArgException &e)  // catch any exceptions
+    { cerr << "error: " << e.error() << " for arg " << e.argId() << endl; }
+}
@@ -0,0 +1,47 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+#include <string>
+#include <iostream>
+#include <tclap/CmdLine.h>
+
+using namespace TCLAP;
+using namespace std;
+
+int main(int argc, char** argv)
+{
+    CmdLine cmd("Command description message", ' ', "0.9");
+    cmd.setLazyConversion(true);
+
+    ValueArg<int> count("n", "count", "Number of runs", false, 1, "int", cmd);
+    ValueArg<double> scale("s", "scale", "Scale factor", false, 1.0,
+                           "float", cmd);
+
+    vector<int> allowed;
+    allowed.push_back(1);
+    allowed.push_back(2);
+    allowed.push_back(3);
+    ValuesConstraint<int> levels(allowed);
+    MultiArg<int> level("l", "level", "Levels to run", false, &levels, cmd);
+
+    SwitchArg all("a", "all", "Check all values before reading any", cmd,
+                  false);
+
+    cmd.parse(argc, argv);
+
+    // an invalid value is reported here, as the parse would have
+    if (all.getValue())
+        cmd.validateAll();
+
+    try {
+        cout << "count: " << count.getValue() << endl;
+        cout << "scale: " << scale.getValue() << endl;
+
+        cout << "level:";
+        for (MultiArg<int>::const_iterator it = level.begin();
+             it != level.end(); ++it)
+            cout << " " << *it;
+        cout << endl;
+    } catch (ArgException& e) {
+        cout << endl << e.argId() << ": " << e.error() << endl;
+    }
+}
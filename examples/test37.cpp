@@ -0,0 +1,48 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <cstdio>
+#include <tclap/CmdLine.h>
+
+using namespace TCLAP;
+using namespace std;
+
+int main(int argc, char** argv)
+{
+    try {
+        CmdLine cmd("Command description message", ' ', "0.9");
+
+        vector<string> regions;
+        const char* areas[] = { "us", "eu", "ap", "sa" };
+        const char* sides[] = { "east", "west", "north", "south", "central" };
+        for (int a = 0; a < 4; a++)
+            for (int s = 0; s < 5; s++)
+                for (int n = 1; n <= 100; n++) {
+                    char name[32];
+                    sprintf(name, "%s-%s-%d", areas[a], sides[s], n);
+                    regions.push_back(name);
+                }
+        SortedValuesConstraint<string> knownRegions(regions, 3);
+        MultiArg<string> region("r", "region", "Regions to deploy to", true,
+                                &knownRegions, cmd);
+
+        vector<int> ports;
+        for (int p = 8000; p < 9000; p += 10)
+            ports.push_back(p);
+        SortedValuesConstraint<int> knownPorts(ports, 4);
+        ValueArg<int> port("p", "port", "Port to listen on", false, 8000,
+                           &knownPorts, cmd);
+
+        cmd.parse(argc, argv);
+
+        cout << "port: " << port.getValue() << endl;
+        cout << "regions:";
+        for (size_t i = 0; i < region.getValue().size(); i++)
+            cout << " " << region.getValue()[i];
+        cout << endl;
+    } catch (ArgException& e) {
+        cout << "ERROR: " << e.error() << " " << e.argId() << endl;
+    }
+}
@@ -0,0 +1,40 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <tclap/CmdLine.h>
+
+using namespace TCLAP;
+using namespace std;
+
+int main(int argc, char** argv)
+{
+    try {
+        CmdLine cmd("Command description message", ' ', "0.9");
+
+        RangeConstraint<int> portRange(1, 65535);
+        ValueArg<int> port("p", "port", "Port to listen on", false, 8080,
+                           &portRange, cmd);
+
+        RangeConstraint<double> unit(0.0, 1.0, false, true);
+        MultiArg<double> weight("w", "weight", "Weights of the inputs",
+                                false, &unit, cmd);
+        weight.setListSeparator(',');
+
+        StaticRangeConstraint<int, 0, 9> levels;
+        ValueArg<int> level("l", "level", "Compression level", false, 6,
+                            &levels, cmd);
+
+        cmd.parse(argc, argv);
+
+        cout << "port: " << port.getValue() << endl;
+        cout << "level: " << level.getValue() << endl;
+        cout << "weights:";
+        for (size_t i = 0; i < weight.getValue().size(); i++)
+            cout << " " << weight.getValue()[i];
+        cout << endl;
+    } catch (ArgException& e) {
+        cout << "ERROR: " << e.error() << " " << e.argId() << endl;
+    }
+}
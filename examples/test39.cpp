@@ -0,0 +1,36 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <tclap/CmdLine.h>
+
+using namespace TCLAP;
+using namespace std;
+
+int main(int argc, char** argv)
+{
+    try {
+        CmdLine cmd("Command description message", ' ', "0.9");
+
+        PatternConstraint hostname(
+            "[a-z0-9]([a-z0-9-]{0,61}[a-z0-9])?(\\.[a-z0-9]([a-z0-9-]{0,61}[a-z0-9])?)*",
+            "hostname");
+        ValueArg<string> host("H", "host", "Host to connect to", true, "",
+                              &hostname, cmd);
+
+        PatternConstraint ticket("[A-Z]{2,5}-\\d+");
+        MultiArg<string> tickets("t", "ticket", "Tickets to close", false,
+                                 &ticket, cmd);
+
+        cmd.parse(argc, argv);
+
+        cout << "host: " << host.getValue() << endl;
+        cout << "tickets:";
+        for (size_t i = 0; i < tickets.getValue().size(); i++)
+            cout << " " << tickets.getValue()[i];
+        cout << endl;
+    } catch (ArgException& e) {
+        cout << "ERROR: " << e.error() << " " << e.argId() << endl;
+    }
+}
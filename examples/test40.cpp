@@ -0,0 +1,47 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+// Built with -fno-exceptions where the compiler allows it, so nothing
+// here may throw.
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <tclap/CmdLine.h>
+
+using namespace TCLAP;
+using namespace std;
+
+int main(int argc, char** argv)
+{
+    CmdLine cmd("Command description message", ' ', "0.9");
+
+    RangeConstraint<int> percent(0, 100);
+    ValueArg<int> level("l", "level", "Compression level", false, 50,
+                        &percent, cmd);
+
+    ValueArg<string> name("n", "name", "Name to print", true, "", "string",
+                          cmd);
+
+    MultiArg<float> weights("w", "weight", "Weights to use", false, "float",
+                            cmd);
+
+    ParseResult result;
+    if (!cmd.tryParse(argc, argv, result)) {
+        if (result.exitRequested())
+            return result.getExitStatus();
+
+        cout << "error code: " << result.getErrorCode() << endl;
+        cout << "token: " << result.getErrorToken() << endl;
+        cout << "ERROR: " << result.getError() << " "
+             << result.getErrorArgId() << endl;
+        return 1;
+    }
+
+    cout << "name: " << name.getValue(result) << endl;
+    cout << "level: " << level.getValue(result) << endl;
+    cout << "weights:";
+    for (size_t i = 0; i < weights.getValue(result).size(); i++)
+        cout << " " << weights.getValue(result)[i];
+    cout << endl;
+    return 0;
+}
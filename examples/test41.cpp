@@ -0,0 +1,37 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <tclap/CmdLine.h>
+
+using namespace TCLAP;
+using namespace std;
+
+// Parses the command given as the only argument, as if it were a line of
+// a job file.
+int main(int argc, char** argv)
+{
+    CmdLine cmd("Command description message", ' ', "0.9");
+
+    ValueArg<string> name("n", "name", "Name to print", true, "", "string",
+                          cmd);
+    SwitchArg force("f", "force", "Whether to overwrite", cmd, false);
+    UnlabeledMultiArg<string> files("file", "Files to copy", false, "file",
+                                    cmd);
+
+    ParseResult result;
+    if (!cmd.tryParseCommand(argc > 1 ? argv[1] : "", result)) {
+        cout << "token: " << result.getErrorToken() << endl;
+        cout << "ERROR: " << result.getError() << " "
+             << result.getErrorArgId() << endl;
+        return 1;
+    }
+
+    cout << "program: " << result.getProgramName() << endl;
+    cout << "name: [" << name.getValue(result) << "]" << endl;
+    cout << "force: " << (force.getValue(result) ? "true" : "false") << endl;
+    for (size_t i = 0; i < files.getValue(result).size(); i++)
+        cout << "file: [" << files.getValue(result)[i] << "]" << endl;
+    return 0;
+}
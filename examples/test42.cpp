@@ -0,0 +1,62 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <tclap/CmdLine.h>
+#include <tclap/IncrementalParser.h>
+
+using namespace TCLAP;
+using namespace std;
+
+static void printArgs(const char* what, const vector<const Arg*>& args)
+{
+    cout << "  " << what << ":";
+    for (size_t i = 0; i < args.size(); i++)
+        cout << " " << args[i]->getName();
+    cout << endl;
+}
+
+// Adds the arguments one at a time, as if they were typed, and shows what
+// the parser knows after each.
+int main(int argc, char** argv)
+{
+    CmdLine cmd("Command description message", ' ', "0.9", false);
+
+    ValueArg<int> count("c", "count", "Number of copies", true, 1, "int",
+                        cmd);
+    MultiSwitchArg verbose("v", "verbose", "More output", cmd);
+    SwitchArg fast("f", "fast", "Copy quickly");
+    SwitchArg safe("s", "safe", "Copy safely");
+    cmd.xorAdd(fast, safe);
+    UnlabeledValueArg<string> source("source", "File to copy", true, "",
+                                     "file", cmd);
+    UnlabeledValueArg<string> target("target", "Where to copy it", false,
+                                     "", "file", cmd);
+
+    IncrementalParser parser(cmd, "copy");
+    vector<const Arg*> args;
+    for (int i = 1; i < argc; i++) {
+        bool ok = parser.add(argv[i]);
+        cout << argv[i] << (ok ? "" : " (invalid)")
+             << (parser.isComplete() ? " (complete)" : "") << endl;
+
+        parser.getMissing(args);
+        printArgs("missing", args);
+        parser.getAllowed(args);
+        printArgs("allowed", args);
+    }
+
+    if (!parser.finish()) {
+        cout << "ERROR: " << parser.getResult().getError() << " "
+             << parser.getResult().getErrorArgId() << endl;
+        return 1;
+    }
+
+    const ParseResult& result = parser.getResult();
+    cout << "count: " << count.getValue(result) << endl;
+    cout << "verbose: " << verbose.getValue(result) << endl;
+    cout << "source: " << source.getValue(result) << endl;
+    cout << "target: " << target.getValue(result) << endl;
+    return 0;
+}
@@ -0,0 +1,49 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+#include "tclap/CmdLine.h"
+#include "tclap/BashCompletionOutput.h"
+#include "tclap/FishCompletionOutput.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace TCLAP;
+using namespace std;
+
+int main(int argc, char** argv)
+{
+	CmdLine cmd("this is a message", ' ', "0.99" );
+	BashCompletionOutput bashoutput;
+	FishCompletionOutput fishoutput;
+	CmdLineOutput *output = &bashoutput;
+
+	if (argc > 2)
+		output = &fishoutput;
+
+	cmd.setOutput(output);
+
+	vector<string> allowed;
+	allowed.push_back("fast");
+	allowed.push_back("slow");
+	allowed.push_back("it's");
+	ValuesConstraint<string> allowedVals( allowed );
+
+	SwitchArg btest("B","sB", "exist Test B", false);
+	MultiArg<int> atest("A","sA", "exist Test A", false, "integer");
+	ValueArg<string> stest("s", "Bs", "string test", true, "homer",
+						   "string");
+	ValueArg<string> mtest("m", "mode", "the mode.", false, "fast",
+						   &allowedVals);
+	ValueArg<string> dtest("", "dir", "the directory", false, ".",
+						   "directory");
+	UnlabeledValueArg<string> ftest("input", "the input file", true, "",
+									"file");
+
+	cmd.xorAdd(stest, btest);
+	cmd.add( atest );
+	cmd.add( mtest );
+	cmd.add( dtest );
+	cmd.add( ftest );
+
+	cmd.parse(argc,argv);
+}
@@ -0,0 +1,83 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+#include "tclap/CmdLine.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace TCLAP;
+using namespace std;
+
+// the values change, e.g. the jobs that are running
+class JobProvider : public CompletionProvider
+{
+	public:
+		virtual void getValues( vector<string>& values )
+		{
+			values.push_back("job-17");
+			values.push_back("job-3");
+			values.push_back("build-9");
+		}
+};
+
+// the values are slow to find, so they are cached for a minute
+class HostProvider : public CompletionProvider
+{
+	public:
+		HostProvider() : CompletionProvider( 60 ) { }
+
+		virtual void getValues( vector<string>& values )
+		{
+			values.push_back("db:5432");
+			values.push_back("web:80");
+		}
+};
+
+int main(int argc, char** argv)
+{
+	CmdLine cmd("Command description message", ' ', "0.9");
+	cmd.setCompletion( true );
+
+	vector<string> modes;
+	modes.push_back("fast");
+	modes.push_back("slow");
+	modes.push_back("safe");
+	ValuesConstraint<string> allowedModes( modes );
+
+	vector<string> actions;
+	actions.push_back("start");
+	actions.push_back("stop");
+	actions.push_back("status");
+	ValuesConstraint<string> allowedActions( actions );
+
+	JobProvider jobs;
+	HostProvider hosts;
+
+	ValueArg<string> modeArg("m", "mode", "the mode", false, "fast",
+	                         &allowedModes);
+	ValueArg<string> jobArg("j", "job", "the job", false, "", "job");
+	jobArg.setCompletionProvider( &jobs );
+	// the name isn't a safe file name for the cache as it is
+	ValueArg<string> hostArg("o", "host/port", "the server", false, "",
+	                         "host");
+	hostArg.setCompletionProvider( &hosts );
+	SwitchArg quietArg("q", "quiet", "say less", false);
+	SwitchArg verboseArg("v", "verbose", "say more", false);
+	MultiArg<int> levelArg("l", "level", "a level", false, "int");
+	UnlabeledValueArg<string> actionArg("action", "what to do", true, "",
+	                                    &allowedActions);
+	UnlabeledMultiArg<string> filesArg("files", "the files", false, "file");
+
+	cmd.add( modeArg );
+	cmd.add( jobArg );
+	cmd.add( hostArg );
+	cmd.xorAdd( quietArg, verboseArg );
+	cmd.add( levelArg );
+	cmd.add( actionArg );
+	cmd.add( filesArg );
+
+	cmd.parse( argc, argv );
+
+	cout << actionArg.getValue() << " " << jobArg.getValue() << " in "
+	     << modeArg.getValue() << " mode" << endl;
+}
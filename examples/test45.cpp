@@ -0,0 +1,50 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+#include "tclap/CmdLine.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+// the usage rendered at build time, see add_example_docs()
+#ifdef TCLAP_USAGE_HEADER
+#include TCLAP_USAGE_HEADER
+#endif
+
+using namespace TCLAP;
+using namespace std;
+
+int main(int argc, char** argv)
+{
+	CmdLine cmd("Copies the input to the output, -b can't be mixed with -x.",
+	            ' ', "0.99");
+	StdOutput output;
+#ifdef TCLAP_USAGE_HEADER
+	output.setUsage( tclapUsageProgName, tclapUsage );
+#endif
+	cmd.setOutput( &output );
+
+	vector<string> allowed;
+	allowed.push_back("fast");
+	allowed.push_back("safe");
+	ValuesConstraint<string> allowedVals( allowed );
+
+	ValueArg<string> mtest("m", "mode", "the mode", false, "fast",
+	                       &allowedVals);
+	SwitchArg btest("b", "binary", "copy bytes", false);
+	ValueArg<string> xtest("x", "text", "copy text in the \"encoding\"",
+	                       false, "utf-8", "encoding");
+	MultiArg<int> ltest("l", "level", "a level, e.g. -1 or 3", false,
+	                    "integer");
+	UnlabeledValueArg<string> ftest("input", "the input file", true, "",
+	                                "file");
+
+	cmd.add( mtest );
+	cmd.xorAdd( btest, xtest );
+	cmd.add( ltest );
+	cmd.add( ftest );
+
+	cmd.parse( argc, argv );
+
+	cout << "copying " << ftest.getValue() << " in mode " <<
+		mtest.getValue() << endl;
+}
@@ -33,20 +33,27 @@
 #include <string>
 #include <vector>
 #include <list>
+#include <map>
 #include <iostream>
 #include <iomanip>
 #include <cstdio>
+#include <cstring>
 
 #include <tclap/sstream.h>
 
 #include <tclap/ArgException.h>
+#include <tclap/ArgToken.h>
+#include <tclap/ParseResult.h>
 #include <tclap/Visitor.h>
 #include <tclap/CmdLineInterface.h>
 #include <tclap/ArgTraits.h>
 #include <tclap/StandardTraits.h>
+#include <tclap/NumberParser.h>
 
 namespace TCLAP {
 
+class CompletionProvider;
+
 /**
  * A virtual base class that defines the essential data for all arguments.
  * This class, or one of its existing children, must be subclassed to do
@@ -67,12 +74,14 @@ class Arg
 
 		/**
 		 * Indicates whether the rest of the arguments should be ignored.
+		 * Only set by IgnoreRestVisitor, CmdLine keeps track of "--" in
+		 * the ParseResult.
 		 */
 		static bool& ignoreRestRef() { static bool ign = false; return ign; }
 
 		/**
-		 * The delimiter that separates an argument flag/name from the
-		 * value.
+		 * The delimiter that new Args start out with.  Never changed by
+		 * CmdLine, which sets the delimiter of each Arg added to it.
 		 */
 		static char& delimiterRef() { static char delim = ' '; return delim; }
 
@@ -148,11 +157,52 @@ class Arg
 
 		bool _acceptsMultipleValues;
 
+		/**
+		 * The character that separates the flag/name of this argument
+		 * from the value.  Set by the CmdLine the Arg is added to.
+		 */
+		char _delimiter;
+
+		/**
+		 * Gives the values for completing the value of the argument, or
+		 * NULL.  Not owned by the Arg.
+		 */
+		CompletionProvider* _completionProvider;
+
+		/**
+		 * The result the default processToken() parses into while it
+		 * passes an argument on to processArg(), so that the default
+		 * processArg() records what it finds there.  NULL otherwise.
+		 */
+		mutable ParseResult* _processResult;
+
 		/**
 		 * Performs the special handling described by the Visitor.
 		 */
 		void _checkWithVisitor() const;
 
+		/**
+		 * Performs the special handling described by the Visitor during
+		 * a parse, unless the parse has stopped, e.g. for an error found
+		 * in the argument, or doesn't run Visitors.
+		 * \param result - The outcome of the parse so far.
+		 */
+		void _checkWithVisitor( ParseResult& result ) const;
+
+		/**
+		 * The index that identifies this Arg in a result, given by the
+		 * CmdLine that parses into it, see ParseResult::getStateIndex().
+		 * \param result - The outcome of the parse.
+		 */
+		std::size_t _stateIndex( const ParseResult& result ) const;
+
+		/**
+		 * Indicates whether another Arg of the xor list of this Arg has
+		 * been matched.
+		 * \param result - The parse to look at.
+		 */
+		bool _isXorSet( const ParseResult& result ) const;
+
 		/**
 		 * Primary constructor. YOU (yes you) should NEVER construct an Arg
 		 * directly, this is a base class that is extended by various children
@@ -187,17 +237,20 @@ class Arg
 
 		/**
 		 * Begin ignoring arguments since the "--" argument was specified.
+		 * Not used by the Args in this library, see
+		 * ParseResult::beginIgnoring().
 		 */
 		static void beginIgnoring() { ignoreRestRef() = true; }
 
 		/**
-		 * Whether to ignore the rest.
+		 * Whether to ignore the rest.  Not used by the Args in this
+		 * library, see ParseResult::ignoreRest().
 		 */
 		static bool ignoreRest() { return ignoreRestRef(); }
 
 		/**
-		 * The delimiter that separates an argument flag/name from the
-		 * value.
+		 * The delimiter that new Args start out with, see
+		 * getValueDelimiter().
 		 */
 		static char delimiter() { return delimiterRef(); }
 
@@ -241,20 +294,134 @@ class Arg
 		static const std::string ignoreNameString() { return "ignore_rest"; }
 
 		/**
-		 * Sets the delimiter for all arguments.
+		 * Sets the delimiter that new Args start out with.
 		 * \param c - The character that delimits flags/names from values.
 		 */
 		static void setDelimiter( char c ) { delimiterRef() = c; }
 
+		/**
+		 * Determines the kind of the token and where its flag/name and
+		 * value are.  Called by CmdLine once for every argument before
+		 * any Arg sees it.
+		 * \param token - The token to classify.
+		 * \param delim - The character that separates a flag/name from
+		 * the value.
+		 */
+		static void classifyToken( ArgToken& token, char delim );
+
 		/**
 		 * Pure virtual method meant to handle the parsing and value assignment
-		 * of the string on the command line.
+		 * of the string on the command line.  The Args in this library
+		 * implement processToken() and only forward to the default
+		 * implementation of this method, which classifies the argument,
+		 * calls processToken() and stores the result in the Arg, or
+		 * records it in the result of the parse if it is called through
+		 * the default processToken(), see parsesTokens().
 		 * \param i - Pointer the the current argument in the list.
 		 * \param args - Mutable list of strings. What is
 		 * passed in from main.
 		 */
 		virtual bool processArg(int *i, std::vector<std::string>& args) = 0;
 
+		/**
+		 * Handles the parsing of a classified argument, recording what
+		 * is found in the result rather than in the Arg.  This is what
+		 * CmdLine calls.  An invalid argument that matches is recorded
+		 * as the error of the result, see ParseResult::setError(), and
+		 * true is returned.  The default implementation is for Args that
+		 * only implement processArg(): it passes the strings on to
+		 * processArg() and marks the Arg as set in the result.  A
+		 * CmdLine with such an Arg can't parse in several threads at
+		 * once.
+		 * \param i - Pointer the the current token in the list.
+		 * \param tokens - The classified arguments.
+		 * \param result - The outcome of the parse so far.
+		 */
+		virtual bool processToken( int *i, ArgTokenList& tokens,
+		                           ParseResult& result ) const;
+
+		/**
+		 * Whether CmdLine passes the arguments to processToken() of this
+		 * Arg, true by default.  Otherwise they are passed to
+		 * processArg() through the default implementation of
+		 * processToken(), which the default implementation of
+		 * processArg() parses on with.  A class derived from an Arg of
+		 * this library that overrides processArg() must re-implement
+		 * this to return false, or its processArg() isn't called.  Such
+		 * an Arg keeps the result of the parse in the Arg while it is
+		 * matched, so a CmdLine with it can't parse in several threads
+		 * at once, e.g. with a BatchParser.
+		 */
+		virtual bool parsesTokens() const;
+
+		/**
+		 * Handles the flag of this Arg appearing among combined
+		 * switches, e.g. the "b" in "-abc".  The default implementation
+		 * returns false, since only switches can be combined.
+		 * \param count - The number of times the flag appears.
+		 * \param result - The outcome of the parse so far.
+		 */
+		virtual bool processCombinedFlag( std::size_t count,
+		                                  ParseResult& result ) const;
+
+		/**
+		 * Records in the result the error that processCombinedFlag()
+		 * would report for the same flags, without handling them or
+		 * checking the Visitor.  CmdLine checks all flags of a token
+		 * this way before it handles any of them.  The default
+		 * implementation finds no error.
+		 * \param count - The number of times the flag appears.
+		 * \param result - The outcome of the parse so far.
+		 */
+		virtual void checkCombinedFlag( std::size_t count,
+		                                ParseResult& result ) const;
+
+		/**
+		 * Takes over what a parse found for this Arg, so that getValue()
+		 * returns it.  Called for the Args that were matched by
+		 * CmdLine::parse() without a ParseResult.  Args that record a
+		 * state in the result must re-implement it.
+		 * \param result - The outcome of the parse.
+		 */
+		virtual void storeResult( ParseResult& result );
+
+		/**
+		 * Converts and checks the values stored in this Arg that haven't
+		 * been yet, see CmdLine::setLazyConversion(), throwing the
+		 * ArgException the parse would have thrown for an invalid one.
+		 * Does nothing by default, for Args that convert what they find
+		 * as they parse.
+		 */
+		virtual void validate();
+
+		/**
+		 * Converts and checks the values recorded for this Arg in a
+		 * result that haven't been yet.  See above.
+		 * \param result - The outcome of the parse.
+		 */
+		virtual void validate( const ParseResult& result ) const;
+
+		/**
+		 * Converts and checks the values recorded for this Arg in a
+		 * result that haven't been yet, recording an invalid one as the
+		 * error of the result rather than throwing.  Returns whether
+		 * they were valid.  By default calls validate(), for Args that
+		 * convert what they find as they parse.
+		 * \param result - The outcome of the parse.
+		 */
+		virtual bool tryValidate( ParseResult& result ) const;
+
+		/**
+		 * Describes the constraint a value given for this Arg doesn't
+		 * meet, see Constraint::failureDescription().  Called to put
+		 * together the message of a ParseResult::CONSTRAINT_FAILED
+		 * error.  Returns an empty string by default, for Args without
+		 * a constraint.
+		 * \param value - The value as it was given.
+		 */
+		virtual std::string constraintFailure( const std::string& value )
+			const;
+
 		/**
 		 * Operator ==.
 		 * Equality operator. Must be virtual to handle unlabeled args.
@@ -294,6 +461,30 @@ class Arg
 		 */
 		void xorSet();
 
+		/**
+		 * Sets the character that separates the flag/name from the
+		 * value.  This is used by the CmdLine.
+		 * \param c - The delimiter of the CmdLine.
+		 */
+		void setValueDelimiter( char c );
+
+		/**
+		 * Returns the character that separates the flag/name from the
+		 * value.
+		 */
+		char getValueDelimiter() const;
+
+		/**
+		 * Sets what gives the values of this Arg when the command line
+		 * is completed, see Completion.  The provider isn't deleted with
+		 * the Arg.
+		 * \param provider - The provider, or NULL for the values in the
+		 * description of the value, e.g. those of a ValuesConstraint.
+		 */
+		void setCompletionProvider( CompletionProvider* provider );
+
+		CompletionProvider* getCompletionProvider() const;
+
 		/**
 		 * Indicates whether a value must be specified for argument.
 		 */
@@ -305,6 +496,12 @@ class Arg
 		 */
 		bool isSet() const;
 
+		/**
+		 * Indicates whether the argument was matched in a parse.
+		 * \param result - The outcome of the parse.
+		 */
+		bool isSet( const ParseResult& result ) const;
+
 		/**
 		 * Indicates whether the argument can be ignored, if desired.
 		 */
@@ -320,6 +517,14 @@ class Arg
 		 */
 		virtual bool argMatches( const std::string& s ) const;
 
+		/**
+		 * Tests whether a classified token matches the flag/name of this
+		 * argument. The token equivalent of argMatches(), called by the
+		 * processToken() methods.
+		 * \param token - The token to be compared to the flag/name.
+		 */
+		virtual bool tokenMatches( const ArgToken& token ) const;
+
 		/**
 		 * Returns a simple string representation of the argument.
 		 * Primarily for debugging.
@@ -374,6 +579,12 @@ class Arg
 		 */
 		virtual bool acceptsMultipleValues();
 
+		/**
+		 * Whether the Arg can be given more than once on a command
+		 * line, e.g. a MultiArg or a MultiSwitchArg.
+		 */
+		virtual bool isRepeatable() const;
+
 		/**
 		 * Clears the Arg object and allows it to be reused by new
 		 * command lines.
@@ -399,11 +610,12 @@ typedef std::list<Visitor*>::const_iterator VisitorListIterator;
 /*
  * Extract a value of type T from it's string representation contained
  * in strVal. The ValueLike parameter used to select the correct
- * specialization of ExtractValue depending on the value traits of T.
+ * specialization of TryExtractValue depending on the value traits of T.
  * ValueLike traits use operator>> to assign the value from strVal.
+ * Returns why the value can't be read, if it can't.
  */
-template<typename T> void
-ExtractValue(T &destVal, const std::string& strVal, ValueLike vl)
+template<typename T> ParseResult::ErrorCode
+TryExtractValue(T &destVal, const std::string& strVal, ValueLike vl)
 {
     static_cast<void>(vl); // Avoid warning about unused vl
     istringstream is(strVal.c_str());
@@ -423,27 +635,82 @@ ExtractValue(T &destVal, const std::string& strVal, ValueLike vl)
     }
 
     if ( is.fail() )
-	throw( ArgParseException("Couldn't read argument value "
-				 "from string '" + strVal + "'"));
+	return ParseResult::INVALID_VALUE;
+
+    if ( valuesRead > 1 )
+	return ParseResult::EXTRA_VALUE;
+
+    return ParseResult::NO_PARSE_ERROR;
+}
+
+/*
+ * Extract a value of type T from it's string representation contained
+ * in strVal. The ValueLike parameter used to select the correct
+ * specialization of TryExtractValue depending on the value traits of T.
+ * NumberLike traits read the value without a stream, accepting the
+ * strings that operator>> would with the same errors.
+ */
+template<typename T> ParseResult::ErrorCode
+TryExtractValue(T &destVal, const std::string& strVal, NumberLike nl)
+{
+    static_cast<void>(nl); // Avoid warning about unused nl
+
+    // like the stream, stop at the first NUL
+    const char* p = strVal.c_str();
+    const char* end = p + std::strlen(p);
 
+    int valuesRead = 0;
+    while ( p != end ) {
+	if ( !ReadNumber(p, destVal) )
+	    return ParseResult::INVALID_VALUE;
+
+	valuesRead++;
+    }
 
     if ( valuesRead > 1 )
-	throw( ArgParseException("More than one valid value parsed from "
-				 "string '" + strVal + "'"));
+	return ParseResult::EXTRA_VALUE;
 
+    return ParseResult::NO_PARSE_ERROR;
 }
 
 /*
  * Extract a value of type T from it's string representation contained
  * in strVal. The ValueLike parameter used to select the correct
- * specialization of ExtractValue depending on the value traits of T.
+ * specialization of TryExtractValue depending on the value traits of T.
  * StringLike uses assignment (operator=) to assign from strVal.
  */
-template<typename T> void
-ExtractValue(T &destVal, const std::string& strVal, StringLike sl)
+template<typename T> ParseResult::ErrorCode
+TryExtractValue(T &destVal, const std::string& strVal, StringLike sl)
 {
     static_cast<void>(sl); // Avoid warning about unused sl
     SetString(destVal, strVal);
+    return ParseResult::NO_PARSE_ERROR;
+}
+
+/*
+ * The text of the ArgParseException for a value TryExtractValue
+ * couldn't read.
+ */
+inline std::string ExtractErrorText(ParseResult::ErrorCode code,
+                                    const std::string& strVal)
+{
+    if ( code == ParseResult::EXTRA_VALUE )
+	return "More than one valid value parsed from string '" + strVal + "'";
+    else
+	return "Couldn't read argument value from string '" + strVal + "'";
+}
+
+/*
+ * Extract a value of type T from it's string representation contained
+ * in strVal, throwing an ArgParseException if it can't be read.  The
+ * Category parameter selects the specialization of TryExtractValue.
+ */
+template<typename T, typename Category> void
+ExtractValue(T &destVal, const std::string& strVal, Category c)
+{
+    const ParseResult::ErrorCode code = TryExtractValue(destVal, strVal, c);
+    if ( code != ParseResult::NO_PARSE_ERROR )
+	TCLAP_THROW( ArgParseException(ExtractErrorText(code, strVal)) );
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -466,17 +733,20 @@ inline Arg::Arg(const std::string& flag,
   _visitor( v ),
   _ignoreable(true),
   _xorSet(false),
-  _acceptsMultipleValues(false)
+  _acceptsMultipleValues(false),
+  _delimiter( delimiterRef() ),
+  _completionProvider(NULL),
+  _processResult(NULL)
 {
 	if ( _flag.length() > 1 )
-		throw(SpecificationException(
+		TCLAP_THROW( SpecificationException(
 				"Argument flag can only be one character long", toString() ) );
 
 	if ( _name != ignoreNameString() &&
 		 ( _flag == Arg::flagStartString() ||
 		   _flag == Arg::nameStartString() ||
 		   _flag == " " ) )
-		throw(SpecificationException("Argument flag cannot be either '" +
+		TCLAP_THROW( SpecificationException("Argument flag cannot be either '" +
 							Arg::flagStartString() + "' or '" +
 							Arg::nameStartString() + "' or a space.",
 							toString() ) );
@@ -484,7 +754,7 @@ inline Arg::Arg(const std::string& flag,
 	if ( ( _name.substr( 0, Arg::flagStartString().length() ) == Arg::flagStartString() ) ||
 		 ( _name.substr( 0, Arg::nameStartString().length() ) == Arg::nameStartString() ) ||
 		 ( _name.find( " ", 0 ) != std::string::npos ) )
-		throw(SpecificationException("Argument name begin with either '" +
+		TCLAP_THROW( SpecificationException("Argument name begin with either '" +
 							Arg::flagStartString() + "' or '" +
 							Arg::nameStartString() + "' or space.",
 							toString() ) );
@@ -503,7 +773,7 @@ inline std::string Arg::shortID( const std::string& valueId ) const
 		id = Arg::nameStartString() + _name;
 
 	if ( _valueRequired )
-		id += std::string( 1, Arg::delimiter() ) + "<" + valueId  + ">";
+		id += std::string( 1, _delimiter ) + "<" + valueId  + ">";
 
 	if ( !_required )
 		id = "[" + id + "]";
@@ -520,7 +790,7 @@ inline std::string Arg::longID( const std::string& valueId ) const
 		id += Arg::flagStartString() + _flag;
 
 		if ( _valueRequired )
-			id += std::string( 1, Arg::delimiter() ) + "<" + valueId + ">";
+			id += std::string( 1, _delimiter ) + "<" + valueId + ">";
 
 		id += ",  ";
 	}
@@ -528,7 +798,7 @@ inline std::string Arg::longID( const std::string& valueId ) const
 	id += Arg::nameStartString() + _name;
 
 	if ( _valueRequired )
-		id += std::string( 1, Arg::delimiter() ) + "<" + valueId + ">";
+		id += std::string( 1, _delimiter ) + "<" + valueId + ">";
 
 	return id;
 
@@ -571,6 +841,23 @@ inline bool Arg::isSet() const
 		return false;
 }
 
+inline bool Arg::isSet( const ParseResult& result ) const
+{
+	return result.isSet( _stateIndex( result ) ) ||
+	       ( result.continuesArgs() && isSet() );
+}
+
+inline bool Arg::_isXorSet( const ParseResult& result ) const
+{
+	const int group = result.getXorGroup( this );
+	if ( group < 0 )
+		return false;
+
+	const Arg* set = result.getXorSet( group );
+	return ( set != NULL && set != this ) ||
+	       ( result.continuesArgs() && _alreadySet && _xorSet );
+}
+
 inline bool Arg::isIgnoreable() const { return _ignoreable; }
 
 inline void Arg::setRequireLabel( const std::string& s)
@@ -587,6 +874,20 @@ inline bool Arg::argMatches( const std::string& argFlag ) const
 		return false;
 }
 
+inline bool Arg::tokenMatches( const ArgToken& token ) const
+{
+	switch ( token.kind() )
+	{
+		case ArgToken::FLAG:
+		case ArgToken::IGNORE_REST:
+			return _flag != "" && token.labelIs( _flag );
+		case ArgToken::NAME:
+			return token.labelIs( _name );
+		default:
+			return false;
+	}
+}
+
 inline std::string Arg::toString() const
 {
 	std::string s = "";
@@ -605,6 +906,17 @@ inline void Arg::_checkWithVisitor() const
 		_visitor->visit();
 }
 
+inline void Arg::_checkWithVisitor( ParseResult& result ) const
+{
+	if ( _visitor == NULL || result.hasStopped() )
+		return;
+
+	if ( result.runsVisitors() )
+		_visitor->visitParse( result );
+	else if ( result.exitsQuietly() )
+		_visitor->skipParse( result );
+}
+
 /**
  * Implementation of trimFlag.
  */
@@ -612,7 +924,7 @@ inline void Arg::trimFlag(std::string& flag, std::string& value) const
 {
 	int stop = 0;
 	for ( int i = 0; static_cast<unsigned int>(i) < flag.length(); i++ )
-		if ( flag[i] == Arg::delimiter() )
+		if ( flag[i] == _delimiter )
 		{
 			stop = i;
 			break;
@@ -626,6 +938,173 @@ inline void Arg::trimFlag(std::string& flag, std::string& value) const
 
 }
 
+/**
+ * Implementation of classifyToken.
+ */
+inline void Arg::classifyToken( ArgToken& token, char delim )
+{
+	const std::size_t flagStartLen = std::strlen( TCLAP_FLAGSTARTSTRING );
+	const std::size_t nameStartLen = std::strlen( TCLAP_NAMESTARTSTRING );
+
+	const char* s = token.c_str();
+	const std::size_t len = token.length();
+
+	const bool flagStart = len > flagStartLen &&
+		std::strncmp( s, TCLAP_FLAGSTARTSTRING, flagStartLen ) == 0;
+
+	// the flag start string twice, i.e. the ignore_rest flag
+	if ( flagStart && len == 2 * flagStartLen &&
+		 std::strncmp( s + flagStartLen, TCLAP_FLAGSTARTSTRING,
+		               flagStartLen ) == 0 )
+	{
+		token.setLabel( ArgToken::IGNORE_REST, flagStartLen, len );
+		return;
+	}
+
+	// memchr is the one scan over the argument, as with trimFlag the
+	// delimiter only separates a value if it follows the start string
+	const char* d = static_cast<const char*>( std::memchr( s, delim, len ) );
+	const std::size_t stop = d != NULL ? d - s : len;
+	const bool hasValue = d != NULL && stop > 1;
+	const std::size_t labelEnd = hasValue ? stop : len;
+
+	if ( len > nameStartLen &&
+		 std::strncmp( s, TCLAP_NAMESTARTSTRING, nameStartLen ) == 0 )
+		token.setLabel( ArgToken::NAME, nameStartLen, labelEnd );
+	else if ( flagStart )
+	{
+		// several chars without a delimiter can only be combined switches
+		if ( labelEnd - flagStartLen > 1 && d == NULL )
+			token.setLabel( ArgToken::COMBINED, flagStartLen, labelEnd );
+		else
+			token.setLabel( ArgToken::FLAG, flagStartLen, labelEnd );
+	}
+	else
+		return;
+
+	if ( hasValue )
+		token.setValue( stop + 1 );
+}
+
+/**
+ * Default implementation of processArg, for the Args that implement
+ * processToken.
+ */
+inline bool Arg::processArg(int *i, std::vector<std::string>& args)
+{
+	ArgTokenList tokens( args );
+	classifyToken( tokens[*i], _delimiter );
+
+	// called by the default processToken() for a derived class that
+	// overrides processArg(), the parse goes on in its result
+	ParseResult* parsing = _processResult;
+	if ( parsing != NULL )
+	{
+		_processResult = NULL;
+		return processToken( i, tokens, *parsing );
+	}
+
+	// the Arg can't be set twice without reset(), as if the parse went on
+	ParseResult result;
+	result.setContinuesArgs( true );
+
+	// the result only knows this Arg
+	std::map<const Arg*, std::size_t> indices;
+	indices[this] = 0;
+	result.setStateIndices( &indices );
+
+	if ( !processToken( i, tokens, result ) )
+		return false;
+
+	// processArg() reports what the parse records by throwing
+	if ( result.hasStopped() )
+		result.throwError();
+
+	storeResult( result );
+	return true;
+}
+
+/**
+ * Default implementation of processToken, for Args that only implement
+ * processArg.
+ */
+inline bool Arg::processToken(int *i, ArgTokenList& tokens,
+                              ParseResult& result) const
+{
+	if ( _ignoreable && result.ignoreRest() )
+		return false;
+
+	// such an Arg stores what it finds itself, unless it passes the
+	// argument on to the default processArg()
+	_processResult = &result;
+	bool matched = false;
+#if TCLAP_HAS_EXCEPTIONS
+	try {
+		matched = const_cast<Arg*>(this)->processArg( i, tokens.strings() );
+	} catch ( ... ) {
+		_processResult = NULL;
+		throw;
+	}
+#else
+	matched = const_cast<Arg*>(this)->processArg( i, tokens.strings() );
+#endif
+	_processResult = NULL;
+
+	if ( !matched )
+		return false;
+
+	const std::size_t index = _stateIndex( result );
+	if ( !result.isSet( index ) )
+		result.setState( index );
+	return true;
+}
+
+inline bool Arg::parsesTokens() const
+{
+	return true;
+}
+
+inline bool Arg::processCombinedFlag(std::size_t count,
+                                     ParseResult& result) const
+{
+	static_cast<void>(count); // Ignore input, don't warn
+	static_cast<void>(result); // Ignore input, don't warn
+	return false;
+}
+
+inline void Arg::checkCombinedFlag(std::size_t count,
+                                   ParseResult& result) const
+{
+	static_cast<void>(count); // Ignore input, don't warn
+	static_cast<void>(result); // Ignore input, don't warn
+}
+
+inline void Arg::storeResult( ParseResult& result )
+{
+	static_cast<void>(result); // Ignore input, don't warn
+	_alreadySet = true;
+}
+
+inline void Arg::validate()
+{ }
+
+inline void Arg::validate( const ParseResult& result ) const
+{
+	static_cast<void>(result); // Ignore input, don't warn
+}
+
+inline bool Arg::tryValidate( ParseResult& result ) const
+{
+	validate( result );
+	return true;
+}
+
+inline std::string Arg::constraintFailure( const std::string& value ) const
+{
+	static_cast<void>(value); // Ignore input, don't warn
+	return "";
+}
+
 /**
  * Implementation of _hasBlanks.
  */
@@ -649,6 +1128,31 @@ inline void Arg::xorSet()
 	_xorSet = true;
 }
 
+inline void Arg::setValueDelimiter( char c )
+{
+	_delimiter = c;
+}
+
+inline char Arg::getValueDelimiter() const
+{
+	return _delimiter;
+}
+
+inline std::size_t Arg::_stateIndex( const ParseResult& result ) const
+{
+	return result.getStateIndex( this );
+}
+
+inline void Arg::setCompletionProvider( CompletionProvider* provider )
+{
+	_completionProvider = provider;
+}
+
+inline CompletionProvider* Arg::getCompletionProvider() const
+{
+	return _completionProvider;
+}
+
 /**
  * Overridden by Args that need to added to the end of the list.
  */
@@ -667,6 +1171,11 @@ inline bool Arg::acceptsMultipleValues()
 	return _acceptsMultipleValues;
 }
 
+inline bool Arg::isRepeatable() const
+{
+	return _acceptsMultipleValues;
+}
+
 inline void Arg::reset()
 {
 	_xorSet = false;
@@ -677,6 +1186,115 @@ inline void Arg::reset()
 //END Arg.cpp
 //////////////////////////////////////////////////////////////////////
 
+// the parts of ParseResult that need the Arg
+
+inline bool ParseResult::_errorId( std::string& id ) const
+{
+	if ( _errorCode == UNMATCHED_ARGUMENT || _errorCode == RESPONSE_FILE_ERROR )
+		id = _errorValue;
+	else if ( _errorArg != NULL )
+		id = _errorArg->toString();
+	else
+		return false;
+
+	return true;
+}
+
+inline void ParseResult::_formatError() const
+{
+	_formatted = true;
+	if ( _errorCode == NO_PARSE_ERROR )
+		return;
+
+	std::string id;
+	if ( _errorId( id ) )
+		_errorArgId = "Argument: " + id;
+	else
+		_errorArgId = " ";
+
+	if ( _hasErrorText )
+	{
+		_error = _errorText;
+		return;
+	}
+
+	switch ( _errorCode )
+	{
+		case NO_PROGRAM_NAME:
+			_error = "The args vector must not be empty, the first entry "
+			         "should contain the program's name.";
+			break;
+		case UNMATCHED_ARGUMENT:
+			_error = "Couldn't find match for argument";
+			break;
+		case MISSING_REQUIRED:
+			_error = _missing.size() > 1 ? "Required arguments missing: "
+			                             : "Required argument missing: ";
+			for ( std::size_t k = 0; k < _missing.size(); k++ )
+			{
+				if ( k > 0 )
+					_error += ", ";
+				_error += _missing[k]->getName();
+			}
+			break;
+		case TOO_MANY_ARGUMENTS:
+			_error = "Too many arguments!";
+			break;
+		case ALREADY_SET:
+			_error = "Argument already set!";
+			break;
+		case EXCLUSIVE_SET:
+			_error = "Mutually exclusive argument already set!";
+			break;
+		case MISSING_DELIMITER:
+			_error = "Couldn't find delimiter for this argument!";
+			break;
+		case MISSING_VALUE:
+			_error = "Missing a value for this argument!";
+			break;
+		case INVALID_VALUE:
+		case EXTRA_VALUE:
+			_error = ExtractErrorText( _errorCode, _errorValue );
+			break;
+		case CONSTRAINT_FAILED:
+			_error = "Value '" + _errorValue + "' does not meet constraint: " +
+			         ( _errorArg != NULL
+			           ? _errorArg->constraintFailure( _errorValue ) : "" );
+			break;
+		case RESPONSE_FILE_ERROR:
+			_error = _errorReason != NULL ? _errorReason : "";
+			break;
+		case UNTERMINATED_QUOTE:
+			_error = "Unterminated quote in command string";
+			break;
+		default:
+			break;
+	}
+}
+
+inline std::string ParseResult::getErrorId() const
+{
+	std::string id;
+	if ( _errorCode == OTHER_ERROR || !_errorId( id ) )
+		id = "undefined";
+	return id;
+}
+
+inline void ParseResult::throwError() const
+{
+	if ( _errorCode == NO_PARSE_ERROR )
+	{
+		if ( _exitRequested )
+			TCLAP_THROW( ExitException( _exitStatus ) );
+		return;
+	}
+
+	if ( isValueError() )
+		TCLAP_THROW( ArgParseException( getError(), getErrorId() ) );
+	else
+		TCLAP_THROW( CmdLineParseException( getError(), getErrorId() ) );
+}
+
 } //namespace TCLAP
 
 #endif
@@ -27,6 +27,39 @@
 
 #include <string>
 #include <exception>
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * Whether the library may throw, false when it is compiled with
+ * exceptions disabled, e.g. with -fno-exceptions.  Can be defined by
+ * clients to override the detection.
+ */
+#ifndef TCLAP_HAS_EXCEPTIONS
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define TCLAP_HAS_EXCEPTIONS 1
+#else
+#define TCLAP_HAS_EXCEPTIONS 0
+#endif
+#endif
+
+#if defined(__GNUC__)
+#define TCLAP_NORETURN __attribute__((noreturn))
+#elif defined(_MSC_VER)
+#define TCLAP_NORETURN __declspec(noreturn)
+#else
+#define TCLAP_NORETURN
+#endif
+
+/**
+ * Throws the given exception, or, without exceptions, does what
+ * catching it would most likely have done, see ExceptionsDisabled().
+ */
+#if TCLAP_HAS_EXCEPTIONS
+#define TCLAP_THROW(e) throw e
+#else
+#define TCLAP_THROW(e) TCLAP::ExceptionsDisabled(e)
+#endif
 
 namespace TCLAP {
 
@@ -207,6 +240,30 @@ private:
 	int _estat;
 };
 
+/**
+ * Stands in for throwing an ExitException when exceptions are disabled:
+ * exits with its status.
+ * \param e - The exception that would have been thrown.
+ */
+TCLAP_NORETURN inline void ExceptionsDisabled(const ExitException& e)
+{
+	std::exit(e.getExitStatus());
+}
+
+/**
+ * Stands in for throwing any other exception when exceptions are
+ * disabled, which is a programming error, e.g. a SpecificationException,
+ * or an invalid value read lazily, see CmdLine::setLazyConversion():
+ * prints what() and aborts.
+ * \param e - The exception that would have been thrown.
+ */
+TCLAP_NORETURN inline void ExceptionsDisabled(const std::exception& e)
+{
+	std::fputs(e.what(), stderr);
+	std::fputs("\n", stderr);
+	std::abort();
+}
+
 } // namespace TCLAP
 
 #endif
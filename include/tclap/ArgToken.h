@@ -0,0 +1,549 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+/******************************************************************************
+ *
+ *  file:  ArgToken.h
+ *
+ *  Copyright (c) 2018, Google LLC
+ *  All rights reserved.
+ *
+ *  See the file COPYING in the top directory of this distribution for
+ *  more information.
+ *
+ *  THE SOFTWARE IS PROVIDED _AS IS_, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ *  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *  DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+// This is an internal tclap file, you should probably not have to
+// include this directly
+
+#ifndef TCLAP_ARG_TOKEN_H
+#define TCLAP_ARG_TOKEN_H
+
+#include <string>
+#include <vector>
+#include <cstring>
+
+#include <tclap/ResponseFile.h>
+#include <tclap/ShellTokenizer.h>
+
+namespace TCLAP {
+
+/**
+ * A single command line argument, classified once before it is offered
+ * to any Arg.  The token refers to the argument string rather than
+ * copying it and records where the flag/name and the value are, so Args
+ * can match and extract values without rescanning the string.  See
+ * Arg::classifyToken for how the kinds are assigned.
+ */
+class ArgToken
+{
+	public:
+
+		/**
+		 * The kinds of argument that can appear on the command line.
+		 */
+		enum Kind {
+			POSITIONAL,   ///< not labeled, e.g. "file.txt" or "-"
+			FLAG,         ///< a single flag, e.g. "-f" or "-f=value"
+			NAME,         ///< a name, e.g. "--name" or "--name=value"
+			COMBINED,     ///< several switch flags, e.g. "-abc"
+			IGNORE_REST   ///< the "--" that ends the labeled arguments
+		};
+
+		/**
+		 * Creates an unclassified (POSITIONAL) token.
+		 * \param s - The argument string, which must stay valid and
+		 * NUL terminated for the lifetime of the token.
+		 * \param length - The length of s.
+		 */
+		ArgToken( const char* s, std::size_t length )
+		: _str(s),
+		  _length(length),
+		  _kind(POSITIONAL),
+		  _labelBegin(0),
+		  _labelEnd(0),
+		  _valueBegin(length),
+		  _hasValue(false),
+		  _consumed(0)
+		{ }
+
+		/**
+		 * Sets the kind of token and where its flag/name is.
+		 */
+		void setLabel( Kind kind, std::size_t begin, std::size_t end )
+		{
+			_kind = kind;
+			_labelBegin = begin;
+			_labelEnd = end;
+		}
+
+		/**
+		 * Sets where the value following the delimiter starts.
+		 */
+		void setValue( std::size_t begin )
+		{
+			_valueBegin = begin;
+			_hasValue = true;
+		}
+
+		Kind kind() const { return _kind; }
+
+		/**
+		 * The whole argument.
+		 */
+		const char* c_str() const { return _str; }
+
+		std::size_t length() const { return _length; }
+
+		std::string str() const { return std::string( _str, _length ); }
+
+		/**
+		 * The flag char(s) or name, without start string or value.
+		 */
+		const char* label() const { return _str + _labelBegin; }
+
+		std::size_t labelLength() const { return _labelEnd - _labelBegin; }
+
+		/**
+		 * The argument up to the end of the flag/name, i.e. including
+		 * the start string but not the delimiter and value.
+		 */
+		std::string id() const { return std::string( _str, _labelEnd ); }
+
+		/**
+		 * Assigns id() to s, reusing its storage.
+		 */
+		void id( std::string& s ) const { s.assign( _str, _labelEnd ); }
+
+		/**
+		 * Whether the label is exactly the given string.
+		 */
+		bool labelIs( const std::string& s ) const
+		{
+			return s.length() == labelLength() &&
+			       std::memcmp( label(), s.data(), s.length() ) == 0;
+		}
+
+		/**
+		 * Whether the flag/name is followed by the delimiter and a
+		 * (possibly empty) value.
+		 */
+		bool hasValue() const { return _hasValue; }
+
+		/**
+		 * The value given after the delimiter, if any.  Runs to the end of
+		 * the argument so it is NUL terminated.
+		 */
+		const char* value() const { return _str + _valueBegin; }
+
+		std::size_t valueLength() const { return _length - _valueBegin; }
+
+		/**
+		 * Marks n of the flags in a COMBINED token as matched.
+		 */
+		void consume( std::size_t n ) { _consumed += n; }
+
+		/**
+		 * The number of flags in a COMBINED token that have been matched.
+		 */
+		std::size_t consumed() const { return _consumed; }
+
+	private:
+
+		const char* _str;
+		std::size_t _length;
+		Kind _kind;
+		std::size_t _labelBegin;
+		std::size_t _labelEnd;
+		std::size_t _valueBegin;
+		bool _hasValue;
+		std::size_t _consumed;
+};
+
+/**
+ * The tokens of one command line, without the program name.  The tokens
+ * refer to the caller's strings, either a vector of strings or argv
+ * itself.  Unless the caller's vector can be used, a vector of strings
+ * is only created if an Arg that implements just Arg::processArg asks
+ * for it.
+ */
+class ArgTokenList
+{
+	public:
+
+		/**
+		 * Creates an unclassified token for each of the strings.
+		 * \param args - The arguments, which must not be modified while
+		 * the list is in use.
+		 */
+		ArgTokenList( std::vector<std::string>& args );
+
+		/**
+		 * Creates an unclassified token for each of the strings starting
+		 * at the given one, without copying them.
+		 * \param args - The arguments, which must not be modified while
+		 * the list is in use.
+		 * \param begin - The index of the first argument.
+		 */
+		ArgTokenList( const std::vector<std::string>& args,
+		              std::size_t begin );
+
+		/**
+		 * Creates an unclassified token for each of the C strings,
+		 * without copying them.
+		 * \param count - The number of arguments.
+		 * \param args - The arguments, which must stay valid while the
+		 * list is in use.
+		 */
+		ArgTokenList( int count, const char * const * args );
+
+		/**
+		 * Creates an unclassified token for each of the words of a
+		 * command string starting at the given one, without copying
+		 * them.
+		 * \param words - The words, which must not be modified while the
+		 * list is in use.
+		 * \param begin - The index of the first word.
+		 */
+		ArgTokenList( const ShellTokenizer& words, std::size_t begin );
+
+		/**
+		 * Creates an empty list, see add().
+		 */
+		ArgTokenList();
+
+		~ArgTokenList();
+
+		std::size_t size() const { return _tokens.size(); }
+
+		ArgToken& operator[]( std::size_t i ) { return _tokens[i]; }
+
+		const ArgToken& operator[]( std::size_t i ) const
+		{ return _tokens[i]; }
+
+		/**
+		 * The arguments as strings, indexed like the tokens.  Created on
+		 * the first call if the list was built from C strings.
+		 */
+		std::vector<std::string>& strings();
+
+		/**
+		 * Adds an unclassified token for the string, without copying it.
+		 * \param s - The argument, which must stay valid and NUL
+		 * terminated while the list is in use.
+		 * \param length - The length of s.
+		 */
+		void add( const char* s, std::size_t length );
+
+		/**
+		 * Removes all tokens, keeping the storage for the next ones.
+		 */
+		void clear();
+
+		/**
+		 * Replaces each "@file" argument by the arguments read from the
+		 * file, recursively.  The files are kept open by the list, so
+		 * the arguments in them aren't copied.  Returns false if a file
+		 * can't be expanded, see error().
+		 * \param format - How the arguments in the files are separated.
+		 * \param maxSize - The largest number of bytes read from all the
+		 * files together.
+		 */
+		bool expandResponseFiles( ResponseFile::Format format,
+		                          std::size_t maxSize );
+
+		/**
+		 * Adds an argument read from a response file, expanding it if it
+		 * names a response file itself.  Called by ResponseFile::tokenize.
+		 * Returns false if a file can't be expanded.
+		 * \param s - The argument, which must stay valid and NUL
+		 * terminated while the list is in use.
+		 * \param length - The length of s.
+		 */
+		bool addArgument( const char* s, std::size_t length );
+
+		/**
+		 * Why a response file can't be expanded, or NULL.
+		 */
+		const char* error() const { return _error; }
+
+		/**
+		 * The name of the response file that can't be expanded.
+		 */
+		const std::string& errorPath() const { return _errorPath; }
+
+		/**
+		 * The index of the given argument that names the response file
+		 * that can't be expanded, or names the file that names it.
+		 */
+		std::size_t errorIndex() const { return _errorIndex; }
+
+		/**
+		 * Whether all of the command string the list was created from
+		 * could be split, false for an unterminated quote.
+		 */
+		bool complete() const { return _complete; }
+
+	private:
+
+		/**
+		 * How deeply response files can be nested, which stops files
+		 * that name themselves.
+		 */
+		enum { MAX_RESPONSE_DEPTH = 32 };
+
+		/**
+		 * Prevent accidental copying.
+		 */
+		ArgTokenList( const ArgTokenList& rhs );
+		ArgTokenList& operator=( const ArgTokenList& rhs );
+
+		std::vector<ArgToken> _tokens;
+
+		std::vector<std::string>* _strings;
+
+		/**
+		 * The strings created by strings() for a list of C strings.
+		 */
+		std::vector<std::string> _ownStrings;
+
+		/**
+		 * The response files the arguments were read from.
+		 */
+		std::vector<ResponseFile*> _files;
+
+		ResponseFile::Format _format;
+
+		/**
+		 * The number of bytes that can still be read from response files.
+		 */
+		std::size_t _budget;
+
+		/**
+		 * How deeply the response file being read is nested.
+		 */
+		int _depth;
+
+		const char* _error;
+
+		std::string _errorPath;
+
+		std::size_t _errorIndex;
+
+		bool _complete;
+};
+
+inline ArgTokenList::ArgTokenList( std::vector<std::string>& args )
+: _tokens(),
+  _strings( &args ),
+  _ownStrings(),
+  _files(),
+  _format( ResponseFile::NONE ),
+  _budget( 0 ),
+  _depth( 0 ),
+  _error( NULL ),
+  _errorPath(),
+  _errorIndex( 0 ),
+  _complete( true )
+{
+	_tokens.reserve( args.size() );
+	for ( std::size_t i = 0; i < args.size(); i++ )
+		_tokens.push_back( ArgToken( args[i].c_str(), args[i].length() ) );
+}
+
+inline ArgTokenList::ArgTokenList( const std::vector<std::string>& args,
+                                   std::size_t begin )
+: _tokens(),
+  _strings( NULL ),
+  _ownStrings(),
+  _files(),
+  _format( ResponseFile::NONE ),
+  _budget( 0 ),
+  _depth( 0 ),
+  _error( NULL ),
+  _errorPath(),
+  _errorIndex( 0 ),
+  _complete( true )
+{
+	_tokens.reserve( args.size() > begin ? args.size() - begin : 0 );
+	for ( std::size_t i = begin; i < args.size(); i++ )
+		_tokens.push_back( ArgToken( args[i].c_str(), args[i].length() ) );
+}
+
+inline ArgTokenList::ArgTokenList( int count, const char * const * args )
+: _tokens(),
+  _strings( NULL ),
+  _ownStrings(),
+  _files(),
+  _format( ResponseFile::NONE ),
+  _budget( 0 ),
+  _depth( 0 ),
+  _error( NULL ),
+  _errorPath(),
+  _errorIndex( 0 ),
+  _complete( true )
+{
+	_tokens.reserve( static_cast<std::size_t>(count) );
+	for ( int i = 0; i < count; i++ )
+		_tokens.push_back( ArgToken( args[i], std::strlen( args[i] ) ) );
+}
+
+inline ArgTokenList::ArgTokenList( const ShellTokenizer& words,
+                                   std::size_t begin )
+: _tokens(),
+  _strings( NULL ),
+  _ownStrings(),
+  _files(),
+  _format( ResponseFile::NONE ),
+  _budget( 0 ),
+  _depth( 0 ),
+  _error( NULL ),
+  _errorPath(),
+  _errorIndex( 0 ),
+  _complete( words.complete() )
+{
+	_tokens.reserve( words.size() > begin ? words.size() - begin : 0 );
+	for ( std::size_t i = begin; i < words.size(); i++ )
+		_tokens.push_back( ArgToken( words.word( i ), words.length( i ) ) );
+}
+
+inline ArgTokenList::ArgTokenList()
+: _tokens(),
+  _strings( NULL ),
+  _ownStrings(),
+  _files(),
+  _format( ResponseFile::NONE ),
+  _budget( 0 ),
+  _depth( 0 ),
+  _error( NULL ),
+  _errorPath(),
+  _errorIndex( 0 ),
+  _complete( true )
+{ }
+
+inline ArgTokenList::~ArgTokenList()
+{
+	for ( std::size_t i = 0; i < _files.size(); i++ )
+		delete _files[i];
+}
+
+inline std::vector<std::string>& ArgTokenList::strings()
+{
+	if ( _strings == NULL )
+	{
+		_ownStrings.reserve( _tokens.size() );
+		for ( std::size_t i = 0; i < _tokens.size(); i++ )
+			_ownStrings.push_back( _tokens[i].str() );
+
+		_strings = &_ownStrings;
+	}
+
+	return *_strings;
+}
+
+inline void ArgTokenList::add( const char* s, std::size_t length )
+{
+	_tokens.push_back( ArgToken( s, length ) );
+
+	// strings() created for the earlier tokens only needs the new one
+	if ( _strings == &_ownStrings )
+		_ownStrings.push_back( _tokens.back().str() );
+	else
+		_strings = NULL;
+}
+
+inline void ArgTokenList::clear()
+{
+	_tokens.clear();
+	_ownStrings.clear();
+	_strings = NULL;
+
+	for ( std::size_t i = 0; i < _files.size(); i++ )
+		delete _files[i];
+	_files.clear();
+
+	_error = NULL;
+	_errorPath.clear();
+	_errorIndex = 0;
+	_complete = true;
+}
+
+inline bool ArgTokenList::expandResponseFiles( ResponseFile::Format format,
+                                               std::size_t maxSize )
+{
+	if ( format == ResponseFile::NONE )
+		return true;
+
+	std::size_t first = 0;
+	while ( first < _tokens.size() &&
+	        ( _tokens[first].length() <= 1 ||
+	          _tokens[first].c_str()[0] != '@' ) )
+		first++;
+
+	if ( first == _tokens.size() )
+		return true;
+
+	// the arguments from the first "@file" on are added again
+	std::vector<ArgToken> given( _tokens.begin() + first, _tokens.end() );
+	_tokens.erase( _tokens.begin() + first, _tokens.end() );
+
+	_format = format;
+	_budget = maxSize;
+	// the strings no longer match the tokens
+	_strings = NULL;
+	_ownStrings.clear();
+
+	for ( std::size_t i = 0; i < given.size(); i++ )
+		if ( !addArgument( given[i].c_str(), given[i].length() ) )
+		{
+			_errorIndex = first + i;
+			return false;
+		}
+
+	return true;
+}
+
+inline bool ArgTokenList::addArgument( const char* s, std::size_t length )
+{
+	if ( length <= 1 || s[0] != '@' )
+	{
+		_tokens.push_back( ArgToken( s, length ) );
+		return true;
+	}
+
+	if ( _depth >= MAX_RESPONSE_DEPTH )
+	{
+		_error = "Response files nested too deeply";
+		_errorPath = s + 1;
+		return false;
+	}
+
+	_files.reserve( _files.size() + 1 );
+	ResponseFile* file = new ResponseFile( s + 1, _budget );
+	_files.push_back( file );
+	_budget -= file->size();
+
+	_depth++;
+	const bool ok = file->error() == NULL && file->tokenize( _format, *this );
+	_depth--;
+
+	// the innermost file that failed is reported
+	if ( !ok && _error == NULL )
+	{
+		_error = file->error();
+		_errorPath = file->path();
+	}
+
+	return ok;
+}
+
+} //namespace TCLAP
+
+#endif
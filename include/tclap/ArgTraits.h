@@ -41,6 +41,17 @@ struct ValueLike {
 	virtual ~ValueLike() {}
 };
 
+/**
+ * A number like argument value type is one of the built in integral or
+ * floating point types.  It is value like, but its values are read by a
+ * parser that accepts what operator>> would without constructing a
+ * stream.
+ */
+struct NumberLike : public ValueLike {
+    typedef NumberLike ValueCategory;
+	virtual ~NumberLike() {}
+};
+
 /**
  * A string like argument value type is a value that can be set using
  * operator=(string). Useful if the value type contains spaces which
@@ -0,0 +1,395 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+/******************************************************************************
+ *
+ *  file:  BashCompletionOutput.h
+ *
+ *  Copyright (c) 2018, Google LLC
+ *  All rights reserved.
+ *
+ *  See the file COPYING in the top directory of this distribution for
+ *  more information.
+ *
+ *  THE SOFTWARE IS PROVIDED _AS IS_, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ *  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *  DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef TCLAP_BASHCOMPLETIONOUTPUT_H
+#define TCLAP_BASHCOMPLETIONOUTPUT_H
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <list>
+#include <iostream>
+#include <map>
+#include <cctype>
+
+#include <tclap/CmdLineInterface.h>
+#include <tclap/CmdLineOutput.h>
+#include <tclap/XorHandler.h>
+#include <tclap/Arg.h>
+
+namespace TCLAP {
+
+/**
+ * A class that generates a Bash completion script as output from the
+ * usage() method for the given CmdLine and its Args.  The script is
+ * static: the options, the values of ValuesConstraints and the xor'd
+ * groups are written into it, so completing never runs the program.
+ * Values are completed from the common hints, e.g. file names for an
+ * Arg whose value is described as "file".
+ */
+class BashCompletionOutput : public CmdLineOutput
+{
+
+	public:
+
+		BashCompletionOutput();
+
+		/**
+		 * Prints the completion script to stdout.
+		 * \param c - The CmdLine object the output is generated for.
+		 */
+		virtual void usage(CmdLineInterface& c);
+
+		/**
+		 * Prints the version to stdout.
+		 * \param c - The CmdLine object the output is generated for.
+		 */
+		virtual void version(CmdLineInterface& c);
+
+		/**
+		 * Prints the error message to stdout.
+		 * \param c - The CmdLine object the output is generated for.
+		 * \param e - The ArgException that caused the failure.
+		 */
+		virtual void failure(CmdLineInterface& c,
+		                     ArgException& e );
+
+	protected:
+
+		void basename( std::string& s );
+		void quote( std::string& s );
+
+		/**
+		 * The description of the value of a, without brackets, e.g.
+		 * "file" or "a|b|c".
+		 */
+		std::string valueId( Arg* a );
+
+		/**
+		 * The start strings and flag and name of a, separated by sep.
+		 */
+		std::string labels( Arg* a, const std::string& sep );
+
+		/**
+		 * Prints the statements that complete the value of a.
+		 */
+		void printValue( Arg* a, const std::string& indent );
+
+		/**
+		 * Prints the statement that offers a as long as neither a, if
+		 * it can't be repeated, nor the Args xor'd with it were given.
+		 */
+		void printOption( CmdLineInterface& _cmd, Arg* a,
+		                  const std::string& given );
+
+		/**
+		 * The compgen actions for the common descriptions of values.
+		 */
+		std::map<std::string, std::string> common;
+		char theDelimiter;
+};
+
+inline BashCompletionOutput::BashCompletionOutput()
+: common(std::map<std::string, std::string>()),
+  theDelimiter(' ')
+{
+	common["host"] = "-A hostname";
+	common["hostname"] = "-A hostname";
+	common["file"] = "-f";
+	common["filename"] = "-f";
+	common["user"] = "-u";
+	common["username"] = "-u";
+	common["directory"] = "-d";
+	common["path"] = "-d";
+}
+
+inline void BashCompletionOutput::version(CmdLineInterface& _cmd)
+{
+	std::cout << _cmd.getVersion() << std::endl;
+}
+
+inline void BashCompletionOutput::failure( CmdLineInterface& _cmd,
+                                           ArgException& e )
+{
+	static_cast<void>(_cmd); // unused
+	std::cout << e.what() << std::endl;
+}
+
+inline void BashCompletionOutput::usage(CmdLineInterface& _cmd )
+{
+	std::list<Arg*> argList = _cmd.getArgList();
+	std::string progName = _cmd.getProgramName();
+	theDelimiter = _cmd.getDelimiter();
+	basename(progName);
+
+	// the name of the function can't have all characters of a file name
+	std::string func = "_" + progName;
+	for ( std::string::size_type i = 1; i < func.length(); i++ )
+		if ( !std::isalnum( static_cast<unsigned char>(func[i]) ) )
+			func[i] = '_';
+
+	std::vector<Arg*> options;
+	std::vector<Arg*> unlabeled;
+	bool ignoreRest = false;
+	for (ArgListIterator it = argList.begin(); it != argList.end(); it++)
+	{
+		if ( (*it)->shortID().at(0) == '<' )
+			unlabeled.push_back(*it);
+		else if ( (*it)->getFlag() != "-" )
+			options.push_back(*it);
+		else
+			ignoreRest = true;
+	}
+
+	std::cout << "# bash completion for " << progName << std::endl <<
+		"# " << progName << " version " << _cmd.getVersion() << std::endl <<
+		std::endl <<
+		func << "_given()" << std::endl <<
+		"{" << std::endl <<
+		"    local w a" << std::endl <<
+		"    for w in \"${COMP_WORDS[@]:1:COMP_CWORD-1}\"; do" << std::endl <<
+		"        for a in \"$@\"; do" << std::endl <<
+		"            [[ $w == \"$a\" || $w == \"$a\"=* ]] && return 0" <<
+		std::endl <<
+		"        done" << std::endl <<
+		"    done" << std::endl <<
+		"    return 1" << std::endl <<
+		"}" << std::endl <<
+		std::endl <<
+		func << "()" << std::endl <<
+		"{" << std::endl <<
+		"    local cur=\"${COMP_WORDS[COMP_CWORD]}\"" << std::endl <<
+		"    local prev=\"${COMP_WORDS[COMP_CWORD-1]}\"" << std::endl;
+
+	// bash splits "--name=value" at the "="
+	if ( theDelimiter == '=' )
+		std::cout << "    if [[ $cur == = ]]; then" << std::endl <<
+			"        cur=" << std::endl <<
+			"    elif [[ $prev == = ]]; then" << std::endl <<
+			"        prev=\"${COMP_WORDS[COMP_CWORD-2]}\"" << std::endl <<
+			"    fi" << std::endl;
+
+	std::string valued;
+	for ( std::size_t i = 0; i < options.size(); i++ )
+		if ( options[i]->isValueRequired() )
+			valued += ( valued.empty() ? "" : "|" ) + labels( options[i], "|" );
+
+	if ( !valued.empty() )
+	{
+		std::cout << std::endl << "    case \"$prev\" in" << std::endl;
+		for ( std::size_t i = 0; i < options.size(); i++ )
+			if ( options[i]->isValueRequired() )
+			{
+				std::cout << "        " << labels( options[i], "|" ) << ")" <<
+					std::endl;
+				printValue( options[i], "            " );
+				std::cout << "            return 0" << std::endl <<
+					"            ;;" << std::endl;
+			}
+		std::cout << "    esac" << std::endl;
+	}
+
+	std::cout << std::endl << "    if [[ $cur == -* ]]";
+	if ( ignoreRest )
+		std::cout << " && ! " << func << "_given --";
+	std::cout << "; then" << std::endl <<
+		"        local opts=" << std::endl;
+	for ( std::size_t i = 0; i < options.size(); i++ )
+		printOption( _cmd, options[i], func + "_given" );
+	std::cout << "        COMPREPLY=( $(compgen -W \"$opts\" -- \"$cur\") )" <<
+		std::endl;
+	if ( theDelimiter == '=' )
+		std::cout << "        [[ ${COMPREPLY[0]} == *= ]] && " <<
+			"compopt -o nospace 2>/dev/null" << std::endl;
+	std::cout << "        return 0" << std::endl <<
+		"    fi" << std::endl;
+
+	if ( !unlabeled.empty() )
+	{
+		// count the unlabeled arguments given so far, skipping values
+		std::cout << std::endl <<
+			"    local i n=0" << std::endl <<
+			"    for (( i=1; i < COMP_CWORD; i++ )); do" << std::endl <<
+			"        case \"${COMP_WORDS[i]}\" in" << std::endl;
+		if ( theDelimiter == '=' )
+			std::cout << "            =) (( i++ )) ;;" << std::endl;
+		else if ( !valued.empty() )
+			std::cout << "            " << valued << ") (( i++ )) ;;" <<
+				std::endl;
+		std::cout << "            -*) ;;" << std::endl <<
+			"            *) (( n++ )) ;;" << std::endl <<
+			"        esac" << std::endl <<
+			"    done" << std::endl <<
+			std::endl <<
+			"    case $n in" << std::endl;
+		for ( std::size_t i = 0; i < unlabeled.size(); i++ )
+		{
+			if ( unlabeled[i]->acceptsMultipleValues() )
+				std::cout << "        *)" << std::endl;
+			else
+				std::cout << "        " << i << ")" << std::endl;
+			printValue( unlabeled[i], "            " );
+			std::cout << "            ;;" << std::endl;
+			if ( unlabeled[i]->acceptsMultipleValues() )
+				break;
+		}
+		std::cout << "    esac" << std::endl;
+	}
+
+	std::cout << "}" << std::endl <<
+		"complete -F " << func << " " << progName << std::endl;
+}
+
+inline void BashCompletionOutput::printValue( Arg* a,
+                                              const std::string& indent )
+{
+	std::string arg = valueId( a );
+
+	std::map<std::string, std::string>::iterator compArg =
+		common.find( arg );
+	if ( compArg == common.end() )
+		compArg = common.find( a->getName() );
+
+	if ( compArg != common.end() )
+	{
+		if ( compArg->second == "-f" || compArg->second == "-d" )
+			std::cout << indent << "compopt -o filenames 2>/dev/null" <<
+				std::endl;
+		std::cout << indent << "COMPREPLY=( $(compgen " << compArg->second <<
+			" -- \"$cur\") )" << std::endl;
+		return;
+	}
+
+	if ( arg.find('|') == std::string::npos )
+		return;
+
+	// the allowed values, without the "..." of a long list
+	std::string words;
+	std::string::size_type b = 0;
+	while ( b <= arg.length() )
+	{
+		std::string::size_type e = arg.find('|', b);
+		if ( e == std::string::npos )
+			e = arg.length();
+
+		std::string word = arg.substr(b, e - b);
+		if ( word != "..." )
+		{
+			// compgen expands the words once more
+			std::string::size_type q = word.find_first_of("'\"\\$`");
+			while ( q != std::string::npos )
+			{
+				word.insert(q, 1, '\\');
+				q = word.find_first_of("'\"\\$`", q + 2);
+			}
+			words += ( words.empty() ? "" : " " ) + word;
+		}
+		b = e + 1;
+	}
+
+	quote( words );
+	std::cout << indent << "COMPREPLY=( $(compgen -W " << words <<
+		" -- \"$cur\") )" << std::endl;
+}
+
+inline void BashCompletionOutput::printOption( CmdLineInterface& _cmd,
+                                               Arg* a,
+                                               const std::string& given )
+{
+	XorHandler& xorHandler = _cmd.getXorHandler();
+	const std::vector< std::vector<Arg*> >& xorList = xorHandler.getXorList();
+
+	std::string exclusive;
+	const int g = xorHandler.getXorGroup( a );
+	if ( g >= 0 )
+	{
+		for ( ArgVectorIterator it = xorList[g].begin();
+		      it != xorList[g].end(); it++ )
+			if ( *it != a || !a->isRepeatable() )
+				exclusive += " " + labels( *it, " " );
+	}
+	else if ( !a->isRepeatable() )
+		exclusive = " " + labels( a, " " );
+
+	std::string offered = labels( a, " " );
+	if ( theDelimiter == '=' && a->isValueRequired() )
+		offered = labels( a, "= " ) + "=";
+
+	std::cout << "        ";
+	if ( !exclusive.empty() )
+		std::cout << given << exclusive << " || ";
+	std::cout << "opts+=' " << offered << "'" << std::endl;
+}
+
+inline std::string BashCompletionOutput::labels( Arg* a,
+                                                 const std::string& sep )
+{
+	std::string s;
+	if ( !a->getFlag().empty() )
+		s = Arg::flagStartString() + a->getFlag() + sep;
+	return s + Arg::nameStartString() + a->getName();
+}
+
+inline std::string BashCompletionOutput::valueId( Arg* a )
+{
+	std::string arg = a->shortID();
+
+	// Example arg: "[-A <integer>] ..."
+	std::string::size_type pos = arg.rfind(" ...");
+	if ( pos != std::string::npos )
+		arg.erase(pos);
+
+	pos = arg.find('<');
+	if ( pos != std::string::npos )
+		arg.erase(0, pos + 1);
+	pos = arg.rfind('>');
+	if ( pos != std::string::npos )
+		arg.erase(pos);
+
+	return arg;
+}
+
+inline void BashCompletionOutput::quote( std::string& s )
+{
+	std::string::size_type idx = s.find('\'');
+	while ( idx != std::string::npos )
+	{
+		s.replace(idx, 1, "'\\''");
+		idx = s.find('\'', idx + 4);
+	}
+	s = "'" + s + "'";
+}
+
+inline void BashCompletionOutput::basename( std::string& s )
+{
+	std::string::size_type p = s.find_last_of('/');
+	if ( p != std::string::npos )
+	{
+		s.erase(0, p + 1);
+	}
+}
+
+} //namespace TCLAP
+#endif
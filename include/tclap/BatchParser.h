@@ -0,0 +1,438 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+/******************************************************************************
+ *
+ *  file:  BatchParser.h
+ *
+ *  Copyright (c) 2018, Google LLC
+ *  All rights reserved.
+ *
+ *  See the file COPYING in the top directory of this distribution for
+ *  more information.
+ *
+ *  THE SOFTWARE IS PROVIDED _AS IS_, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ *  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *  DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef TCLAP_BATCH_PARSER_H
+#define TCLAP_BATCH_PARSER_H
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <istream>
+#include <exception>
+
+#include <tclap/CmdLine.h>
+#include <tclap/ParseResult.h>
+#include <tclap/ArgException.h>
+#include <tclap/ShellTokenizer.h>
+
+// The command lines are parsed with std::thread where it is available,
+// with POSIX threads otherwise, and in the calling thread if neither is.
+// Define TCLAP_NO_THREADS to always parse in the calling thread.
+#if !defined(TCLAP_NO_THREADS)
+#if __cplusplus >= 201103L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201103L)
+#define TCLAP_STD_THREADS
+#include <thread>
+#include <system_error>
+#elif defined(HAVE_PTHREAD_H) || defined(__unix__) || defined(__APPLE__)
+#define TCLAP_POSIX_THREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+#endif
+
+namespace TCLAP {
+
+/**
+ * Parses many command lines against one CmdLine, spread over several
+ * threads, e.g. to validate the lines of a job manifest.  Each command
+ * line is parsed into its own ParseResult with CmdLine::tryParse(), so
+ * an invalid command line neither throws nor exits, its error is
+ * recorded in its result.  The results are indexed like the command
+ * lines, whatever order the threads finish them in.  The CmdLine must
+ * not be modified while a batch is parsed and all its Args must
+ * implement Arg::processToken(), see CmdLine::parse(const
+ * std::vector<std::string>&, ParseResult&) const.  Visitors aren't run
+ * in the threads, a line with --help or --version is recorded as a
+ * request to exit rather than an error, see
+ * ParseResult::exitRequested() and getExitCount().
+ */
+class BatchParser
+{
+	public:
+
+		/**
+		 * \param cmd - The CmdLine that defines the command lines.
+		 * \param numThreads - The number of threads to parse with, 0 for
+		 * one per processor.
+		 */
+		BatchParser( const CmdLine& cmd, unsigned int numThreads = 0 );
+
+		~BatchParser();
+
+		/**
+		 * Parses each of the command lines, replacing the results of the
+		 * last batch.
+		 * \param lines - The command lines, each a vector of strings with
+		 * the program name first.
+		 */
+		void parse( const std::vector< std::vector<std::string> >& lines );
+
+		/**
+		 * Parses the command lines of a manifest, one per line with the
+		 * program name first.  Each line is split into arguments as sh
+		 * would, see ShellTokenizer: they are separated by white space,
+		 * which can be kept in an argument by quoting it with '' or ""
+		 * or escaping it with a backslash.  Nothing is expanded and a #
+		 * doesn't start a comment.  A line with a quote that isn't
+		 * closed is invalid, see CmdLine::tryParseCommand().  Lines of
+		 * only white space are skipped, so the results are indexed like
+		 * the remaining lines.
+		 * \param manifest - The stream to read the manifest from.
+		 */
+		void parse( std::istream& manifest );
+
+		/**
+		 * The number of command lines in the last batch.
+		 */
+		std::size_t size() const;
+
+		/**
+		 * The outcome of parsing a command line of the last batch.
+		 * \param i - The index of the command line.
+		 */
+		const ParseResult& getResult( std::size_t i ) const;
+
+		/**
+		 * The number of invalid command lines in the last batch.
+		 */
+		std::size_t getErrorCount() const;
+
+		/**
+		 * The number of command lines in the last batch that asked to
+		 * exit without an error, e.g. with --help or --version.  Their
+		 * exit status is ParseResult::getExitStatus().
+		 */
+		std::size_t getExitCount() const;
+
+		/**
+		 * The number of threads the command lines are parsed with.
+		 */
+		unsigned int getThreadCount() const;
+
+	private:
+
+		/**
+		 * Prevent accidental copying.
+		 */
+		BatchParser( const BatchParser& rhs );
+		BatchParser& operator=( const BatchParser& rhs );
+
+		/**
+		 * The number of consecutive command lines a thread parses in
+		 * turn, so the threads don't share the cache lines of results.
+		 */
+		enum { CHUNK_SIZE = 64 };
+
+		/**
+		 * The share of the command lines a thread parses.
+		 */
+		struct Share
+		{
+			BatchParser* parser;
+			unsigned int index;
+			unsigned int count;
+		};
+
+		/**
+		 * Parses the command lines in _lines or _commands.
+		 * \param size - The number of command lines.
+		 */
+		void _parse( std::size_t size );
+
+		/**
+		 * Parses a share of the command lines.  The lines are split into
+		 * chunks of consecutive lines that are dealt out to the threads
+		 * in turn.
+		 * \param index - The index of the share.
+		 * \param count - The number of shares.
+		 */
+		void _parseShare( unsigned int index, unsigned int count );
+
+		/**
+		 * Parses a single command line into its result.
+		 * \param i - The index of the command line.
+		 */
+		void _parseLine( std::size_t i );
+
+		/**
+		 * Parses the i'th command line, of _commands or _lines.
+		 * \param i - The index of the command line.
+		 * \param result - Where the outcome is recorded.
+		 */
+		void _tryParse( std::size_t i, ParseResult& result );
+
+#if defined(TCLAP_POSIX_THREADS)
+		/**
+		 * The start routine of a thread, parses the Share it is given.
+		 */
+		static void* _run( void* share );
+#endif
+
+		/**
+		 * The number of processors, at least 1.
+		 */
+		static unsigned int _processorCount();
+
+		const CmdLine& _cmd;
+
+		unsigned int _numThreads;
+
+		/**
+		 * The command lines of the batch being parsed.
+		 */
+		const std::vector< std::vector<std::string> >* _lines;
+
+		/**
+		 * The command lines of the manifest being parsed, unsplit.
+		 */
+		const std::vector<std::string>* _commands;
+
+		/**
+		 * The results, kept from batch to batch so their storage is
+		 * reused.  Only the first _size belong to the last batch.
+		 */
+		std::vector<ParseResult*> _results;
+
+		std::size_t _size;
+
+		std::size_t _errorCount;
+
+		std::size_t _exitCount;
+};
+
+inline BatchParser::BatchParser( const CmdLine& cmd, unsigned int numThreads )
+: _cmd( cmd ),
+  _numThreads( numThreads > 0 ? numThreads : _processorCount() ),
+  _lines( NULL ),
+  _commands( NULL ),
+  _results(),
+  _size( 0 ),
+  _errorCount( 0 ),
+  _exitCount( 0 )
+{
+#if !defined(TCLAP_STD_THREADS) && !defined(TCLAP_POSIX_THREADS)
+	_numThreads = 1;
+#endif
+}
+
+inline BatchParser::~BatchParser()
+{
+	for ( std::size_t i = 0; i < _results.size(); i++ )
+		delete _results[i];
+}
+
+inline void BatchParser::parse(
+	const std::vector< std::vector<std::string> >& lines )
+{
+	_lines = &lines;
+	_parse( lines.size() );
+	_lines = NULL;
+}
+
+inline void BatchParser::parse( std::istream& manifest )
+{
+	std::vector<std::string> commands;
+
+	// the lines are split in the threads, as they are parsed
+	std::string line;
+	while ( std::getline( manifest, line ) )
+	{
+		std::size_t k = 0;
+		while ( k < line.length() && ShellTokenizer::isSpace( line[k] ) )
+			k++;
+
+		if ( k < line.length() )
+		{
+			commands.push_back( std::string() );
+			commands.back().swap( line );
+		}
+	}
+
+	_commands = &commands;
+	_parse( commands.size() );
+	_commands = NULL;
+}
+
+inline void BatchParser::_parse( std::size_t size )
+{
+	_results.reserve( size );
+	while ( _results.size() < size )
+		_results.push_back( new ParseResult() );
+
+	_size = size;
+
+	// a thread per chunk at most
+	const std::size_t chunks = ( _size + CHUNK_SIZE - 1 ) / CHUNK_SIZE;
+	const unsigned int count = chunks < _numThreads
+		? static_cast<unsigned int>(chunks) : _numThreads;
+
+#if defined(TCLAP_STD_THREADS)
+	std::vector<std::thread> threads;
+	for ( unsigned int k = 1; k < count; k++ )
+	{
+#if TCLAP_HAS_EXCEPTIONS
+		try {
+			threads.push_back(
+				std::thread( &BatchParser::_parseShare, this, k, count ) );
+		} catch ( std::system_error& ) {
+			_parseShare( k, count );
+		}
+#else
+		threads.push_back(
+			std::thread( &BatchParser::_parseShare, this, k, count ) );
+#endif
+	}
+
+	_parseShare( 0, count );
+
+	for ( std::size_t k = 0; k < threads.size(); k++ )
+		threads[k].join();
+#elif defined(TCLAP_POSIX_THREADS)
+	std::vector<Share> shares( count );
+	std::vector<pthread_t> threads( count );
+	std::vector<bool> started( count, false );
+	for ( unsigned int k = 1; k < count; k++ )
+	{
+		shares[k].parser = this;
+		shares[k].index = k;
+		shares[k].count = count;
+		if ( pthread_create( &threads[k], NULL, &BatchParser::_run,
+		                     &shares[k] ) == 0 )
+			started[k] = true;
+		else
+			_parseShare( k, count );
+	}
+
+	_parseShare( 0, count );
+
+	for ( unsigned int k = 1; k < count; k++ )
+		if ( started[k] )
+			pthread_join( threads[k], NULL );
+#else
+	_parseShare( 0, count );
+#endif
+
+	_errorCount = 0;
+	_exitCount = 0;
+	for ( std::size_t i = 0; i < _size; i++ )
+		if ( _results[i]->hasError() )
+			_errorCount++;
+		else if ( _results[i]->exitRequested() )
+			_exitCount++;
+}
+
+inline std::size_t BatchParser::size() const
+{
+	return _size;
+}
+
+inline const ParseResult& BatchParser::getResult( std::size_t i ) const
+{
+	return *_results[i];
+}
+
+inline std::size_t BatchParser::getErrorCount() const
+{
+	return _errorCount;
+}
+
+inline std::size_t BatchParser::getExitCount() const
+{
+	return _exitCount;
+}
+
+inline unsigned int BatchParser::getThreadCount() const
+{
+	return _numThreads;
+}
+
+inline void BatchParser::_parseShare( unsigned int index, unsigned int count )
+{
+	const std::size_t chunk = CHUNK_SIZE;
+	for ( std::size_t begin = index * chunk; begin < _size;
+	      begin += count * chunk )
+	{
+		const std::size_t end = begin + chunk < _size ? begin + chunk : _size;
+		for ( std::size_t i = begin; i < end; i++ )
+			_parseLine( i );
+	}
+}
+
+inline void BatchParser::_parseLine( std::size_t i )
+{
+	ParseResult& result = *_results[i];
+
+	// the usage isn't printed from the threads
+	result.setRunsVisitors( false );
+	result.setExitsQuietly( true );
+
+	// nothing may escape a thread, so whatever is thrown becomes the
+	// error of the command line
+#if TCLAP_HAS_EXCEPTIONS
+	try {
+		_tryParse( i, result );
+	} catch ( ExitException& e ) {
+		result.requestExit( e.getExitStatus() );
+	} catch ( std::exception& e ) {
+		result.setError( e.what(), "" );
+	} catch ( ... ) {
+		result.setError( "Unknown error", "" );
+	}
+#else
+	_tryParse( i, result );
+#endif
+}
+
+inline void BatchParser::_tryParse( std::size_t i, ParseResult& result )
+{
+	if ( _commands != NULL )
+		_cmd.tryParseCommand( (*_commands)[i], result );
+	else
+		_cmd.tryParse( (*_lines)[i], result );
+}
+
+#if defined(TCLAP_POSIX_THREADS)
+inline void* BatchParser::_run( void* share )
+{
+	Share* s = static_cast<Share*>(share);
+	s->parser->_parseShare( s->index, s->count );
+	return NULL;
+}
+#endif
+
+inline unsigned int BatchParser::_processorCount()
+{
+	long n = 1;
+#if defined(TCLAP_STD_THREADS)
+	n = static_cast<long>(std::thread::hardware_concurrency());
+#elif defined(TCLAP_POSIX_THREADS) && defined(_SC_NPROCESSORS_ONLN)
+	n = sysconf( _SC_NPROCESSORS_ONLN );
+#endif
+	return n > 0 ? static_cast<unsigned int>(n) : 1;
+}
+
+} //namespace TCLAP
+
+#endif
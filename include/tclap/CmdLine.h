@@ -28,21 +28,32 @@
 #include <tclap/MultiSwitchArg.h>
 #include <tclap/UnlabeledValueArg.h>
 #include <tclap/UnlabeledMultiArg.h>
+#include <tclap/ShellTokenizer.h>
 
 #include <tclap/XorHandler.h>
 #include <tclap/HelpVisitor.h>
 #include <tclap/VersionVisitor.h>
 #include <tclap/IgnoreRestVisitor.h>
+#include <tclap/Completion.h>
 
 #include <tclap/CmdLineOutput.h>
 #include <tclap/StdOutput.h>
 
+#ifdef TCLAP_GENERATE
+#include <tclap/DocGenerator.h>
+#endif
+
 #include <tclap/Constraint.h>
 #include <tclap/ValuesConstraint.h>
+#include <tclap/SortedValuesConstraint.h>
+#include <tclap/RangeConstraint.h>
+#include <tclap/PatternConstraint.h>
 
 #include <string>
 #include <vector>
 #include <list>
+#include <map>
+#include <set>
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
@@ -77,6 +88,61 @@ class CmdLine : public CmdLineInterface
 		 */
 		std::list<Arg*> _argList;
 
+		/**
+		 * Index of the labeled Args, keyed by the strings that identify
+		 * them on the command line (flag and name, including the start
+		 * strings).  Maintained by add() so that parse() can resolve a
+		 * labeled argument without offering it to every Arg.
+		 */
+		std::map<std::string, Arg*> _argIndex;
+
+		/**
+		 * The unlabeled Args, in the order they appear in _argList.
+		 * Arguments that don't start with a flag are only offered to
+		 * these.
+		 */
+		std::list<Arg*> _unlabeledList;
+
+		/**
+		 * The labeled Args indexed by their flag char, used to decode
+		 * combined switches and to detect duplicate flags.  Maintained
+		 * by add().
+		 */
+		Arg* _flagTable[256];
+
+		/**
+		 * The order in which the Args in _flagTable were added.
+		 */
+		std::size_t _flagOrder[256];
+
+		/**
+		 * The labeled Args that can be given more than once, whose
+		 * occurrences are counted before a parse, see
+		 * _countOccurrences().  Maintained by add(), which asks each Arg
+		 * once, so that removing it undoes exactly what adding it did.
+		 */
+		std::set<const Arg*> _repeatableArgs;
+
+		/**
+		 * The names of all Args, used to detect duplicate names.
+		 * Maintained by add().
+		 */
+		std::set<std::string> _argNames;
+
+		/**
+		 * The Args by the index that identifies them in a ParseResult,
+		 * to find the Args that were matched.  Maintained by add().
+		 */
+		std::vector<Arg*> _argTable;
+
+		/**
+		 * The index of each Arg in _argTable, which the ParseResults
+		 * this parses into look the Args up in.  Kept here rather than
+		 * in the Arg, which can be added to other CmdLines too.
+		 * Maintained by add().
+		 */
+		std::map<const Arg*, std::size_t> _stateIndices;
+
 		/**
 		 * The name of the program.  Set to argv[0].
 		 */
@@ -99,6 +165,11 @@ class CmdLine : public CmdLineInterface
 		 */
 		int _numRequired;
 
+		/**
+		 * Counts the Args added and removed, see getRevision().
+		 */
+		unsigned long _revision;
+
 		/**
 		 * The character that is used to separate the argument flag/name
 		 * from the value.  Defaults to ' ' (space).
@@ -112,15 +183,14 @@ class CmdLine : public CmdLineInterface
 
 		/**
 		 * A list of Args to be explicitly deleted when the destructor
-		 * is called.  At the moment, this only includes the three default
-		 * Args.
+		 * is called.  The default Args are members and aren't in it.
 		 */
 		std::list<Arg*> _argDeleteOnExitList;
 
 		/**
 		 * A list of Visitors to be explicitly deleted when the destructor
-		 * is called.  At the moment, these are the Visitors created for the
-		 * default Args.
+		 * is called.  The Visitors of the default Args are members and
+		 * aren't in it.
 		 */
 		std::list<Visitor*> _visitorDeleteOnExitList;
 
@@ -134,18 +204,267 @@ class CmdLine : public CmdLineInterface
 		 */
 		bool _handleExceptions;
 
+		/**
+		 * Used by the parse() methods that store into the Args, kept so
+		 * that its storage is reused.
+		 */
+		ParseResult _argsResult;
+
 		/**
 		 * Throws an exception listing the missing args.
+		 * \param result - The outcome of the parse.
+		 */
+		void missingArgsException(const ParseResult& result) const;
+
+		/**
+		 * Records the error listing the missing args.
+		 * \param result - The outcome of the parse.
+		 * \param errors - Where the error is recorded.
+		 */
+		void _missingArgs(const ParseResult& result,
+		                  ParseResult& errors) const;
+
+		/**
+		 * Checks whether all the flags of combined switches have been
+		 * matched, or whether there are no flags at all.  Used when
+		 * multiple switches are combined into a single argument.
+		 * \param token - The argument to check.
+		 */
+		bool _emptyCombined(const ArgToken& token) const;
+
+		/**
+		 * Looks up the labeled Arg identified by the flag/name of the
+		 * given argument.  Returns NULL if the argument is not labeled
+		 * or no labeled Arg uses that flag/name.
+		 * \param token - The argument to look up.
+		 * \param id - Storage for the flag/name, reused between calls.
+		 */
+		Arg* _findLabeled(const ArgToken& token, std::string& id) const;
+
+		/**
+		 * Checks whether a labeled Arg clashes with one that has been
+		 * added, i.e. has the same flag or name.
+		 * \param a - The Arg to check.
+		 */
+		bool _labeledDuplicate(const Arg* a) const;
+
+		/**
+		 * Checks whether an unlabeled Arg clashes with one that has been
+		 * added, according to its operator==.
+		 * \param a - The Arg to check, already in _argList.
+		 */
+		bool _unlabeledDuplicate(const Arg* a) const;
+
+		/**
+		 * Checks whether an optional unlabeled Arg has been added, after
+		 * which no other unlabeled Arg can be added.
+		 */
+		bool _optionalUnlabeled() const;
+
+		/**
+		 * Adds an Arg that has been put in _argList to the indexes.
+		 * \param a - The Arg to add.
+		 * \param labeled - Whether the Arg is labeled.
+		 */
+		void _index(Arg* a, bool labeled);
+
+		/**
+		 * Takes back an Arg that has been added.
+		 * \param a - The Arg to remove.
+		 */
+		void _remove(Arg* a);
+
+		/**
+		 * Passes the flags of combined switches on to the Args they
+		 * belong to, with the number of times each flag appears.  The
+		 * flags that are handled are marked as consumed in the token.
+		 * Returns the number of required Args that have been set.
+		 * \param token - The combined switches.
+		 * \param result - The outcome of the parse so far.
+		 */
+		int _processCombined(ArgToken& token, ParseResult& result) const;
+
+		/**
+		 * Offers the argument at index i to an Arg, through
+		 * processToken(), or through processArg() if the Arg doesn't
+		 * parse tokens, see Arg::parsesTokens().  Returns whether the
+		 * Arg matched.
+		 * \param a - The Arg.
+		 * \param i - The index of the argument.
+		 * \param tokens - The classified arguments.
+		 * \param result - The outcome of the parse so far.
+		 */
+		bool _processToken(const Arg* a, int* i, ArgTokenList& tokens,
+		                   ParseResult& result) const;
+
+		/**
+		 * Passes the flag of an Arg among combined switches on to the
+		 * Arg, through processCombinedFlag(), or through processArg()
+		 * as if the flag were given alone count times if the Arg doesn't
+		 * parse tokens.  Returns whether the Arg matched.
+		 * \param a - The Arg.
+		 * \param flag - The flag.
+		 * \param count - The number of times the flag appears.
+		 * \param result - The outcome of the parse so far.
+		 */
+		bool _processCombinedFlag(const Arg* a, char flag, std::size_t count,
+		                          ParseResult& result) const;
+
+		/**
+		 * Does what follows an Arg being matched: checks the exclusions
+		 * and notes the "--" argument.  Returns the number of required
+		 * Args that have been set.
+		 * \param a - The Arg that was matched.
+		 * \param wasSet - Whether the Arg had been matched before.
+		 * \param result - The outcome of the parse so far.
+		 */
+		int _matched(const Arg* a, bool wasSet, ParseResult& result) const;
+
+		/**
+		 * Parses the arguments following the program name.  Shared by
+		 * all parse() methods.
+		 * \param hasProgName - Whether the program name was given, the
+		 * command line is invalid otherwise.
+		 * \param tokens - The arguments following the program name.
+		 * \param result - Where the outcome of the parse is recorded.
+		 */
+		void _parse(bool hasProgName, ArgTokenList& tokens,
+		            ParseResult& result) const;
+
+		/**
+		 * Parses the arguments following the program name, recording an
+		 * error in the result instead of handling it.  Returns whether
+		 * the command line was valid.
+		 * \param hasProgName - Whether the program name was given.
+		 * \param tokens - The arguments following the program name.
+		 * \param result - Where the outcome of the parse is recorded.
+		 */
+		bool _tryParse(bool hasProgName, ArgTokenList& tokens,
+		               ParseResult& result) const;
+
+		/**
+		 * Parses the arguments following the program name.  If the
+		 * command line is invalid, or the program is asked to exit, the
+		 * parse stops and this is recorded in the result, see
+		 * ParseResult::hasStopped().
+		 * \param hasProgName - Whether the program name was given.
+		 * \param tokens - The arguments following the program name.
+		 * \param result - Where the outcome of the parse is recorded.
+		 */
+		void _parseTokens(bool hasProgName, ArgTokenList& tokens,
+		                  ParseResult& result) const;
+
+		/**
+		 * Parses the argument at index i, and the value following it if
+		 * its Arg takes one, leaving i at the last argument used.
+		 * Returns the number of required Args newly matched.  Stops the
+		 * parse like _parseTokens() does.  Shared with IncrementalParser.
+		 * \param tokens - The classified arguments.
+		 * \param i - The index of the argument.
+		 * \param id - Storage for the id of a labeled argument.
+		 * \param result - Where the outcome of the parse is recorded.
+		 */
+		int _parseToken(ArgTokenList& tokens, int* i, std::string& id,
+		                ParseResult& result) const;
+
+		/**
+		 * Counts how often each labeled Arg that can be given more than
+		 * once is given by its flag or name, in one pass over the
+		 * tokens, so a MultiArg reserves room for all its values when
+		 * it is first matched, see ParseResult::getOccurrences().
+		 * \param tokens - The classified arguments.
+		 * \param id - Storage for the id of a labeled argument.
+		 * \param result - Where the counts are recorded.
+		 */
+		void _countOccurrences(const ArgTokenList& tokens, std::string& id,
+		                       ParseResult& result) const;
+
+		/**
+		 * Records an error if the number of required Args matched by the
+		 * parse isn't the number there are.
+		 * \param requiredCount - The number of required Args matched.
+		 * \param result - Where the outcome of the parse is recorded.
+		 */
+		void _checkRequired(int requiredCount, ParseResult& result) const;
+
+		/**
+		 * Handles what a parse stopped for as the exception for it
+		 * would be handled, see setExceptionHandling().  Returns whether
+		 * the program should exit.
+		 * \param result - The outcome of the parse, which stopped.
+		 * \param estat - Set to the exit status.
+		 */
+		bool _stopped(const ParseResult& result, int& estat) const;
+
+		/**
+		 * Passes an invalid command line on to the output.  Returns
+		 * whether the program should exit, which the output asks for by
+		 * throwing an ExitException.
+		 * \param e - Why the command line is invalid.
+		 * \param estat - Set to the exit status.
+		 */
+		bool _failure(ArgException& e, int& estat) const;
+
+		/**
+		 * Converts the values of the Args that haven't been yet and
+		 * handles an invalid one like _parse() does.
+		 * \param result - The outcome of the parse, or NULL for the
+		 * values stored in the Args.
+		 */
+		void _validateAll(const ParseResult* result) const;
+
+		/**
+		 * Converts the values of the Args that haven't been yet,
+		 * throwing an ArgException for an invalid one.
+		 * \param result - The outcome of the parse, or NULL for the
+		 * values stored in the Args.
+		 */
+		void _validateArgs(const ParseResult* result) const;
+
+		/**
+		 * Converts the values recorded in a result that haven't been
+		 * yet, recording the error for an invalid one.  Returns whether
+		 * they were all valid.
+		 * \param result - The outcome of the parse.
+		 */
+		bool _tryValidateArgs(ParseResult& result) const;
+
+		/**
+		 * Parses the arguments following the program name and stores
+		 * what is found in the Args.  Shared by the parse() methods
+		 * without a ParseResult.
+		 * \param hasProgName - Whether the program name was given.
+		 * \param tokens - The arguments following the program name.
 		 */
-		void missingArgsException();
+		void _parseIntoArgs(bool hasProgName, ArgTokenList& tokens);
 
 		/**
-		 * Checks whether a name/flag string matches entirely matches
-		 * the Arg::blankChar.  Used when multiple switches are combined
-		 * into a single argument.
-		 * \param s - The message to be used in the usage.
+		 * Stores what a parse found in the Args that were matched, and
+		 * marks the Args xor'd with them as set.
+		 * \param result - The outcome of the parse.
 		 */
-		bool _emptyCombined(const std::string& s);
+		void _store(ParseResult& result);
+
+		/**
+		 * Prints the candidates asked for by "--__complete <index>
+		 * <words...>" and asks the parse to exit.
+		 * \param tokens - The arguments following the program name,
+		 * starting with "--__complete".
+		 * \param result - The outcome of the parse.
+		 */
+		void _complete(const ArgTokenList& tokens, ParseResult& result) const;
+
+#ifdef TCLAP_GENERATE
+		/**
+		 * Writes the documentation of the program to the files named by
+		 * the only argument, see DocGenerator::generate(), and asks the
+		 * parse to exit.  The program name becomes the last component
+		 * of that path.
+		 * \param tokens - The arguments following the program name.
+		 * \param result - The outcome of the parse.
+		 */
+		void _generate(const ArgTokenList& tokens, ParseResult& result) const;
+#endif
 
 		/**
 		 * Perform a delete ptr; operation on ptr when this object is deleted.
@@ -159,6 +478,11 @@ class CmdLine : public CmdLineInterface
 
 private:
 
+		/**
+		 * Parses one argument at a time with _parseToken().
+		 */
+		friend class IncrementalParser;
+
 		/**
 		 * Prevent accidental copying.
 		 */
@@ -172,12 +496,6 @@ private:
 		void _constructor();
 
 
-		/**
-		 * Is set to true when a user sets the output object. We use this so
-		 * that we don't delete objects that are created outside of this lib.
-		 */
-		bool _userSetOutput;
-
 		/**
 		 * Whether or not to automatically create help and version switches.
 		 */
@@ -188,6 +506,47 @@ private:
 		 */
 		bool _ignoreUnmatched;
 
+		/**
+		 * How the arguments in response files are separated, or NONE if
+		 * "@file" arguments aren't expanded.
+		 */
+		ResponseFile::Format _responseFiles;
+
+		/**
+		 * The largest number of bytes read from response files for one
+		 * command line.
+		 */
+		std::size_t _responseFileLimit;
+
+		/**
+		 * Whether the values of ValueArgs and MultiArgs are converted
+		 * when they are first read rather than when they are parsed.
+		 */
+		bool _lazyConversion;
+
+		/**
+		 * Whether "--__complete" is answered.
+		 */
+		bool _completion;
+
+		/**
+		 * The output used until the user sets one.
+		 */
+		StdOutput _stdOutput;
+
+		/**
+		 * The default Args and their Visitors.  They are part of the
+		 * CmdLine rather than allocated one by one, so creating and
+		 * destroying a CmdLine doesn't allocate for them.  The help and
+		 * version Args are only added if _helpAndVersion is set.  The
+		 * ignore rest Arg is handled by _matched().
+		 */
+		HelpVisitor _helpVisitor;
+		SwitchArg _helpArg;
+		VersionVisitor _versionVisitor;
+		SwitchArg _versionArg;
+		SwitchArg _ignoreRestArg;
+
 	public:
 
 		/**
@@ -224,6 +583,14 @@ private:
 		 */
 		void add( Arg* a );
 
+		/**
+		 * Adds several arguments at once.  Equivalent to calling add() for
+		 * each of them in turn, except that no argument is added if one
+		 * of them has the same flag/name as another.
+		 * \param args - Arguments to be added.
+		 */
+		void add( const std::vector<Arg*>& args );
+
 		/**
 		 * Add two Args that will be xor'd.  If this method is used, add does
 		 * not need to be called.
@@ -240,7 +607,8 @@ private:
 		void xorAdd( const std::vector<Arg*>& xors );
 
 		/**
-		 * Parses the command line.
+		 * Parses the command line.  The arguments are not copied, strings
+		 * are only created for values that are stored as strings.
 		 * \param argc - Number of arguments.
 		 * \param argv - Array of arguments.
 		 */
@@ -253,6 +621,94 @@ private:
 		 */
 		void parse(std::vector<std::string>& args);
 
+		/**
+		 * Parses the command line into a result, leaving the CmdLine and
+		 * its Args as they are.  Several threads can parse with the same
+		 * CmdLine at once, each into its own result, as long as the
+		 * CmdLine isn't modified meanwhile and all its Args implement
+		 * Arg::processToken() and parse tokens, see
+		 * Arg::parsesTokens().  The Visitors are checked in the parsing
+		 * threads: StdOutput may print from several of them at once,
+		 * other outputs and Visitors must allow it themselves or not be
+		 * run, see ParseResult::setRunsVisitors().  Errors are handled
+		 * as for the other parse() methods, see setExceptionHandling().
+		 * \param argc - Number of arguments.
+		 * \param argv - Array of arguments.
+		 * \param result - Where the outcome is recorded, cleared first.
+		 */
+		void parse(int argc, const char * const * argv,
+		           ParseResult& result) const;
+
+		/**
+		 * Parses the command line into a result, leaving the CmdLine and
+		 * its Args as they are.  See above.
+		 * \param args - A vector of strings representing the args.
+		 * args[0] is still the program name.
+		 * \param result - Where the outcome is recorded, cleared first.
+		 */
+		void parse(const std::vector<std::string>& args,
+		           ParseResult& result) const;
+
+		/**
+		 * Parses the command line into a result like parse() does, but
+		 * neither handles nor throws an ArgException for an invalid
+		 * command line, whatever setExceptionHandling() says, nor exits.
+		 * The error is recorded in the result instead, as a code, the
+		 * index of the argument and the Arg, and the message is only
+		 * put together if it is asked for, see ParseResult::hasError().
+		 * The --help and --version Args print what they do and ask the
+		 * program to exit, see ParseResult::exitRequested().  Returns
+		 * false in either case, true if the program can go on.  This
+		 * doesn't throw when exceptions are disabled, e.g. with
+		 * -fno-exceptions, unless Args or Visitors not in this library
+		 * do.
+		 * \param argc - Number of arguments.
+		 * \param argv - Array of arguments.
+		 * \param result - Where the outcome is recorded, cleared first.
+		 */
+		bool tryParse(int argc, const char * const * argv,
+		              ParseResult& result) const;
+
+		/**
+		 * Parses the command line into a result without handling or
+		 * throwing an ArgException, or exiting.  See above.
+		 * \param args - A vector of strings representing the args.
+		 * args[0] is still the program name.
+		 * \param result - Where the outcome is recorded, cleared first.
+		 */
+		bool tryParse(const std::vector<std::string>& args,
+		              ParseResult& result) const;
+
+		/**
+		 * Parses a command line given as one string, e.g. a line of a
+		 * job file, split into words as sh would do it, see
+		 * ShellTokenizer.  The first word is the program name.  The
+		 * string is copied once into a buffer that the next command
+		 * reuses, the words aren't copied.  An unterminated quote is an
+		 * error.
+		 * \param command - The command line.
+		 */
+		void parseCommand(const std::string& command);
+
+		/**
+		 * Parses a command line given as one string into a result, see
+		 * above and parse(int, const char * const *, ParseResult&).  The
+		 * buffer belongs to the result.
+		 * \param command - The command line.
+		 * \param result - Where the outcome is recorded, cleared first.
+		 */
+		void parseCommand(const std::string& command,
+		                  ParseResult& result) const;
+
+		/**
+		 * Parses a command line given as one string into a result like
+		 * tryParse() does, see above.
+		 * \param command - The command line.
+		 * \param result - Where the outcome is recorded, cleared first.
+		 */
+		bool tryParseCommand(const std::string& command,
+		                     ParseResult& result) const;
+
 		/**
 		 *
 		 */
@@ -300,6 +756,9 @@ private:
 
 		/**
 		 * Disables or enables CmdLine's internal parsing exception handling.
+		 * When exceptions are disabled, e.g. with -fno-exceptions, an
+		 * error that isn't handled aborts the program, use tryParse()
+		 * instead.
 		 *
 		 * @param state Should CmdLine handle parsing exceptions internally?
 		 */
@@ -318,6 +777,12 @@ private:
 		 */
 		void reset();
 
+		/**
+		 * Returns a number that changes whenever Args are added or
+		 * removed.  StdOutput keeps the usage it rendered until then.
+		 */
+		unsigned long getRevision();
+
 		/**
 		 * Allows unmatched args to be ignored. By default false.
 		 * 
@@ -325,6 +790,91 @@ private:
 		 * and if false it will behave as normal.
 		 */
 		void ignoreUnmatched(const bool ignore);
+
+		/**
+		 * Makes each argument of the form "@file" stand for the arguments
+		 * read from the file, e.g. to pass more arguments than the
+		 * system allows on a command line.  Response files can name
+		 * other response files.  By default "@file" is an ordinary
+		 * argument.
+		 * \param format - How the arguments in the files are separated,
+		 * ResponseFile::NONE to not expand "@file" arguments.
+		 */
+		void setResponseFiles(ResponseFile::Format format);
+
+		ResponseFile::Format getResponseFiles() const;
+
+		/**
+		 * Limits the number of bytes read from response files for one
+		 * command line, 256 MiB by default.
+		 * \param maxSize - The limit in bytes.
+		 */
+		void setResponseFileLimit(std::size_t maxSize);
+
+		std::size_t getResponseFileLimit() const;
+
+		/**
+		 * Makes the parse keep the values given for ValueArgs and
+		 * MultiArgs as they were given, converting and checking them
+		 * against their constraints only when getValue() first reads
+		 * them.  A program that reads few of its arguments, or that
+		 * exits for --help or --version, then doesn't convert the rest.
+		 * An invalid value is reported by getValue() throwing an
+		 * ArgException rather than by the parse, unless validateAll() is
+		 * called.  By default values are converted as they are parsed.
+		 * \param lazy - Whether to convert the values when they are read.
+		 */
+		void setLazyConversion(bool lazy);
+
+		bool getLazyConversion() const;
+
+		/**
+		 * Makes the parse answer a first argument of "--__complete
+		 * <index> <words...>" by printing the candidates for the word
+		 * at index of the command line in words and exiting, as it does
+		 * for --help, see Completion.  A completion script of a shell
+		 * can then ask the program itself, e.g. for values that change.
+		 * Off by default, "--__complete" is then parsed like any other
+		 * argument.
+		 * \param completion - Whether "--__complete" is answered.
+		 */
+		void setCompletion(bool completion);
+
+		bool getCompletion() const;
+
+		/**
+		 * Prints the candidates for a word of a command line to os, one
+		 * per line, as "--__complete" does.
+		 * \param words - The command line, starting with the program name.
+		 * \param index - The index of the word in words, words.size()
+		 * for a word that hasn't been started.
+		 * \param os - Where the candidates are printed.
+		 */
+		void complete(const std::vector<std::string>& words,
+		              std::size_t index, std::ostream& os) const;
+
+		/**
+		 * Converts and checks the values stored in the Args that haven't
+		 * been yet, see setLazyConversion(), so that an invalid one is
+		 * reported now.  Errors are handled as for parse(), see
+		 * setExceptionHandling().
+		 */
+		void validateAll();
+
+		/**
+		 * Converts and checks the values recorded in a result that
+		 * haven't been yet.  Errors are handled as for parse().
+		 * \param result - The outcome of the parse.
+		 */
+		void validateAll(const ParseResult& result) const;
+
+		/**
+		 * Converts and checks the values recorded in a result that
+		 * haven't been yet, recording an error in the result like
+		 * tryParse() does.  Returns whether all the values were valid.
+		 * \param result - The outcome of the parse.
+		 */
+		bool tryValidateAll(ParseResult& result) const;
 };
 
 
@@ -338,19 +888,42 @@ inline CmdLine::CmdLine(const std::string& m,
                         bool help )
     :
   _argList(std::list<Arg*>()),
+  _argIndex(std::map<std::string, Arg*>()),
+  _unlabeledList(std::list<Arg*>()),
+  _flagTable(),
+  _flagOrder(),
+  _repeatableArgs(std::set<const Arg*>()),
+  _argNames(std::set<std::string>()),
+  _argTable(std::vector<Arg*>()),
+  _stateIndices(std::map<const Arg*, std::size_t>()),
   _progName("not_set_yet"),
   _message(m),
   _version(v),
   _numRequired(0),
+  _revision(0),
   _delimiter(delim),
   _xorHandler(XorHandler()),
   _argDeleteOnExitList(std::list<Arg*>()),
   _visitorDeleteOnExitList(std::list<Visitor*>()),
   _output(0),
   _handleExceptions(true),
-  _userSetOutput(false),
+  _argsResult(),
   _helpAndVersion(help),
-  _ignoreUnmatched(false)
+  _ignoreUnmatched(false),
+  _responseFiles(ResponseFile::NONE),
+  _responseFileLimit(static_cast<std::size_t>(256) << 20),
+  _lazyConversion(false),
+  _completion(false),
+  _stdOutput(),
+  _helpVisitor( this, &_output ),
+  _helpArg( "h", "help", "Displays usage information and exits.",
+            false, &_helpVisitor ),
+  _versionVisitor( this, &_output ),
+  _versionArg( "", "version", "Displays version information and exits.",
+               false, &_versionVisitor ),
+  _ignoreRestArg( Arg::flagStartString(), Arg::ignoreNameString(),
+          "Ignores the rest of the labeled arguments following this flag.",
+                  false )
 {
 	_constructor();
 }
@@ -359,48 +932,19 @@ inline CmdLine::~CmdLine()
 {
 	ClearContainer(_argDeleteOnExitList);
 	ClearContainer(_visitorDeleteOnExitList);
-
-	if ( !_userSetOutput ) {
-		delete _output;
-		_output = 0;
-	}
 }
 
 inline void CmdLine::_constructor()
 {
-	_output = new StdOutput;
-
-	Arg::setDelimiter( _delimiter );
-
-	Visitor* v;
+	_output = &_stdOutput;
 
 	if ( _helpAndVersion )
 	{
-		v = new HelpVisitor( this, &_output );
-		SwitchArg* help = new SwitchArg("h","help",
-		                      "Displays usage information and exits.",
-		                      false, v);
-		add( help );
-		deleteOnExit(help);
-		deleteOnExit(v);
-
-		v = new VersionVisitor( this, &_output );
-		SwitchArg* vers = new SwitchArg("","version",
-		                      "Displays version information and exits.",
-		                      false, v);
-		add( vers );
-		deleteOnExit(vers);
-		deleteOnExit(v);
-	}
-
-	v = new IgnoreRestVisitor();
-	SwitchArg* ignore  = new SwitchArg(Arg::flagStartString(),
-	          Arg::ignoreNameString(),
-	          "Ignores the rest of the labeled arguments following this flag.",
-	          false, v);
-	add( ignore );
-	deleteOnExit(ignore);
-	deleteOnExit(v);
+		add( _helpArg );
+		add( _versionArg );
+	}
+
+	add( _ignoreRestArg );
 }
 
 inline void CmdLine::xorAdd( const std::vector<Arg*>& ors )
@@ -430,89 +974,307 @@ inline void CmdLine::add( Arg& a )
 
 inline void CmdLine::add( Arg* a )
 {
-	for( ArgListIterator it = _argList.begin(); it != _argList.end(); it++ )
-		if ( *a == *(*it) )
-			throw( SpecificationException(
-			        "Argument with same flag/name already exists!",
-			        a->longID() ) );
-
+	a->setValueDelimiter( _delimiter );
 	a->addToList( _argList );
 
+	// Labeled args are pushed to the front of the list, unlabeled args
+	// to the back.
+	const bool labeled = _argList.front() == a;
+
+	if ( !labeled && _optionalUnlabeled() )
+	{
+		_argList.pop_back();
+
+		TCLAP_THROW( SpecificationException(
+	"You can't specify ANY Unlabeled Arg following an optional Unlabeled Arg",
+		        a->toString() ) );
+	}
+
+	if ( labeled ? _labeledDuplicate( a ) : _unlabeledDuplicate( a ) )
+	{
+		if ( labeled )
+			_argList.pop_front();
+		else
+			_argList.pop_back();
+
+		TCLAP_THROW( SpecificationException(
+		        "Argument with same flag/name already exists!",
+		        a->longID() ) );
+	}
+
+	_index( a, labeled );
+}
+
+inline void CmdLine::add( const std::vector<Arg*>& args )
+{
+	std::size_t k = 0;
+#if TCLAP_HAS_EXCEPTIONS
+	try {
+		for ( ; k < args.size(); k++ )
+			add( args[k] );
+	} catch ( SpecificationException& ) {
+		// take back the ones that were added
+		while ( k > 0 )
+			_remove( args[--k] );
+
+		throw;
+	}
+#else
+	for ( ; k < args.size(); k++ )
+		add( args[k] );
+#endif
+}
+
+inline bool CmdLine::_labeledDuplicate(const Arg* a) const
+{
+	// the same as comparing with Arg::operator== against each Arg
+	const std::string& flag = a->getFlag();
+	if ( !flag.empty() &&
+	     _flagTable[static_cast<unsigned char>(flag[0])] != NULL )
+		return true;
+
+	return _argNames.find( a->getName() ) != _argNames.end();
+}
+
+inline bool CmdLine::_unlabeledDuplicate(const Arg* a) const
+{
+	// unlabeled Args have their own operator==, there are few of them
+	for ( ArgListIterator it = _argList.begin(); it != _argList.end(); it++ )
+		if ( *it != a && *a == *(*it) )
+			return true;
+
+	return false;
+}
+
+inline bool CmdLine::_optionalUnlabeled() const
+{
+	// an unlabeled multi arg takes all that follows, but doesn't count
+	for ( ArgListIterator it = _unlabeledList.begin();
+	      it != _unlabeledList.end(); it++ )
+		if ( !(*it)->isRequired() && !(*it)->acceptsMultipleValues() )
+			return true;
+
+	return false;
+}
+
+inline void CmdLine::_index( Arg* a, bool labeled )
+{
+	_revision++;
+	_argNames.insert( a->getName() );
+
+	_stateIndices[a] = _argTable.size();
+	_argTable.push_back( a );
+
+	// Only labeled args can be found by their flag/name.
+	if ( labeled )
+	{
+		if ( a->getFlag() != "" )
+		{
+			const unsigned char c = a->getFlag()[0];
+			_argIndex[Arg::flagStartString() + a->getFlag()] = a;
+			_flagTable[c] = a;
+			_flagOrder[c] = _argList.size();
+		}
+
+		_argIndex[Arg::nameStartString() + a->getName()] = a;
+
+		if ( a->isRepeatable() )
+			_repeatableArgs.insert( a );
+	}
+	else
+		_unlabeledList.push_back( a );
+
 	if ( a->isRequired() )
 		_numRequired++;
 }
 
+inline void CmdLine::_remove( Arg* a )
+{
+	_revision++;
+	_argList.remove( a );
+	_argNames.erase( a->getName() );
+
+	// Args are taken back in the reverse order of adding them
+	if ( !_argTable.empty() && _argTable.back() == a )
+		_argTable.pop_back();
+	_stateIndices.erase( a );
+
+	if ( a->getFlag() != "" && _argIndex.erase( Arg::flagStartString() +
+	                                            a->getFlag() ) > 0 )
+		_flagTable[static_cast<unsigned char>(a->getFlag()[0])] = NULL;
+
+	if ( _argIndex.erase( Arg::nameStartString() + a->getName() ) == 0 )
+		_unlabeledList.remove( a );
+	_repeatableArgs.erase( a );
+
+	if ( a->isRequired() )
+		_numRequired--;
+}
+
 
 inline void CmdLine::parse(int argc, const char * const * argv)
 {
-		// this step is necessary so that we have easy access to
-		// mutable strings.
-		std::vector<std::string> args;
-		for (int i = 0; i < argc; i++)
-			args.push_back(argv[i]);
+	if ( argc > 0 )
+		_progName = argv[0];
 
-		parse(args);
+	// the tokens refer to argv directly
+	ArgTokenList tokens( argc > 0 ? argc - 1 : 0, argc > 0 ? argv + 1 : argv );
+	_parseIntoArgs( argc > 0, tokens );
 }
 
 inline void CmdLine::parse(std::vector<std::string>& args)
 {
-	bool shouldExit = false;
-	int estat = 0;
-	try {
-        if (args.empty()) {
-            // https://sourceforge.net/p/tclap/bugs/30/
-            throw CmdLineParseException("The args vector must not be empty, "
-                                        "the first entry should contain the "
-                                        "program's name.");
-        }
-
+	const bool hasProgName = !args.empty();
+	if ( hasProgName )
+	{
 		_progName = args.front();
 		args.erase(args.begin());
+	}
 
-		int requiredCount = 0;
+	ArgTokenList tokens( args );
+	_parseIntoArgs( hasProgName, tokens );
+}
 
-		for (int i = 0; static_cast<unsigned int>(i) < args.size(); i++) 
-		{
-			bool matched = false;
-			for (ArgListIterator it = _argList.begin();
-			     it != _argList.end(); it++) {
-				if ( (*it)->processArg( &i, args ) )
-				{
-					requiredCount += _xorHandler.check( *it );
-					matched = true;
-					break;
-				}
-			}
+inline void CmdLine::parse(int argc, const char * const * argv,
+                           ParseResult& result) const
+{
+	result.clear();
+	if ( argc > 0 )
+		result.setProgramName( argv[0] );
 
-			// checks to see if the argument is an empty combined
-			// switch and if so, then we've actually matched it
-			if ( !matched && _emptyCombined( args[i] ) )
-				matched = true;
+	ArgTokenList tokens( argc > 0 ? argc - 1 : 0, argc > 0 ? argv + 1 : argv );
+	_parse( argc > 0, tokens, result );
+}
 
-			if ( !matched && !Arg::ignoreRest() && !_ignoreUnmatched)
-				throw(CmdLineParseException("Couldn't find match "
-				                            "for argument",
-				                            args[i]));
-		}
+inline void CmdLine::parse(const std::vector<std::string>& args,
+                           ParseResult& result) const
+{
+	result.clear();
+	if ( !args.empty() )
+		result.setProgramName( args.front() );
+
+	ArgTokenList tokens( args, 1 );
+	_parse( !args.empty(), tokens, result );
+}
+
+inline bool CmdLine::tryParse(int argc, const char * const * argv,
+                              ParseResult& result) const
+{
+	result.clear();
+	if ( argc > 0 )
+		result.setProgramName( argv[0] );
+
+	ArgTokenList tokens( argc > 0 ? argc - 1 : 0, argc > 0 ? argv + 1 : argv );
+	return _tryParse( argc > 0, tokens, result );
+}
+
+inline bool CmdLine::tryParse(const std::vector<std::string>& args,
+                              ParseResult& result) const
+{
+	result.clear();
+	if ( !args.empty() )
+		result.setProgramName( args.front() );
+
+	ArgTokenList tokens( args, 1 );
+	return _tryParse( !args.empty(), tokens, result );
+}
+
+inline void CmdLine::parseCommand(const std::string& command)
+{
+	ShellTokenizer& words = _argsResult.getTokenizer();
+	words.tokenize( command );
+	if ( words.size() > 0 )
+		_progName = words.word( 0 );
+
+	ArgTokenList tokens( words, 1 );
+	_parseIntoArgs( words.size() > 0, tokens );
+}
+
+inline void CmdLine::parseCommand(const std::string& command,
+                                  ParseResult& result) const
+{
+	result.clear();
+	ShellTokenizer& words = result.getTokenizer();
+	words.tokenize( command );
+	if ( words.size() > 0 )
+		result.setProgramName( words.word( 0 ) );
+
+	ArgTokenList tokens( words, 1 );
+	_parse( words.size() > 0, tokens, result );
+}
+
+inline bool CmdLine::tryParseCommand(const std::string& command,
+                                     ParseResult& result) const
+{
+	result.clear();
+	ShellTokenizer& words = result.getTokenizer();
+	words.tokenize( command );
+	if ( words.size() > 0 )
+		result.setProgramName( words.word( 0 ) );
+
+	ArgTokenList tokens( words, 1 );
+	return _tryParse( words.size() > 0, tokens, result );
+}
+
+inline void CmdLine::_parseIntoArgs(bool hasProgName, ArgTokenList& tokens)
+{
+	// an Arg set by an earlier parse can't be set again without reset()
+	_argsResult.clear();
+	_argsResult.setContinuesArgs( true );
+
+#if TCLAP_HAS_EXCEPTIONS
+	try {
+		_parse( hasProgName, tokens, _argsResult );
+	} catch ( ... ) {
+		// the Args keep what was parsed before the error
+		_store( _argsResult );
+		throw;
+	}
+#else
+	_parse( hasProgName, tokens, _argsResult );
+#endif
 
-		if ( requiredCount < _numRequired )
-			missingArgsException();
+	_store( _argsResult );
+}
+
+inline void CmdLine::_store(ParseResult& result)
+{
+	const std::vector<std::size_t>& matched = result.getMatched();
+	for ( std::size_t k = 0; k < matched.size(); k++ )
+		_argTable[matched[k]]->storeResult( result );
 
-		if ( requiredCount > _numRequired )
-			throw(CmdLineParseException("Too many arguments!"));
+	// the other Args of an xor list count as set too
+	const std::vector< std::vector<Arg*> >& xors = _xorHandler.getXorList();
+	for ( std::size_t group = 0; group < xors.size(); group++ )
+	{
+		const Arg* set = result.getXorSet( static_cast<int>(group) );
+		if ( set == NULL )
+			continue;
+
+		for ( ArgVectorIterator it = xors[group].begin();
+		      it != xors[group].end(); it++ )
+			if ( *it != set )
+				(*it)->xorSet();
+	}
+}
 
+inline void CmdLine::_parse(bool hasProgName, ArgTokenList& tokens,
+                            ParseResult& result) const
+{
+	bool shouldExit = false;
+	int estat = 0;
+#if TCLAP_HAS_EXCEPTIONS
+	// the Args of this library record errors in the result, others and
+	// Visitors may still throw
+	try {
+		_parseTokens( hasProgName, tokens, result );
 	} catch ( ArgException& e ) {
 		// If we're not handling the exceptions, rethrow.
 		if ( !_handleExceptions) {
 			throw;
 		}
 
-		try {
-			_output->failure(*this,e);
-		} catch ( ExitException &ee ) {
-			estat = ee.getExitStatus();
-			shouldExit = true;
-		}
+		shouldExit = _failure( e, estat );
 	} catch (ExitException &ee) {
 		// If we're not handling the exceptions, rethrow.
 		if ( !_handleExceptions) {
@@ -522,48 +1284,445 @@ inline void CmdLine::parse(std::vector<std::string>& args)
 		estat = ee.getExitStatus();
 		shouldExit = true;
 	}
+#else
+	_parseTokens( hasProgName, tokens, result );
+#endif
+
+	if ( result.hasStopped() )
+		shouldExit = _stopped( result, estat );
 
 	if (shouldExit)
 		exit(estat);
 }
 
-inline bool CmdLine::_emptyCombined(const std::string& s)
+inline bool CmdLine::_stopped(const ParseResult& result, int& estat) const
 {
-	if ( s.length() > 0 && s[0] != Arg::flagStartChar() )
-		return false;
+	// If we're not handling the exceptions, throw what the parse found.
+	if ( !_handleExceptions )
+		result.throwError();
 
-	for ( int i = 1; static_cast<unsigned int>(i) < s.length(); i++ )
-		if ( s[i] != Arg::blankChar() )
-			return false;
+	if ( result.exitRequested() )
+	{
+		estat = result.getExitStatus();
+		return true;
+	}
 
-	return true;
+	// the output is given the exception the parse would have thrown
+	if ( result.isValueError() )
+	{
+		ArgParseException e( result.getError(), result.getErrorId() );
+		return _failure( e, estat );
+	}
+	else
+	{
+		CmdLineParseException e( result.getError(), result.getErrorId() );
+		return _failure( e, estat );
+	}
+}
+
+inline bool CmdLine::_failure(ArgException& e, int& estat) const
+{
+	// the output only reads the CmdLine
+#if TCLAP_HAS_EXCEPTIONS
+	try {
+		_output->failure(const_cast<CmdLine&>(*this),e);
+	} catch ( ExitException &ee ) {
+		estat = ee.getExitStatus();
+		return true;
+	}
+#else
+	// the output exits itself
+	static_cast<void>(estat); // Ignore input, don't warn
+	_output->failure(const_cast<CmdLine&>(*this),e);
+#endif
+
+	return false;
+}
+
+inline bool CmdLine::_tryParse(bool hasProgName, ArgTokenList& tokens,
+                               ParseResult& result) const
+{
+#if TCLAP_HAS_EXCEPTIONS
+	try {
+		_parseTokens( hasProgName, tokens, result );
+	} catch ( ArgException& e ) {
+		// thrown by an Arg that only implements processArg()
+		result.setError( e.error(), e.argId() );
+	}
+#else
+	_parseTokens( hasProgName, tokens, result );
+#endif
+
+	return !result.hasStopped();
+}
+
+inline void CmdLine::_parseTokens(bool hasProgName, ArgTokenList& tokens,
+                                  ParseResult& result) const
+{
+	// the result finds the Args by the indices of this CmdLine
+	result.setStateIndices( &_stateIndices );
+	result.setXorGroups( &_xorHandler.getXorGroups() );
+
+	// the words before the quote aren't parsed either
+	if ( !tokens.complete() )
+	{
+		result.setError( ParseResult::UNTERMINATED_QUOTE );
+		result.setErrorToken( hasProgName
+		                      ? static_cast<int>(tokens.size()) + 1 : 0 );
+		return;
+	}
+
+	if (!hasProgName) {
+	    // https://sourceforge.net/p/tclap/bugs/30/
+	    result.setError( ParseResult::NO_PROGRAM_NAME );
+	    return;
+	}
+
+#ifdef TCLAP_GENERATE
+	// a build that generates the documentation doesn't parse
+	_generate( tokens, result );
+	return;
+#endif
+
+	// the hidden argument a completion script runs the program with
+	if ( _completion && tokens.size() > 0 &&
+	     Completion::isRequest( tokens[0].c_str() ) )
+	{
+		_complete( tokens, result );
+		return;
+	}
+
+	if ( !tokens.expandResponseFiles( _responseFiles, _responseFileLimit ) )
+	{
+		result.setResponseFileError( tokens.error(), tokens.errorPath() );
+		result.setErrorToken( static_cast<int>(tokens.errorIndex()) + 1 );
+		return;
+	}
+	result.setConvertsLazily( _lazyConversion );
+
+	// classify each argument once, the Args only look at the tokens
+	for (unsigned int i = 0; i < tokens.size(); i++)
+		Arg::classifyToken( tokens[i], _delimiter );
+
+	int requiredCount = 0;
+	std::string id;
+
+	if ( !_repeatableArgs.empty() )
+		_countOccurrences( tokens, id, result );
+
+	for (int i = 0; static_cast<unsigned int>(i) < tokens.size(); i++) 
+	{
+		requiredCount += _parseToken( tokens, &i, id, result );
+		if ( result.hasStopped() )
+			return;
+	}
+
+	_checkRequired( requiredCount, result );
 }
 
-inline void CmdLine::missingArgsException()
+inline int CmdLine::_parseToken(ArgTokenList& tokens, int* i,
+                                std::string& id, ParseResult& result) const
 {
-		int count = 0;
+	int requiredCount = 0;
+	const int first = *i;
+	bool matched = false;
 
-		std::string missingArgList;
-		for (ArgListIterator it = _argList.begin(); it != _argList.end(); it++)
+	// the common case: the flag/name identifies exactly one Arg
+	Arg* labeled = _findLabeled( tokens[*i], id );
+	if ( labeled != NULL )
+	{
+		const bool wasSet = labeled->isSet( result );
+		if ( _processToken( labeled, i, tokens, result ) )
 		{
-			if ( (*it)->isRequired() && !(*it)->isSet() )
+			if ( !result.hasStopped() )
+				requiredCount += _matched( labeled, wasSet, result );
+			matched = true;
+		}
+	}
+
+	// combined switches are decoded in a single pass
+	if ( !matched && tokens[*i].kind() == ArgToken::COMBINED )
+	{
+		requiredCount += _processCombined( tokens[*i], result );
+		matched = _emptyCombined( tokens[*i] );
+	}
+
+	// otherwise offer the argument to each Arg in turn. Positional
+	// arguments can only match unlabeled Args.
+	if ( !matched && !result.hasStopped() )
+	{
+		const std::list<Arg*>& candidates =
+			tokens[*i].kind() == ArgToken::POSITIONAL
+			? _unlabeledList : _argList;
+
+		for (ArgListIterator it = candidates.begin();
+		     it != candidates.end(); it++) {
+			const bool wasSet = (*it)->isSet( result );
+			if ( _processToken( *it, i, tokens, result ) )
 			{
-				missingArgList += (*it)->getName();
-				missingArgList += ", ";
-				count++;
+				if ( !result.hasStopped() )
+					requiredCount += _matched( *it, wasSet, result );
+				matched = true;
+				break;
 			}
 		}
-		missingArgList = missingArgList.substr(0,missingArgList.length()-2);
+	}
 
-		std::string msg;
-		if ( count > 1 )
-			msg = "Required arguments missing: ";
-		else
-			msg = "Required argument missing: ";
+	// the argument was invalid, or --help or --version was given
+	if ( result.hasStopped() )
+	{
+		if ( result.hasError() )
+			result.setErrorToken( first + 1 );
+		return requiredCount;
+	}
+
+	// checks to see if the argument is an empty combined
+	// switch and if so, then we've actually matched it
+	if ( !matched && _emptyCombined( tokens[*i] ) )
+		matched = true;
+
+	if ( !matched && !result.ignoreRest() && !_ignoreUnmatched)
+	{
+		result.setError( ParseResult::UNMATCHED_ARGUMENT, NULL,
+		                 tokens[*i].c_str(), tokens[*i].length() );
+		result.setErrorToken( *i + 1 );
+	}
+
+	return requiredCount;
+}
+
+inline void CmdLine::_complete(const ArgTokenList& tokens,
+                               ParseResult& result) const
+{
+	// the words of the command line start with its program name
+	std::vector<std::string> words;
+	for ( std::size_t i = 2; i < tokens.size(); i++ )
+		words.push_back( std::string( tokens[i].c_str(), tokens[i].length() ) );
+
+	const std::size_t index = tokens.size() > 1
+		? static_cast<std::size_t>(strtoul( tokens[1].c_str(), NULL, 10 ))
+		: 0;
+
+	complete( words, index, std::cout );
+	std::cout.flush();
+	result.requestExit( 0 );
+}
+
+#ifdef TCLAP_GENERATE
+inline void CmdLine::_generate(const ArgTokenList& tokens,
+                               ParseResult& result) const
+{
+	if ( tokens.size() != 1 )
+	{
+		std::cerr << "usage: " << _progName << " <prefix>" << std::endl;
+		result.requestExit( 1 );
+		return;
+	}
+
+	const std::string prefix( tokens[0].c_str(), tokens[0].length() );
 
-		msg += missingArgList;
+	// the outputs take the CmdLine as it is, so it is named after the
+	// program the documentation is for
+	CmdLine& cmd = const_cast<CmdLine&>( *this );
+	const std::string::size_type p = prefix.find_last_of('/');
+	cmd._progName = p == std::string::npos ? prefix : prefix.substr( p + 1 );
 
-		throw(CmdLineParseException(msg));
+	std::string error;
+	if ( !DocGenerator::generate( cmd, prefix, error ) )
+	{
+		std::cerr << error << std::endl;
+		result.requestExit( 1 );
+		return;
+	}
+
+	result.requestExit( 0 );
+}
+#endif
+
+inline void CmdLine::_checkRequired(int requiredCount,
+                                    ParseResult& result) const
+{
+	if ( requiredCount < _numRequired )
+		_missingArgs( result, result );
+	else if ( requiredCount > _numRequired )
+		result.setError( ParseResult::TOO_MANY_ARGUMENTS );
+}
+
+inline bool CmdLine::_emptyCombined(const ArgToken& token) const
+{
+	if ( token.kind() == ArgToken::COMBINED )
+		return token.consumed() == token.labelLength();
+
+	// nothing but the flag start char, or nothing at all
+	return token.length() == 0 ||
+	       ( token.length() == 1 && token.c_str()[0] == Arg::flagStartChar() );
+}
+
+inline int CmdLine::_processCombined(ArgToken& token,
+                                     ParseResult& result) const
+{
+	const unsigned char* label =
+		reinterpret_cast<const unsigned char*>(token.label());
+	const std::size_t length = token.labelLength();
+
+	std::size_t counts[256] = { 0 };
+	for ( std::size_t k = 0; k < length; k++ )
+		counts[label[k]]++;
+
+	// each Arg handles all occurrences of its flag at once, in the order
+	// of _argList, i.e. the Arg added last first, as conflicts have
+	// always been reported in this order
+	unsigned char flags[256];
+	std::size_t numFlags = 0;
+	for ( std::size_t k = 0; k < length; k++ )
+	{
+		const unsigned char c = label[k];
+
+		// the flag of "--" is the flag start char, it can't be combined
+		if ( _flagTable[c] == NULL ||
+		     c == static_cast<unsigned char>(Arg::flagStartChar()) )
+			continue;
+
+		std::size_t f = 0;
+		while ( f < numFlags && flags[f] != c )
+			f++;
+		if ( f < numFlags )
+			continue;
+
+		for ( f = numFlags++; f > 0 && _flagOrder[flags[f - 1]] < _flagOrder[c];
+		      f-- )
+			flags[f] = flags[f - 1];
+		flags[f] = c;
+	}
+
+	// all flags are checked before any of them is handled, so that no
+	// Visitor is checked for a token that is in error
+	for ( std::size_t f = 0; f < numFlags; f++ )
+	{
+		const Arg* a = _flagTable[flags[f]];
+		if ( a->parsesTokens() )
+			a->checkCombinedFlag( counts[flags[f]], result );
+
+		if ( result.hasStopped() )
+			return 0;
+	}
+
+	unsigned char matched[256];
+	bool wasSet[256];
+	std::size_t numMatched = 0;
+	for ( std::size_t f = 0; f < numFlags; f++ )
+	{
+		const unsigned char c = flags[f];
+		const bool set = _flagTable[c]->isSet( result );
+		if ( _processCombinedFlag( _flagTable[c], static_cast<char>(c),
+		                           counts[c], result ) )
+		{
+			if ( result.hasStopped() )
+				return 0;
+
+			token.consume( counts[c] );
+			matched[numMatched] = c;
+			wasSet[numMatched++] = set;
+		}
+	}
+
+	// the exclusions are checked once all flags have been handled, so
+	// that conflicts are reported independent of the order of the flags
+	int requiredCount = 0;
+	for ( std::size_t m = 0; m < numMatched && !result.hasStopped(); m++ )
+		requiredCount += _matched( _flagTable[matched[m]], wasSet[m], result );
+
+	return requiredCount;
+}
+
+inline bool CmdLine::_processToken(const Arg* a, int* i,
+                                   ArgTokenList& tokens,
+                                   ParseResult& result) const
+{
+	if ( a->parsesTokens() )
+		return a->processToken( i, tokens, result );
+	else
+		return a->Arg::processToken( i, tokens, result );
+}
+
+inline bool CmdLine::_processCombinedFlag(const Arg* a, char flag,
+                                          std::size_t count,
+                                          ParseResult& result) const
+{
+	if ( a->parsesTokens() )
+		return a->processCombinedFlag( count, result );
+
+	std::vector<std::string> args( 1, Arg::flagStartString() + flag );
+	ArgTokenList tokens( args );
+	Arg::classifyToken( tokens[0], _delimiter );
+
+	bool matched = false;
+	for ( std::size_t k = 0; k < count && !result.hasStopped(); k++ )
+	{
+		int i = 0;
+		if ( a->Arg::processToken( &i, tokens, result ) )
+			matched = true;
+	}
+
+	return matched;
+}
+
+inline int CmdLine::_matched(const Arg* a, bool wasSet,
+                             ParseResult& result) const
+{
+	if ( a == &_ignoreRestArg )
+		result.beginIgnoring();
+
+	// an Arg counts once, however often it is matched
+	if ( wasSet )
+		return 0;
+
+	return _xorHandler.check( a, result );
+}
+
+inline void CmdLine::_countOccurrences(const ArgTokenList& tokens,
+                                       std::string& id,
+                                       ParseResult& result) const
+{
+	for ( std::size_t i = 0; i < tokens.size(); i++ )
+	{
+		const Arg* a = _findLabeled( tokens[i], id );
+		if ( a != NULL && a->isRepeatable() )
+			result.addOccurrence( result.getStateIndex( a ) );
+	}
+}
+
+inline Arg* CmdLine::_findLabeled(const ArgToken& token,
+                                  std::string& id) const
+{
+	if ( token.kind() != ArgToken::FLAG && token.kind() != ArgToken::NAME &&
+	     token.kind() != ArgToken::IGNORE_REST )
+		return NULL;
+
+	token.id( id );
+	std::map<std::string, Arg*>::const_iterator it = _argIndex.find( id );
+
+	if ( it != _argIndex.end() )
+		return it->second;
+	else
+		return NULL;
+}
+
+inline void CmdLine::missingArgsException(const ParseResult& result) const
+{
+	ParseResult errors;
+	_missingArgs( result, errors );
+	errors.throwError();
+}
+
+inline void CmdLine::_missingArgs(const ParseResult& result,
+                                  ParseResult& errors) const
+{
+	// the names are only put together if the message is asked for
+	errors.setError( ParseResult::MISSING_REQUIRED );
+	for (ArgListIterator it = _argList.begin(); it != _argList.end(); it++)
+		if ( (*it)->isRequired() && !(*it)->isSet( result ) )
+			errors.addMissing( *it );
 }
 
 inline void CmdLine::deleteOnExit(Arg* ptr)
@@ -583,9 +1742,6 @@ inline CmdLineOutput* CmdLine::getOutput()
 
 inline void CmdLine::setOutput(CmdLineOutput* co)
 {
-	if ( !_userSetOutput )
-		delete _output;
-	_userSetOutput = true;
 	_output = co;
 }
 
@@ -634,6 +1790,11 @@ inline bool CmdLine::getExceptionHandling() const
 	return _handleExceptions;
 }
 
+inline unsigned long CmdLine::getRevision()
+{
+	return _revision;
+}
+
 inline void CmdLine::reset()
 {
 	for( ArgListIterator it = _argList.begin(); it != _argList.end(); it++ )
@@ -647,6 +1808,120 @@ inline void CmdLine::ignoreUnmatched(const bool ignore)
 	_ignoreUnmatched = ignore;
 }
 
+inline void CmdLine::setResponseFiles(ResponseFile::Format format)
+{
+	_responseFiles = format;
+}
+
+inline ResponseFile::Format CmdLine::getResponseFiles() const
+{
+	return _responseFiles;
+}
+
+inline void CmdLine::setResponseFileLimit(std::size_t maxSize)
+{
+	_responseFileLimit = maxSize;
+}
+
+inline std::size_t CmdLine::getResponseFileLimit() const
+{
+	return _responseFileLimit;
+}
+
+inline void CmdLine::setLazyConversion(bool lazy)
+{
+	_lazyConversion = lazy;
+}
+
+inline bool CmdLine::getLazyConversion() const
+{
+	return _lazyConversion;
+}
+
+inline void CmdLine::setCompletion(bool completion)
+{
+	_completion = completion;
+}
+
+inline bool CmdLine::getCompletion() const
+{
+	return _completion;
+}
+
+inline void CmdLine::complete(const std::vector<std::string>& words,
+                              std::size_t index, std::ostream& os) const
+{
+	// the index of the labeled Args is the one the parse uses
+	Completion::complete( _argIndex, _unlabeledList, _xorHandler, _delimiter,
+	                      words, index, os );
+}
+
+inline void CmdLine::validateAll()
+{
+	_validateAll( NULL );
+}
+
+inline void CmdLine::validateAll(const ParseResult& result) const
+{
+	_validateAll( &result );
+}
+
+inline bool CmdLine::tryValidateAll(ParseResult& result) const
+{
+#if TCLAP_HAS_EXCEPTIONS
+	try {
+		return _tryValidateArgs( result );
+	} catch ( ArgException& e ) {
+		// thrown by an Arg that only implements validate()
+		result.setError( e.error(), e.argId() );
+		return false;
+	}
+#else
+	return _tryValidateArgs( result );
+#endif
+}
+
+inline bool CmdLine::_tryValidateArgs(ParseResult& result) const
+{
+	for (ArgListIterator it = _argList.begin(); it != _argList.end(); it++)
+		if ( !(*it)->tryValidate( result ) )
+			return false;
+
+	return true;
+}
+
+inline void CmdLine::_validateAll(const ParseResult* result) const
+{
+#if TCLAP_HAS_EXCEPTIONS
+	bool shouldExit = false;
+	int estat = 0;
+	try {
+		_validateArgs( result );
+	} catch ( ArgException& e ) {
+		if ( !_handleExceptions )
+			throw;
+
+		shouldExit = _failure( e, estat );
+	}
+
+	if ( shouldExit )
+		exit( estat );
+#else
+	_validateArgs( result );
+#endif
+}
+
+inline void CmdLine::_validateArgs(const ParseResult* result) const
+{
+	for (ArgListIterator it = _argList.begin(); it != _argList.end(); it++)
+	{
+		if ( result != NULL )
+			(*it)->validate( *result );
+		else
+			(*it)->validate();
+	}
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //End CmdLine.cpp
 ///////////////////////////////////////////////////////////////////////////////
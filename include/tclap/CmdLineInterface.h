@@ -145,6 +145,13 @@ class CmdLineInterface
 		 * instance can be reused. 
 		 */
 		virtual void reset()=0;
+
+		/**
+		 * Returns a number that changes whenever Args are added or
+		 * removed, so that an output can keep what it rendered until
+		 * then.  0 if the changes aren't counted.
+		 */
+		virtual unsigned long getRevision() { return 0; }
 };
 
 } //namespace
@@ -0,0 +1,580 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+/******************************************************************************
+ *
+ *  file:  Completion.h
+ *
+ *  Copyright (c) 2018, Google LLC
+ *  All rights reserved.
+ *
+ *  See the file COPYING in the top directory of this distribution for
+ *  more information.
+ *
+ *  THE SOFTWARE IS PROVIDED _AS IS_, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ *  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *  DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef TCLAP_COMPLETION_H
+#define TCLAP_COMPLETION_H
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <functional>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <ctime>
+
+#include <tclap/Arg.h>
+#include <tclap/XorHandler.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define TCLAP_GETPID
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#elif defined(_WIN32)
+#include <process.h>
+#include <direct.h>
+#endif
+
+namespace TCLAP {
+
+/**
+ * Gives the values an Arg can take when they aren't known in advance,
+ * e.g. the ids of the running jobs, for completing the Arg's value, see
+ * Arg::setCompletionProvider().  Since a shell runs the program each
+ * time a word is completed, the values can be kept in a cache file for
+ * a while so that repeated completions don't look them up again.
+ */
+class CompletionProvider
+{
+	public:
+
+		/**
+		 * \param cacheTime - How many seconds the values are kept in the
+		 * cache, 0 for not at all.
+		 */
+		CompletionProvider( int cacheTime = 0 ) : _cacheTime( cacheTime ) { }
+
+		virtual ~CompletionProvider() { }
+
+		/**
+		 * Adds the values the Arg can take to values.  A value can't
+		 * contain a newline.
+		 * \param values - Where the values are added.
+		 */
+		virtual void getValues( std::vector<std::string>& values ) = 0;
+
+		int getCacheTime() const { return _cacheTime; }
+
+	private:
+
+		int _cacheTime;
+};
+
+/**
+ * Answers the hidden "--__complete <index> <words...>" argument CmdLine
+ * handles like --help: it prints the candidates for the word at index
+ * of a command line, one per line, and the program exits without
+ * running the rest of main().  The words are the command line as the
+ * shell split it, starting with the program name, and index is
+ * words.size() for a word that hasn't been started.  Candidates are
+ * the flags and names of the Args that can still be given, found by
+ * their prefix in the sorted index of them, or the values of the Arg
+ * the word goes to: those of its CompletionProvider or those allowed by
+ * its constraint, e.g. a ValuesConstraint.
+ */
+class Completion
+{
+	public:
+
+		/**
+		 * Whether the argument asks for completion, i.e. is
+		 * "--__complete".
+		 * \param s - The first argument after the program name.
+		 */
+		static bool isRequest( const char* s )
+		{
+			return !std::strcmp( s, TCLAP_NAMESTARTSTRING "__complete" );
+		}
+
+		/**
+		 * The flags and names of the labeled Args, with their start
+		 * strings, sorted so that those with a prefix are found quickly.
+		 */
+		typedef std::map<std::string, Arg*> LabelIndex;
+
+		/**
+		 * Prints the candidates for a word of a command line to os, one
+		 * per line and sorted.
+		 * \param labels - The labeled Args of the CmdLine.
+		 * \param unlabeled - The unlabeled Args in their order.
+		 * \param xors - The xor lists of the CmdLine.
+		 * \param delimiter - The delimiter of the CmdLine.
+		 * \param words - The command line, starting with the program name.
+		 * \param index - The index of the word in words.
+		 * \param os - Where the candidates are printed.
+		 */
+		static void complete( const LabelIndex& labels,
+		                      const std::list<Arg*>& unlabeled,
+		                      const XorHandler& xors,
+		                      char delimiter,
+		                      const std::vector<std::string>& words,
+		                      std::size_t index, std::ostream& os );
+
+		/**
+		 * Adds the values a can take: those of its CompletionProvider,
+		 * read from the cache if they are recent enough, or those in
+		 * the description of its value, e.g. "a|b|c".
+		 * \param progName - The program name, which the cache file is
+		 * named after.
+		 * \param a - The Arg.
+		 * \param values - Where the values are added.
+		 */
+		static void getValues( const std::string& progName, Arg* a,
+		                       std::vector<std::string>& values );
+
+		/**
+		 * The file the values of a are cached in, in $XDG_CACHE_HOME or
+		 * else in $HOME/.cache, or "" if neither is set.  The program
+		 * and Arg names are escaped in the file name, see
+		 * _escapeName().
+		 */
+		static std::string cachePath( const std::string& progName,
+		                              const Arg* a );
+
+	private:
+
+		/**
+		 * Returns the Arg whose flag or name starts the word, or NULL.
+		 * \param labels - The index of the flags and names.
+		 * \param w - The word.
+		 * \param delimiter - The delimiter of the CmdLine.
+		 */
+		static Arg* _find( const LabelIndex& labels, const std::string& w,
+		                   char delimiter );
+
+		/**
+		 * Whether a can be given after the given Args: it wasn't given
+		 * unless it can be repeated, and no Arg xor'd with it was.
+		 */
+		static bool _canGive( Arg* a, const std::vector<Arg*>& given,
+		                      const XorHandler& xors );
+
+		/**
+		 * Prints the candidates that start with prefix, each after lead.
+		 * \param candidates - The candidates, which are sorted unless
+		 * they are already.
+		 */
+		static void _printMatches( std::vector<std::string>& candidates,
+		                           const std::string& prefix,
+		                           const std::string& lead,
+		                           std::ostream& os );
+
+		/**
+		 * Reads the values cached in the file if they are younger than
+		 * cacheTime seconds.  Returns whether they were.
+		 */
+		static bool _readCache( const std::string& path, int cacheTime,
+		                        std::vector<std::string>& values );
+
+		/**
+		 * Writes the values to the cache file, through a file only this
+		 * process writes, which is renamed into place.  A cache that is
+		 * still younger than cacheTime seconds is kept if it can't be
+		 * replaced.
+		 */
+		static void _writeCache( const std::string& path, int cacheTime,
+		                         const std::vector<std::string>& values );
+
+		/**
+		 * Appends the name to out with every character other than
+		 * letters, digits, '.', '_' and '-' written as '%' and its two
+		 * hex digits, so that it is a single safe file name.
+		 */
+		static void _escapeName( const std::string& name, std::string& out );
+
+		/**
+		 * Creates the directory the file is in, and those above it, with
+		 * mode 0700 where they are missing.
+		 */
+		static void _makeParents( const std::string& path );
+};
+
+inline void Completion::complete( const LabelIndex& labels,
+                                  const std::list<Arg*>& unlabeled,
+                                  const XorHandler& xors,
+                                  char delimiter,
+                                  const std::vector<std::string>& words,
+                                  std::size_t index, std::ostream& os )
+{
+	if ( index == 0 || words.empty() )
+		return;
+	if ( index > words.size() )
+		index = words.size();
+
+	// go through the words before the one completed
+	std::vector<Arg*> given;
+	std::size_t positional = 0;
+	bool rest = false;
+	Arg* valueOf = NULL;
+	for ( std::size_t k = 1; k < index; k++ )
+	{
+		const std::string& w = words[k];
+		if ( rest )
+		{
+			positional++;
+			continue;
+		}
+
+		// bash splits "--name=value" at the "="
+		if ( delimiter != ' ' && w.length() == 1 && w[0] == delimiter )
+		{
+			if ( k + 1 == index )
+				valueOf = _find( labels, words[k - 1], delimiter );
+			k++;
+			continue;
+		}
+
+		Arg* a = _find( labels, w, delimiter );
+		if ( a != NULL )
+		{
+			given.push_back( a );
+			if ( a->getFlag() == Arg::flagStartString() )
+				rest = true;
+			else if ( delimiter == ' ' && a->isValueRequired() )
+			{
+				if ( k + 1 == index )
+					valueOf = a;
+				k++;
+			}
+		}
+		else if ( !w.compare( 0, Arg::flagStartString().length(),
+		                      Arg::flagStartString() ) &&
+		          w.compare( 0, Arg::nameStartString().length(),
+		                     Arg::nameStartString() ) )
+		{
+			// combined switches
+			for ( std::size_t j = Arg::flagStartString().length();
+			      j < w.length(); j++ )
+			{
+				LabelIndex::const_iterator f =
+					labels.find( Arg::flagStartString() + w[j] );
+				if ( f != labels.end() )
+					given.push_back( f->second );
+			}
+		}
+		else
+			positional++;
+	}
+
+	std::string cur = index < words.size() ? words[index] : "";
+	std::string lead;
+	if ( valueOf == NULL && !rest && delimiter != ' ' )
+	{
+		std::string::size_type pos = cur.find( delimiter );
+		if ( cur.length() == 1 && pos == 0 )
+		{
+			valueOf = _find( labels, words[index - 1], delimiter );
+			cur.clear();
+		}
+		else if ( pos != std::string::npos &&
+		          !cur.compare( 0, Arg::flagStartString().length(),
+		                        Arg::flagStartString() ) )
+		{
+			valueOf = _find( labels, cur, delimiter );
+			lead = cur.substr( 0, pos + 1 );
+			cur.erase( 0, pos + 1 );
+		}
+	}
+
+	std::vector<std::string> candidates;
+	if ( valueOf != NULL )
+	{
+		if ( valueOf->isValueRequired() )
+			getValues( words[0], valueOf, candidates );
+		_printMatches( candidates, cur, lead, os );
+		return;
+	}
+
+	if ( !rest && !cur.compare( 0, Arg::flagStartString().length(),
+	                            Arg::flagStartString() ) )
+	{
+		for ( LabelIndex::const_iterator it = labels.lower_bound( cur );
+		      it != labels.end() && !it->first.compare( 0, cur.length(), cur );
+		      it++ )
+		{
+			if ( it->second->getFlag() == Arg::flagStartString() ||
+			     !_canGive( it->second, given, xors ) )
+				continue;
+
+			os << it->first;
+			if ( delimiter != ' ' && it->second->isValueRequired() )
+				os << delimiter;
+			os << '\n';
+		}
+		return;
+	}
+
+	// the unlabeled Arg the positional argument goes to
+	std::size_t i = 0;
+	for ( ArgListIterator it = unlabeled.begin(); it != unlabeled.end();
+	      it++, i++ )
+		if ( i == positional || (*it)->acceptsMultipleValues() )
+		{
+			getValues( words[0], *it, candidates );
+			_printMatches( candidates, cur, lead, os );
+			return;
+		}
+}
+
+inline void Completion::getValues( const std::string& progName, Arg* a,
+                                   std::vector<std::string>& values )
+{
+	CompletionProvider* provider = a->getCompletionProvider();
+	if ( provider != NULL )
+	{
+		const std::string path = provider->getCacheTime() > 0
+		                         ? cachePath( progName, a ) : "";
+		if ( !path.empty() &&
+		     _readCache( path, provider->getCacheTime(), values ) )
+			return;
+
+		std::vector<std::string> provided;
+		provider->getValues( provided );
+
+		// sorted in the cache so that reading it doesn't sort again
+		std::sort( provided.begin(), provided.end() );
+		provided.erase( std::unique( provided.begin(), provided.end() ),
+		                provided.end() );
+		if ( !path.empty() )
+			_writeCache( path, provider->getCacheTime(), provided );
+		values.insert( values.end(), provided.begin(), provided.end() );
+		return;
+	}
+
+	// Example: "[-m <fast|slow>]", "<a|b|c|...> ..."
+	std::string arg = a->shortID();
+	std::string::size_type pos = arg.find('<');
+	if ( pos != std::string::npos )
+		arg.erase(0, pos + 1);
+	pos = arg.rfind('>');
+	if ( pos != std::string::npos )
+		arg.erase(pos);
+
+	if ( arg.find('|') == std::string::npos )
+		return;
+
+	std::string::size_type b = 0;
+	while ( b <= arg.length() )
+	{
+		std::string::size_type e = arg.find('|', b);
+		if ( e == std::string::npos )
+			e = arg.length();
+
+		if ( arg.compare( b, e - b, "..." ) )
+			values.push_back( arg.substr( b, e - b ) );
+		b = e + 1;
+	}
+}
+
+inline std::string Completion::cachePath( const std::string& progName,
+                                          const Arg* a )
+{
+	std::string dir;
+	const char* env = getenv( "XDG_CACHE_HOME" );
+	if ( env != NULL && *env != '\0' )
+		dir = env;
+	else if ( ( env = getenv( "HOME" ) ) != NULL && *env != '\0' )
+		dir = std::string( env ) + "/.cache";
+	else
+		return "";
+
+	std::string::size_type p = progName.find_last_of( "/\\" );
+	p = p != std::string::npos ? p + 1 : 0;
+
+	std::string path = dir + "/tclap-";
+	_escapeName( progName.substr( p ), path );
+	path += "-";
+	_escapeName( a->getName(), path );
+	return path;
+}
+
+inline void Completion::_escapeName( const std::string& name,
+                                     std::string& out )
+{
+	static const char hex[] = "0123456789ABCDEF";
+	for ( std::size_t i = 0; i < name.length(); i++ )
+	{
+		const unsigned char c = static_cast<unsigned char>(name[i]);
+		if ( ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ) ||
+		     ( c >= '0' && c <= '9' ) || c == '.' || c == '_' || c == '-' )
+			out += static_cast<char>(c);
+		else
+		{
+			out += '%';
+			out += hex[c >> 4];
+			out += hex[c & 0xf];
+		}
+	}
+}
+
+inline void Completion::_makeParents( const std::string& path )
+{
+	// existing directories only fail with EEXIST, which is ignored
+	for ( std::string::size_type p = path.find( '/', 1 );
+	      p != std::string::npos; p = path.find( '/', p + 1 ) )
+	{
+		const std::string dir = path.substr( 0, p );
+#if defined(TCLAP_GETPID)
+		mkdir( dir.c_str(), 0700 );
+#elif defined(_WIN32)
+		_mkdir( dir.c_str() );
+#endif
+	}
+}
+
+inline Arg* Completion::_find( const LabelIndex& labels,
+                               const std::string& w, char delimiter )
+{
+	LabelIndex::const_iterator it = labels.find( w );
+	if ( it == labels.end() && delimiter != ' ' )
+	{
+		std::string::size_type pos = w.find( delimiter );
+		if ( pos != std::string::npos )
+			it = labels.find( w.substr( 0, pos ) );
+	}
+
+	return it != labels.end() ? it->second : NULL;
+}
+
+inline bool Completion::_canGive( Arg* a, const std::vector<Arg*>& given,
+                                  const XorHandler& xors )
+{
+	const int group = xors.getXorGroup( a );
+	for ( std::size_t i = 0; i < given.size(); i++ )
+	{
+		if ( given[i] == a )
+		{
+			if ( !a->isRepeatable() )
+				return false;
+		}
+		else if ( group >= 0 && xors.getXorGroup( given[i] ) == group )
+			return false;
+	}
+
+	return true;
+}
+
+inline void Completion::_printMatches( std::vector<std::string>& candidates,
+                                       const std::string& prefix,
+                                       const std::string& lead,
+                                       std::ostream& os )
+{
+	if ( std::adjacent_find( candidates.begin(), candidates.end(),
+	                         std::greater_equal<std::string>() ) !=
+	     candidates.end() )
+	{
+		std::sort( candidates.begin(), candidates.end() );
+		candidates.erase( std::unique( candidates.begin(), candidates.end() ),
+		                  candidates.end() );
+	}
+
+	for ( std::vector<std::string>::const_iterator it =
+	          std::lower_bound( candidates.begin(), candidates.end(), prefix );
+	      it != candidates.end() && !it->compare( 0, prefix.length(), prefix );
+	      it++ )
+		os << lead << *it << '\n';
+}
+
+inline bool Completion::_readCache( const std::string& path, int cacheTime,
+                                    std::vector<std::string>& values )
+{
+	std::ifstream in( path.c_str() );
+	std::string line;
+	if ( !std::getline( in, line ) )
+		return false;
+
+	// the first line is the time the values were written
+	const long written = strtol( line.c_str(), NULL, 10 );
+	const double age = difftime( time( NULL ), static_cast<time_t>(written) );
+	if ( age < 0 || age >= cacheTime )
+		return false;
+
+	while ( std::getline( in, line ) )
+		values.push_back( line );
+	return true;
+}
+
+inline void Completion::_writeCache( const std::string& path, int cacheTime,
+                                     const std::vector<std::string>& values )
+{
+	// a completion running at the same time reads the old file or the new,
+	// and one writing at the same time writes its own temporary file
+	std::ostringstream name;
+	name << path << ".tmp";
+#if defined(TCLAP_GETPID)
+	name << "." << static_cast<long>(getpid());
+#elif defined(_WIN32)
+	name << "." << static_cast<long>(_getpid());
+#endif
+	name << "." << static_cast<long>(time( NULL ));
+	const std::string tmp = name.str();
+	{
+		std::ofstream out( tmp.c_str() );
+		if ( !out.is_open() )
+		{
+			// e.g. $HOME/.cache of a new account
+			_makeParents( path );
+			out.clear();
+			out.open( tmp.c_str() );
+		}
+
+		out << static_cast<long>(time( NULL )) << '\n';
+		for ( std::size_t i = 0; i < values.size(); i++ )
+			if ( values[i].find('\n') == std::string::npos )
+				out << values[i] << '\n';
+
+		if ( !out )
+		{
+			out.close();
+			std::remove( tmp.c_str() );
+			return;
+		}
+	}
+
+	if ( std::rename( tmp.c_str(), path.c_str() ) != 0 )
+	{
+		// rename() may not replace a file, the cache is only removed if
+		// it is stale, not if another completion just wrote it
+		std::vector<std::string> current;
+		if ( !_readCache( path, cacheTime, current ) )
+		{
+			std::remove( path.c_str() );
+			if ( std::rename( tmp.c_str(), path.c_str() ) == 0 )
+				return;
+		}
+		std::remove( tmp.c_str() );
+	}
+}
+
+} //namespace TCLAP
+
+#endif
@@ -32,6 +32,9 @@
 #include <iomanip>
 #include <algorithm>
 #include <stdexcept>
+#include <cstddef>
+
+#include <tclap/ArgException.h>
 
 namespace TCLAP {
 
@@ -60,6 +63,35 @@ class Constraint
 		 */
 		virtual bool check(const T& value) const =0;
 
+		/**
+		 * Describes the Constraint for the message of a value that
+		 * doesn't meet it.  By default the description, a Constraint
+		 * can re-implement it to say what is wrong with the value.
+		 * \param value - The value that failed check().
+		 */
+		virtual std::string failureDescription(const T& value) const
+		{
+			static_cast<void>(value); // Ignore input, don't warn
+			return description();
+		}
+
+		/**
+		 * Checks many values at once, e.g. the values of a list given
+		 * to a MultiArg.  Returns the index of the first value that
+		 * doesn't meet the constraint, or count if all of them do.  By
+		 * default each value is passed to check(), a Constraint can
+		 * re-implement it to check them faster.
+		 * \param values - The values that will be checked.
+		 * \param count - The number of values.
+		 */
+		virtual std::size_t checkAll(const T* values, std::size_t count) const
+		{
+			for (std::size_t i = 0; i < count; i++)
+				if (!check(values[i]))
+					return i;
+			return count;
+		}
+
 		/**
 		 * Destructor.
 		 * Silences warnings about Constraint being a base class with virtual
@@ -69,7 +101,7 @@ class Constraint
 
 		static std::string shortID(Constraint<T> *constraint) {
 		  if (!constraint)
-		    throw std::logic_error("Cannot create a ValueArg with a NULL constraint");
+		    TCLAP_THROW( std::logic_error("Cannot create a ValueArg with a NULL constraint") );
 		  return constraint->shortID();
 		}
 };
@@ -100,8 +100,8 @@ inline void DocBookOutput::usage(CmdLineInterface& _cmd )
 	std::string progName = _cmd.getProgramName();
 	std::string xversion = _cmd.getVersion();
 	theDelimiter = _cmd.getDelimiter();
-	XorHandler xorHandler = _cmd.getXorHandler();
-	const std::vector< std::vector<Arg*> > xorList = xorHandler.getXorList();
+	XorHandler& xorHandler = _cmd.getXorHandler();
+	const std::vector< std::vector<Arg*> >& xorList = xorHandler.getXorList();
 	basename(progName);
 
 	std::cout << "<?xml version='1.0'?>" << std::endl;
@@ -178,7 +178,7 @@ inline void DocBookOutput::failure( CmdLineInterface& _cmd,
 { 
 	static_cast<void>(_cmd); // unused
 	std::cout << e.what() << std::endl;
-	throw ExitException(1);
+	TCLAP_THROW( ExitException(1) );
 }
 
 inline void DocBookOutput::substituteSpecialChars( std::string& s,
@@ -0,0 +1,199 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+/******************************************************************************
+ *
+ *  file:  DocGenerator.h
+ *
+ *  Copyright (c) 2018, Google LLC
+ *  All rights reserved.
+ *
+ *  See the file COPYING in the top directory of this distribution for
+ *  more information.
+ *
+ *  THE SOFTWARE IS PROVIDED _AS IS_, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ *  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *  DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef TCLAP_DOCGENERATOR_H
+#define TCLAP_DOCGENERATOR_H
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <stdio.h>
+
+#include <tclap/CmdLineInterface.h>
+#include <tclap/CmdLineOutput.h>
+#include <tclap/StdOutput.h>
+#include <tclap/ManPageOutput.h>
+#include <tclap/DocBookOutput.h>
+#include <tclap/BashCompletionOutput.h>
+#include <tclap/FishCompletionOutput.h>
+#include <tclap/ZshCompletionOutput.h>
+
+namespace TCLAP {
+
+/**
+ * Writes the documentation of a command line to files, so it can be
+ * generated when the program is built rather than by running it.  A
+ * program compiled with TCLAP_GENERATE calls this from CmdLine::parse()
+ * instead of parsing its arguments, see add_example_docs() in
+ * examples/CMakeLists.txt.
+ */
+class DocGenerator
+{
+	public:
+
+		/**
+		 * Writes the documentation of c to files whose names start with
+		 * prefix: the man page to ".1", DocBook to ".xml", the bash, fish
+		 * and zsh completions to ".bash", ".fish" and ".zsh", the usage
+		 * as --help prints it to ".txt", and the usage as a C string to
+		 * "_usage.h", for StdOutput::setUsage().  Returns false if a
+		 * file can't be written, with the reason in error.
+		 * \param c - The CmdLine object the documentation is for.
+		 * \param prefix - The path of the files, without the suffix.
+		 * \param error - Where the reason of a failure is stored.
+		 */
+		static bool generate( CmdLineInterface& c,
+		                      const std::string& prefix,
+		                      std::string& error );
+
+		/**
+		 * Appends s to out as the lines of a C string literal.
+		 * \param s - The string.
+		 * \param out - The string the literal is appended to.
+		 */
+		static void quote( const std::string& s, std::string& out );
+
+	private:
+
+		/**
+		 * Writes what the usage() of output prints for c to path.
+		 */
+		static bool _write( CmdLineOutput& output, CmdLineInterface& c,
+		                    const std::string& path, std::string& error );
+
+		/**
+		 * Writes text to path.
+		 */
+		static bool _write( const std::string& text,
+		                    const std::string& path, std::string& error );
+};
+
+inline bool DocGenerator::generate( CmdLineInterface& c,
+                                    const std::string& prefix,
+                                    std::string& error )
+{
+	ManPageOutput man;
+	DocBookOutput docBook;
+	BashCompletionOutput bash;
+	FishCompletionOutput fish;
+	ZshCompletionOutput zsh;
+
+	// at the width usage() uses when stdout isn't a terminal
+	StdOutput stdOutput;
+	std::string text;
+	stdOutput.renderUsage( c, 75, text );
+
+	std::string header = "/* The usage of " + c.getProgramName() +
+		", generated by TCLAP.  Do not edit. */\n\n" +
+		"static const char tclapUsageProgName[] =\n";
+	quote( c.getProgramName(), header );
+	header += ";\n\nstatic const char tclapUsage[] =\n";
+	quote( text, header );
+	header += ";\n";
+
+	return _write( man, c, prefix + ".1", error ) &&
+	       _write( docBook, c, prefix + ".xml", error ) &&
+	       _write( bash, c, prefix + ".bash", error ) &&
+	       _write( fish, c, prefix + ".fish", error ) &&
+	       _write( zsh, c, prefix + ".zsh", error ) &&
+	       _write( text, prefix + ".txt", error ) &&
+	       _write( header, prefix + "_usage.h", error );
+}
+
+inline void DocGenerator::quote( const std::string& s, std::string& out )
+{
+	out += "\t\"";
+	for ( std::string::size_type i = 0; i < s.length(); i++ )
+	{
+		const unsigned char c = static_cast<unsigned char>(s[i]);
+		if ( c == '\n' )
+		{
+			out += "\\n";
+			if ( i + 1 < s.length() )
+				out += "\"\n\t\"";
+		}
+		// '?' is escaped so no trigraph is formed
+		else if ( c == '"' || c == '\\' || c == '?' )
+		{
+			out += '\\';
+			out += static_cast<char>(c);
+		}
+		else if ( c < ' ' || c >= 0x7f )
+		{
+			char octal[5];
+			sprintf( octal, "\\%03o", c );
+			out += octal;
+		}
+		else
+			out += static_cast<char>(c);
+	}
+	out += "\"";
+}
+
+inline bool DocGenerator::_write( CmdLineOutput& output,
+                                  CmdLineInterface& c,
+                                  const std::string& path,
+                                  std::string& error )
+{
+	std::ofstream file( path.c_str() );
+	if ( !file )
+	{
+		error = "Couldn't create " + path;
+		return false;
+	}
+
+	// the outputs print to stdout
+	std::streambuf* buf = std::cout.rdbuf( file.rdbuf() );
+	output.usage( c );
+	std::cout.flush();
+	std::cout.rdbuf( buf );
+
+	file.close();
+	if ( !file )
+	{
+		error = "Couldn't write " + path;
+		return false;
+	}
+	return true;
+}
+
+inline bool DocGenerator::_write( const std::string& text,
+                                  const std::string& path,
+                                  std::string& error )
+{
+	std::ofstream file( path.c_str() );
+	file.write( text.data(), static_cast<std::streamsize>(text.size()) );
+	file.close();
+	if ( !file )
+	{
+		error = "Couldn't write " + path;
+		return false;
+	}
+	return true;
+}
+
+} //namespace TCLAP
+#endif
@@ -0,0 +1,311 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+/******************************************************************************
+ *
+ *  file:  FishCompletionOutput.h
+ *
+ *  Copyright (c) 2018, Google LLC
+ *  All rights reserved.
+ *
+ *  See the file COPYING in the top directory of this distribution for
+ *  more information.
+ *
+ *  THE SOFTWARE IS PROVIDED _AS IS_, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ *  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *  DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef TCLAP_FISHCOMPLETIONOUTPUT_H
+#define TCLAP_FISHCOMPLETIONOUTPUT_H
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <list>
+#include <iostream>
+#include <map>
+
+#include <tclap/CmdLineInterface.h>
+#include <tclap/CmdLineOutput.h>
+#include <tclap/XorHandler.h>
+#include <tclap/Arg.h>
+
+namespace TCLAP {
+
+/**
+ * A class that generates a fish completion script as output from the
+ * usage() method for the given CmdLine and its Args.  Like
+ * BashCompletionOutput the script is static, with the values of
+ * ValuesConstraints and the xor'd groups written into it.  Fish can't
+ * easily tell which positional argument is completed, so the values of
+ * all unlabeled Args are offered for each of them.
+ */
+class FishCompletionOutput : public CmdLineOutput
+{
+
+	public:
+
+		FishCompletionOutput();
+
+		/**
+		 * Prints the completion script to stdout.
+		 * \param c - The CmdLine object the output is generated for.
+		 */
+		virtual void usage(CmdLineInterface& c);
+
+		/**
+		 * Prints the version to stdout.
+		 * \param c - The CmdLine object the output is generated for.
+		 */
+		virtual void version(CmdLineInterface& c);
+
+		/**
+		 * Prints the error message to stdout.
+		 * \param c - The CmdLine object the output is generated for.
+		 * \param e - The ArgException that caused the failure.
+		 */
+		virtual void failure(CmdLineInterface& c,
+		                     ArgException& e );
+
+	protected:
+
+		void basename( std::string& s );
+		void quote( std::string& s );
+
+		/**
+		 * The description of the value of a, without brackets, e.g.
+		 * "file" or "a|b|c".
+		 */
+		std::string valueId( Arg* a );
+
+		/**
+		 * Sets s to the candidates for the value of a, quoted for
+		 * "complete -a", or to "" for file names.  Returns false if the
+		 * value can't be completed, e.g. a number.
+		 */
+		bool candidates( Arg* a, std::string& s );
+
+		/**
+		 * Prints the "complete" command for a, with a condition that
+		 * leaves it out once it, if it can't be repeated, or an Arg
+		 * xor'd with it was given.
+		 */
+		void printOption( CmdLineInterface& _cmd, Arg* a,
+		                  const std::string& progName );
+
+		/**
+		 * The candidates for the common descriptions of values, "" for
+		 * file names.
+		 */
+		std::map<std::string, std::string> common;
+};
+
+inline FishCompletionOutput::FishCompletionOutput()
+: common(std::map<std::string, std::string>())
+{
+	common["host"] = "'(__fish_print_hostnames)'";
+	common["hostname"] = "'(__fish_print_hostnames)'";
+	common["file"] = "";
+	common["filename"] = "";
+	common["user"] = "'(__fish_complete_users)'";
+	common["username"] = "'(__fish_complete_users)'";
+	common["directory"] = "'(__fish_complete_directories (commandline -ct))'";
+	common["path"] = "'(__fish_complete_directories (commandline -ct))'";
+}
+
+inline void FishCompletionOutput::version(CmdLineInterface& _cmd)
+{
+	std::cout << _cmd.getVersion() << std::endl;
+}
+
+inline void FishCompletionOutput::failure( CmdLineInterface& _cmd,
+                                           ArgException& e )
+{
+	static_cast<void>(_cmd); // unused
+	std::cout << e.what() << std::endl;
+}
+
+inline void FishCompletionOutput::usage(CmdLineInterface& _cmd )
+{
+	std::list<Arg*> argList = _cmd.getArgList();
+	std::string progName = _cmd.getProgramName();
+	basename(progName);
+
+	std::cout << "# fish completion for " << progName << std::endl <<
+		"# " << progName << " version " << _cmd.getVersion() << std::endl <<
+		std::endl;
+
+	// file names are offered unless no unlabeled Arg takes them
+	bool files = false;
+	for (ArgListIterator it = argList.begin(); it != argList.end(); it++)
+	{
+		if ( (*it)->shortID().at(0) == '<' )
+		{
+			std::string values;
+			if ( !candidates( *it, values ) || values.empty() )
+				files = true;
+			else
+				std::cout << "complete -c " << progName << " -a " <<
+					values << std::endl;
+		}
+		else if ( (*it)->getFlag() != "-" )
+			printOption( _cmd, *it, progName );
+	}
+
+	if ( !files )
+		std::cout << "complete -c " << progName << " -f" << std::endl;
+}
+
+inline void FishCompletionOutput::printOption( CmdLineInterface& _cmd,
+                                               Arg* a,
+                                               const std::string& progName )
+{
+	XorHandler& xorHandler = _cmd.getXorHandler();
+	const std::vector< std::vector<Arg*> >& xorList = xorHandler.getXorList();
+
+	std::vector<Arg*> exclusive;
+	const int g = xorHandler.getXorGroup( a );
+	if ( g >= 0 )
+	{
+		for ( ArgVectorIterator it = xorList[g].begin();
+		      it != xorList[g].end(); it++ )
+			if ( *it != a || !a->isRepeatable() )
+				exclusive.push_back( *it );
+	}
+	else if ( !a->isRepeatable() )
+		exclusive.push_back( a );
+
+	std::cout << "complete -c " << progName;
+	if ( !exclusive.empty() )
+	{
+		// __fish_contains_opt takes the short options first
+		std::cout << " -n 'not __fish_contains_opt";
+		for ( std::size_t i = 0; i < exclusive.size(); i++ )
+			if ( !exclusive[i]->getFlag().empty() )
+				std::cout << " -s " << exclusive[i]->getFlag();
+		for ( std::size_t i = 0; i < exclusive.size(); i++ )
+			std::cout << " " << exclusive[i]->getName();
+		std::cout << "'";
+	}
+
+	if ( !a->getFlag().empty() )
+		std::cout << " -s " << a->getFlag();
+	std::cout << " -l " << a->getName();
+
+	std::string desc = a->getDescription();
+
+	// remove what the help output adds to the description
+	if (!desc.compare(0, 12, "(required)  "))
+		desc.erase(0, 12);
+	if (!desc.compare(0, 15, "(OR required)  "))
+		desc.erase(0, 15);
+	std::string::size_type len = desc.length();
+	if (len && desc.at(--len) == '.')
+		desc.erase(len);
+
+	if ( !desc.empty() )
+	{
+		quote( desc );
+		std::cout << " -d " << desc;
+	}
+
+	if ( a->isValueRequired() )
+	{
+		std::string values;
+		if ( !candidates( a, values ) )
+			std::cout << " -x";
+		else if ( values.empty() )
+			std::cout << " -r -F";
+		else
+			std::cout << " -x -a " << values;
+	}
+	std::cout << std::endl;
+}
+
+inline bool FishCompletionOutput::candidates( Arg* a, std::string& s )
+{
+	std::string arg = valueId( a );
+
+	std::map<std::string, std::string>::iterator compArg =
+		common.find( arg );
+	if ( compArg == common.end() )
+		compArg = common.find( a->getName() );
+
+	if ( compArg != common.end() )
+	{
+		s = compArg->second;
+		return true;
+	}
+
+	if ( arg.find('|') == std::string::npos )
+		return false;
+
+	// the allowed values, without the "..." of a long list
+	std::string words;
+	std::string::size_type b = 0;
+	while ( b <= arg.length() )
+	{
+		std::string::size_type e = arg.find('|', b);
+		if ( e == std::string::npos )
+			e = arg.length();
+
+		const std::string word = arg.substr(b, e - b);
+		if ( word != "..." )
+			words += ( words.empty() ? "" : " " ) + word;
+		b = e + 1;
+	}
+
+	quote( words );
+	s = words;
+	return true;
+}
+
+inline std::string FishCompletionOutput::valueId( Arg* a )
+{
+	std::string arg = a->shortID();
+
+	// Example arg: "[-A <integer>] ..."
+	std::string::size_type pos = arg.rfind(" ...");
+	if ( pos != std::string::npos )
+		arg.erase(pos);
+
+	pos = arg.find('<');
+	if ( pos != std::string::npos )
+		arg.erase(0, pos + 1);
+	pos = arg.rfind('>');
+	if ( pos != std::string::npos )
+		arg.erase(pos);
+
+	return arg;
+}
+
+inline void FishCompletionOutput::quote( std::string& s )
+{
+	std::string::size_type idx = s.find_first_of("'\\");
+	while ( idx != std::string::npos )
+	{
+		s.insert(idx, 1, '\\');
+		idx = s.find_first_of("'\\", idx + 2);
+	}
+	s = "'" + s + "'";
+}
+
+inline void FishCompletionOutput::basename( std::string& s )
+{
+	std::string::size_type p = s.find_last_of('/');
+	if ( p != std::string::npos )
+	{
+		s.erase(0, p + 1);
+	}
+}
+
+} //namespace TCLAP
+#endif
@@ -27,6 +27,8 @@
 #include <tclap/CmdLineInterface.h>
 #include <tclap/CmdLineOutput.h>
 #include <tclap/Visitor.h>
+#include <tclap/ArgException.h>
+#include <tclap/ParseResult.h>
 
 namespace TCLAP {
 
@@ -69,7 +71,23 @@ class HelpVisitor: public Visitor
 		 * Calls the usage method of the CmdLineOutput for the 
 		 * specified CmdLine.
 		 */
-		void visit() { (*_out)->usage(*_cmd); throw ExitException(0); }
+		void visit() { (*_out)->usage(*_cmd); TCLAP_THROW( ExitException(0) ); }
+
+		/**
+		 * Calls the usage method and asks the parse to exit.
+		 * \param result - The outcome of the parse so far.
+		 */
+		void visitParse( ParseResult& result )
+		{
+			(*_out)->usage(*_cmd);
+			result.requestExit(0);
+		}
+
+		/**
+		 * Asks the parse to exit without printing the usage.
+		 * \param result - The outcome of the parse so far.
+		 */
+		void skipParse( ParseResult& result ) { result.requestExit(0); }
 		
 };
 
@@ -31,8 +31,9 @@
 namespace TCLAP {
 
 /**
- * A Visitor that tells the CmdLine to begin ignoring arguments after
- * this one is parsed.
+ * A Visitor that sets Arg::ignoreRest() after this one is parsed.  Not
+ * used by CmdLine, which ignores the arguments following "--" by
+ * itself, see ParseResult::ignoreRest().
  */
 class IgnoreRestVisitor: public Visitor
 {
@@ -0,0 +1,373 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+/******************************************************************************
+ *
+ *  file:  IncrementalParser.h
+ *
+ *  Copyright (c) 2018, Google LLC
+ *  All rights reserved.
+ *
+ *  See the file COPYING in the top directory of this distribution for
+ *  more information.
+ *
+ *  THE SOFTWARE IS PROVIDED _AS IS_, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ *  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *  DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef TCLAP_INCREMENTAL_PARSER_H
+#define TCLAP_INCREMENTAL_PARSER_H
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <algorithm>
+
+#include <tclap/CmdLine.h>
+#include <tclap/ArgToken.h>
+#include <tclap/ParseResult.h>
+
+namespace TCLAP {
+
+/**
+ * Parses a command line one argument at a time, e.g. to check a command
+ * as it is typed into an interactive shell.  Each argument is parsed as
+ * it is added, so the work per argument doesn't grow with the length of
+ * the command line, and after each one the parser tells which Args are
+ * set, which required Args are still missing and which Args can come
+ * next.  An argument for a labeled Arg that takes its value from the
+ * next argument is parsed once the value is added.  Errors are recorded
+ * in the result as CmdLine::tryParse() does, nothing is thrown or
+ * printed.  Visitors aren't run, so --help and --version are matched
+ * like other switches, and "@file" arguments aren't expanded.  The
+ * CmdLine must not be modified while it is used by the parser, and all
+ * its Args must implement Arg::processToken().
+ */
+class IncrementalParser
+{
+	public:
+
+		/**
+		 * \param cmd - The CmdLine that defines the command line.
+		 * \param progName - The program name of the first command line.
+		 */
+		IncrementalParser( const CmdLine& cmd,
+		                   const std::string& progName = "" );
+
+		/**
+		 * Starts a new command line, keeping the storage of the last
+		 * one.
+		 * \param progName - The program name.
+		 */
+		void begin( const std::string& progName );
+
+		/**
+		 * Adds the next argument of the command line.  Returns false if
+		 * the command line is invalid or the parse has finished, the
+		 * argument is ignored then.
+		 * \param arg - The argument.
+		 */
+		bool add( const std::string& arg );
+
+		/**
+		 * Ends the command line, parsing an argument that still waits
+		 * for its value and checking the required Args as
+		 * CmdLine::tryParse() does.  Returns whether the command line is
+		 * valid.  Nothing can be added after this until begin().
+		 */
+		bool finish();
+
+		/**
+		 * The number of arguments added since begin().
+		 */
+		std::size_t size() const;
+
+		/**
+		 * The outcome of the parse so far.  The values are read through
+		 * the Args, e.g. with ValueArg::getValue(const ParseResult&).
+		 */
+		const ParseResult& getResult() const;
+
+		/**
+		 * Whether the Arg was matched by the arguments so far.
+		 * \param a - An Arg of the CmdLine.
+		 */
+		bool isSet( const Arg& a ) const;
+
+		/**
+		 * The Arg whose value is expected next, i.e. the last argument
+		 * is its flag or name, or NULL.
+		 */
+		const Arg* getPendingArg() const;
+
+		/**
+		 * Whether the arguments so far form a valid command line, i.e.
+		 * finish() would succeed.
+		 */
+		bool isComplete() const;
+
+		/**
+		 * Sets missing to the required Args that haven't been matched,
+		 * leaving out those xor'd with an Arg that has been.
+		 * \param missing - Where the Args are stored, cleared first.
+		 */
+		void getMissing( std::vector<const Arg*>& missing ) const;
+
+		/**
+		 * Sets allowed to the Args the next argument can match: the Arg
+		 * whose value is pending, if any, otherwise the labeled Args
+		 * that can still be given and the unlabeled Arg the next
+		 * positional argument goes to.  Empty if the parse has stopped.
+		 * \param allowed - Where the Args are stored, cleared first.
+		 */
+		void getAllowed( std::vector<const Arg*>& allowed ) const;
+
+	private:
+
+		/**
+		 * Prevent accidental copying.
+		 */
+		IncrementalParser( const IncrementalParser& rhs );
+		IncrementalParser& operator=( const IncrementalParser& rhs );
+
+		/**
+		 * Parses the arguments not parsed yet, except an argument at the
+		 * end that waits for its value.  Returns false if the parse
+		 * stopped.
+		 * \param atEnd - Whether no more arguments will follow.
+		 */
+		bool _parsePending( bool atEnd );
+
+		/**
+		 * Whether a can still be given, ignoring the order of the
+		 * unlabeled Args.
+		 */
+		bool _canMatch( const Arg* a ) const;
+
+		const CmdLine& _cmd;
+
+		/**
+		 * The arguments, which the tokens refer to.  Strings in a deque
+		 * stay where they are when more are added, and are reused by the
+		 * next command line.
+		 */
+		std::deque<std::string> _args;
+
+		std::size_t _size;
+
+		ArgTokenList _tokens;
+
+		ParseResult _result;
+
+		/**
+		 * The index of the first token that hasn't been parsed.
+		 */
+		std::size_t _next;
+
+		/**
+		 * The number of required Args matched so far.
+		 */
+		int _requiredCount;
+
+		/**
+		 * Storage for the id of a labeled argument.
+		 */
+		std::string _id;
+
+		const Arg* _pending;
+
+		bool _finished;
+};
+
+inline IncrementalParser::IncrementalParser( const CmdLine& cmd,
+                                             const std::string& progName )
+: _cmd( cmd ),
+  _args(),
+  _size( 0 ),
+  _tokens(),
+  _result(),
+  _next( 0 ),
+  _requiredCount( 0 ),
+  _id(),
+  _pending( NULL ),
+  _finished( false )
+{
+	_result.setRunsVisitors( false );
+	begin( progName );
+}
+
+inline void IncrementalParser::begin( const std::string& progName )
+{
+	_size = 0;
+	_tokens.clear();
+	_result.clear();
+	_result.setStateIndices( &_cmd._stateIndices );
+	_result.setXorGroups( &_cmd._xorHandler.getXorGroups() );
+	_result.setProgramName( progName );
+	_result.setConvertsLazily( _cmd._lazyConversion );
+	_next = 0;
+	_requiredCount = 0;
+	_pending = NULL;
+	_finished = false;
+}
+
+inline bool IncrementalParser::add( const std::string& arg )
+{
+	if ( _finished || _result.hasStopped() )
+		return false;
+
+	if ( _size < _args.size() )
+		_args[_size] = arg;
+	else
+		_args.push_back( arg );
+
+	const std::string& s = _args[_size++];
+	_tokens.add( s.c_str(), s.length() );
+	Arg::classifyToken( _tokens[_tokens.size() - 1], _cmd._delimiter );
+
+	return _parsePending( false );
+}
+
+inline bool IncrementalParser::finish()
+{
+	if ( !_finished && !_result.hasStopped() )
+	{
+		_finished = true;
+		if ( _parsePending( true ) )
+			_cmd._checkRequired( _requiredCount, _result );
+	}
+
+	_finished = true;
+	return !_result.hasStopped();
+}
+
+inline bool IncrementalParser::_parsePending( bool atEnd )
+{
+	_pending = NULL;
+	while ( _next < _tokens.size() )
+	{
+		// a flag or name whose value is the next argument waits for it
+		if ( !atEnd && _next + 1 == _tokens.size() )
+		{
+			const ArgToken& token = _tokens[_next];
+			const Arg* a = _cmd._findLabeled( token, _id );
+			if ( a != NULL && a->isValueRequired() &&
+			     a->getValueDelimiter() == ' ' && token.valueLength() == 0 &&
+			     !( a->isIgnoreable() && _result.ignoreRest() ) )
+			{
+				_pending = a;
+				return true;
+			}
+		}
+
+		int i = static_cast<int>(_next);
+		_requiredCount += _cmd._parseToken( _tokens, &i, _id, _result );
+		_next = static_cast<std::size_t>(i) + 1;
+
+		if ( _result.hasStopped() )
+			return false;
+	}
+
+	return true;
+}
+
+inline std::size_t IncrementalParser::size() const
+{
+	return _size;
+}
+
+inline const ParseResult& IncrementalParser::getResult() const
+{
+	return _result;
+}
+
+inline bool IncrementalParser::isSet( const Arg& a ) const
+{
+	return a.isSet( _result );
+}
+
+inline const Arg* IncrementalParser::getPendingArg() const
+{
+	return _pending;
+}
+
+inline bool IncrementalParser::isComplete() const
+{
+	return !_result.hasStopped() && _pending == NULL &&
+	       _requiredCount == _cmd._numRequired;
+}
+
+inline void IncrementalParser::getMissing(
+	std::vector<const Arg*>& missing ) const
+{
+	missing.clear();
+	for ( ArgListIterator it = _cmd._argList.begin();
+	      it != _cmd._argList.end(); it++ )
+	{
+		const Arg* a = *it;
+		const int group = _result.getXorGroup( a );
+		if ( a->isRequired() && !a->isSet( _result ) &&
+		     ( group < 0 || _result.getXorSet( group ) == NULL ) )
+			missing.push_back( a );
+	}
+}
+
+inline void IncrementalParser::getAllowed(
+	std::vector<const Arg*>& allowed ) const
+{
+	allowed.clear();
+	if ( _pending != NULL )
+	{
+		allowed.push_back( _pending );
+		return;
+	}
+
+	if ( _finished || _result.hasStopped() )
+		return;
+
+	for ( ArgListIterator it = _cmd._argList.begin();
+	      it != _cmd._argList.end(); it++ )
+		if ( _canMatch( *it ) &&
+		     std::find( _cmd._unlabeledList.begin(),
+		                _cmd._unlabeledList.end(), *it ) ==
+		     _cmd._unlabeledList.end() )
+			allowed.push_back( *it );
+
+	// a positional argument goes to the first unlabeled Arg that takes it
+	for ( ArgListIterator it = _cmd._unlabeledList.begin();
+	      it != _cmd._unlabeledList.end(); it++ )
+		if ( _canMatch( *it ) )
+		{
+			allowed.push_back( *it );
+			break;
+		}
+}
+
+inline bool IncrementalParser::_canMatch( const Arg* a ) const
+{
+	if ( a->isIgnoreable() && _result.ignoreRest() )
+		return false;
+
+	const int group = _result.getXorGroup( a );
+	if ( group >= 0 )
+	{
+		const Arg* set = _result.getXorSet( group );
+		if ( set != NULL && set != a )
+			return false;
+	}
+
+	return !a->isSet( _result ) || a->isRepeatable();
+}
+
+} //namespace TCLAP
+
+#endif
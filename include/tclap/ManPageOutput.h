@@ -0,0 +1,251 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+/******************************************************************************
+ *
+ *  file:  ManPageOutput.h
+ *
+ *  Copyright (c) 2018, Google LLC
+ *  All rights reserved.
+ *
+ *  See the file COPYING in the top directory of this distribution for
+ *  more information.
+ *
+ *  THE SOFTWARE IS PROVIDED _AS IS_, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ *  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *  DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef TCLAP_MANPAGEOUTPUT_H
+#define TCLAP_MANPAGEOUTPUT_H
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <list>
+#include <iostream>
+
+#include <tclap/CmdLineInterface.h>
+#include <tclap/CmdLineOutput.h>
+#include <tclap/XorHandler.h>
+#include <tclap/Arg.h>
+
+namespace TCLAP {
+
+/**
+ * A class that generates a man page, in the troff format of man(7), as
+ * output from the usage() method for the given CmdLine and its Args.
+ */
+class ManPageOutput : public CmdLineOutput
+{
+
+	public:
+
+		ManPageOutput() : theDelimiter('=') {}
+
+		/**
+		 * Prints the man page to stdout.
+		 * \param c - The CmdLine object the output is generated for.
+		 */
+		virtual void usage(CmdLineInterface& c);
+
+		/**
+		 * Prints the version to stdout.
+		 * \param c - The CmdLine object the output is generated for.
+		 */
+		virtual void version(CmdLineInterface& c);
+
+		/**
+		 * Prints the error message to stdout.
+		 * \param c - The CmdLine object the output is generated for.
+		 * \param e - The ArgException that caused the failure.
+		 */
+		virtual void failure(CmdLineInterface& c,
+		                     ArgException& e );
+
+	protected:
+
+		void basename( std::string& s );
+
+		/**
+		 * Escapes the backslashes and hyphens of s, and a leading
+		 * period or quote that troff would take for a request.
+		 */
+		void quote( std::string& s );
+
+		/**
+		 * Prints the text of an argument, with its flag or name in bold
+		 * and its value in italics.
+		 */
+		void printId( const std::string& id );
+
+		char theDelimiter;
+};
+
+inline void ManPageOutput::version(CmdLineInterface& _cmd)
+{
+	std::cout << _cmd.getVersion() << std::endl;
+}
+
+inline void ManPageOutput::failure( CmdLineInterface& _cmd,
+                                    ArgException& e )
+{
+	static_cast<void>(_cmd); // unused
+	std::cout << e.what() << std::endl;
+	TCLAP_THROW( ExitException(1) );
+}
+
+inline void ManPageOutput::usage(CmdLineInterface& _cmd )
+{
+	std::list<Arg*> argList = _cmd.getArgList();
+	std::string progName = _cmd.getProgramName();
+	std::string xversion = _cmd.getVersion();
+	std::string message = _cmd.getMessage();
+	theDelimiter = _cmd.getDelimiter();
+	XorHandler& xorHandler = _cmd.getXorHandler();
+	const std::vector< std::vector<Arg*> >& xorList = xorHandler.getXorList();
+	basename(progName);
+
+	std::string title = progName;
+	for ( std::string::size_type i = 0; i < title.length(); i++ )
+		if ( title[i] >= 'a' && title[i] <= 'z' )
+			title[i] = static_cast<char>(title[i] - 'a' + 'A');
+
+	std::string name = progName;
+	quote( title );
+	quote( name );
+	quote( xversion );
+	quote( message );
+
+	std::cout << ".TH " << title << " 1 \"\" \"" << name << " " <<
+		xversion << "\"" << std::endl;
+
+	std::cout << ".SH NAME" << std::endl;
+	std::cout << name << " \\- " << message << std::endl;
+
+	std::cout << ".SH SYNOPSIS" << std::endl;
+	std::cout << ".B " << name << std::endl;
+
+	// xor
+	for ( int i = 0; static_cast<unsigned int>(i) < xorList.size(); i++ )
+	{
+		std::cout << "{";
+		for ( ArgVectorIterator it = xorList[i].begin();
+		      it != xorList[i].end(); it++ )
+		{
+			if ( it != xorList[i].begin() )
+				std::cout << "|";
+			printId( (*it)->shortID() );
+		}
+		std::cout << "}" << std::endl;
+	}
+
+	// rest of args
+	for (ArgListIterator it = argList.begin(); it != argList.end(); it++)
+		if ( !xorHandler.contains( (*it) ) )
+		{
+			printId( (*it)->shortID() );
+			std::cout << std::endl;
+		}
+
+	std::cout << ".SH DESCRIPTION" << std::endl;
+	std::cout << message << std::endl;
+
+	std::cout << ".SH OPTIONS" << std::endl;
+	for (ArgListIterator it = argList.begin(); it != argList.end(); it++)
+	{
+		std::string desc = (*it)->getDescription();
+		quote( desc );
+
+		std::cout << ".TP" << std::endl;
+		printId( (*it)->longID() );
+		std::cout << std::endl << desc << std::endl;
+	}
+
+	std::cout << ".SH VERSION" << std::endl;
+	std::cout << xversion << std::endl;
+}
+
+inline void ManPageOutput::printId( const std::string& id )
+{
+	// Example ids: "[-A <integer>] ...", "-n <string>,  --name <string>"
+	std::string s;
+	bool value = false;
+	bool label = false;
+	for ( std::string::size_type i = 0; i < id.length(); i++ )
+	{
+		const char c = id[i];
+		if ( c == '<' && !value )
+		{
+			if ( label )
+				s += "\\fR";
+			s += "\\fI";
+			label = false;
+			value = true;
+		}
+		else if ( !value && !label && c == Arg::flagStartChar() &&
+		          ( i == 0 || id[i - 1] == ' ' || id[i - 1] == '[' ||
+		            id[i - 1] == '{' || id[i - 1] == '|' ) )
+		{
+			s += "\\fB";
+			label = true;
+		}
+		else if ( label && ( c == ' ' || c == ']' || c == ',' ||
+		                     c == theDelimiter ) )
+		{
+			s += "\\fR";
+			label = false;
+		}
+
+		if ( c == '\\' )
+			s += "\\e";
+		else if ( c == '-' )
+			s += "\\-";
+		else
+			s += c;
+
+		if ( c == '>' && value )
+		{
+			s += "\\fR";
+			value = false;
+		}
+	}
+	if ( label || value )
+		s += "\\fR";
+
+	std::cout << s;
+}
+
+inline void ManPageOutput::quote( std::string& s )
+{
+	std::string::size_type idx = s.find_first_of("\\-");
+	while ( idx != std::string::npos )
+	{
+		s.insert(idx, 1, '\\');
+		if ( s[idx + 1] == '\\' )
+			s[idx + 1] = 'e';
+		idx = s.find_first_of("\\-", idx + 2);
+	}
+
+	if ( !s.empty() && ( s[0] == '.' || s[0] == '\'' ) )
+		s.insert(0, "\\&");
+}
+
+inline void ManPageOutput::basename( std::string& s )
+{
+	std::string::size_type p = s.find_last_of('/');
+	if ( p != std::string::npos )
+	{
+		s.erase(0, p + 1);
+	}
+}
+
+} //namespace TCLAP
+#endif
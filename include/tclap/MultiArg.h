@@ -28,6 +28,9 @@
 
 #include <string>
 #include <vector>
+#include <cstring>
+#include <algorithm>
+#include <utility>
 
 #include <tclap/Arg.h>
 #include <tclap/Constraint.h>
@@ -53,6 +56,12 @@ protected:
 	 */
 	std::vector<T> _values;
 
+	/**
+	 * The values given on the command line that haven't been converted
+	 * into _values yet, see CmdLine::setLazyConversion().
+	 */
+	std::vector<std::string> _pending;
+
 	/**
 	 * The description of type T to be used in the usage.
 	 */
@@ -71,11 +80,146 @@ protected:
 	 */
 	void _extractValue( const std::string& val );
 
+	/**
+	 * Extracts the value from the string and appends it to the given
+	 * values, throwing an ArgException if it is invalid.
+	 * \param values - Where the value is added.
+	 * \param val - The string to be read.
+	 */
+	void _extractValue( std::vector<T>& values, const std::string& val ) const;
+
+	/**
+	 * Extracts the value from the string and adds it to the values of
+	 * this argument in the result, or records the error if it is
+	 * invalid.
+	 * \param result - The outcome of the parse so far.
+	 * \param val - The string to be read.
+	 */
+	void _extractValue( ParseResult& result, const std::string& val ) const;
+
+	/**
+	 * Extracts the value, or the items of a list of values, from the
+	 * given characters and appends them to the given values.  A value
+	 * that is invalid or fails the constraint isn't stored, the error
+	 * is recorded and false is returned.
+	 * \param values - Where the values are added.
+	 * \param s - The characters to be read, NUL terminated.
+	 * \param length - The number of characters.
+	 * \param errors - Where an error is recorded.
+	 */
+	bool _appendValue( std::vector<T>& values, const char* s,
+	                   std::size_t length, ParseResult& errors ) const;
+
+	/**
+	 * Extracts the items of a list of values and appends them to the
+	 * given values.  The constraint checks them all at once, see
+	 * Constraint::checkAll().  If any item is invalid none of them are
+	 * kept and the error is recorded.
+	 * \param values - Where the values are added.
+	 * \param s - The list to be read, NUL terminated.
+	 * \param end - The end of the list.
+	 * \param errors - Where an error is recorded.
+	 */
+	bool _appendList( std::vector<T>& values, const char* s,
+	                  const char* end, ParseResult& errors ) const;
+
+	/**
+	 * Extracts a single value, recording the error if it can't be read.
+	 * \param value - Set to the value.
+	 * \param begin - The characters to be read.
+	 * \param end - The end of the characters.
+	 * \param errors - Where an error is recorded.
+	 */
+	bool _extract( T& value, const char* begin, const char* end,
+	               ParseResult& errors ) const;
+
+	/**
+	 * The state of this argument in the result, created the first time
+	 * the argument is matched.
+	 * \param result - The outcome of the parse so far.
+	 * \param expected - The number of values that may be given, room
+	 * is made for them when the state is created so they are only
+	 * allocated once.
+	 */
+	LazyValueState< std::vector<T> >& _resultState( ParseResult& result,
+	                                                std::size_t expected )
+		const;
+
+	/**
+	 * The state of this argument in the result, made room for the
+	 * values of the tokens that may follow when it is created.
+	 * \param result - The outcome of the parse so far.
+	 * \param tokens - The classified arguments.
+	 * \param i - The index of the token being processed.
+	 */
+	LazyValueState< std::vector<T> >& _resultState( ParseResult& result,
+	                                                const ArgTokenList& tokens,
+	                                                int i ) const;
+
+	/**
+	 * Adds a value given on the command line to the state of this
+	 * argument, converted or, if the result converts lazily, as it was
+	 * given.
+	 * \param result - The outcome of the parse so far.
+	 * \param state - The state of this argument in the result.
+	 * \param s - The characters given, NUL terminated.
+	 * \param length - The number of characters.
+	 */
+	void _addValue( ParseResult& result,
+	                LazyValueState< std::vector<T> >& state,
+	                const char* s, std::size_t length ) const;
+
+	/**
+	 * Converts the values given on the command line that are still
+	 * pending and appends them to the values, throwing an ArgException
+	 * if one is invalid.  If one is invalid it and those after it stay
+	 * pending, so reading them again fails again.
+	 * \param values - Where the values are added.
+	 * \param pending - The values given that haven't been converted.
+	 */
+	void _convertPending( std::vector<T>& values,
+	                      std::vector<std::string>& pending ) const;
+
+	/**
+	 * Converts the values given on the command line that are still
+	 * pending, recording the error if one is invalid.  See above.
+	 * \param values - Where the values are added.
+	 * \param pending - The values given that haven't been converted.
+	 * \param errors - Where an error is recorded.
+	 */
+	bool _convertPending( std::vector<T>& values,
+	                      std::vector<std::string>& pending,
+	                      ParseResult& errors ) const;
+
+	/**
+	 * The number of tokens from the given one on that may give this
+	 * argument a value, used to reserve room for the values.  These
+	 * are the occurrences the CmdLine counted, if any.
+	 * \param result - The outcome of the parse so far.
+	 * \param tokens - The classified arguments.
+	 * \param i - The index of the first token.
+	 */
+	virtual std::size_t _countValues( const ParseResult& result,
+	                                  const ArgTokenList& tokens,
+	                                  int i ) const;
+
 	/**
 	 * Used by XorHandler to decide whether to keep parsing for this arg.
 	 */
 	bool _allowMore;
 
+	/**
+	 * The character that separates the items of a list of values, or
+	 * '\0' if each value is a single value.
+	 */
+	char _listSeparator;
+
+	/**
+	 * Returned by getValue(const ParseResult&) when the argument
+	 * wasn't matched.
+	 */
+	std::vector<T> _noValues;
+
 public:
 
 	/**
@@ -184,23 +328,71 @@ public:
 	 */
 	virtual bool processArg(int* i, std::vector<std::string>& args); 
 
+	/**
+	 * Handles the processing of a classified argument.
+	 * Adds the value following the delimiter or the next argument to
+	 * the values of the argument.
+	 * \param i - Pointer the the current argument in the list.
+	 * \param tokens - The classified arguments.
+	 * \param result - The outcome of the parse so far.
+	 */
+	virtual bool processToken(int* i, ArgTokenList& tokens,
+	                          ParseResult& result) const;
+
+	/**
+	 * Sets the _values of the argument to the values that were read.
+	 * \param result - The outcome of the parse.
+	 */
+	virtual void storeResult(ParseResult& result);
+
 	/**
 	 * Returns a vector of type T containing the values parsed from
-	 * the command line.
+	 * the command line.  Values that are converted lazily are converted
+	 * now, which throws an ArgException if one is invalid.
+	 */
+	const std::vector<T>& getValue() const;
+
+	/**
+	 * Returns the values read in a parse.  See above.
+	 * \param result - The outcome of the parse.
 	 */
-	const std::vector<T>& getValue() const { return _values; }
+	const std::vector<T>& getValue(const ParseResult& result) const;
 
 	/**
 	 * Returns an iterator over the values parsed from the command
 	 * line.
 	 */
-	const_iterator begin() const { return _values.begin(); }
+	const_iterator begin() const { return getValue().begin(); }
 
 	/**
 	 * Returns the end of the values parsed from the command
 	 * line.
 	 */
-	const_iterator end() const { return _values.end(); }
+	const_iterator end() const { return getValue().end(); }
+
+	/**
+	 * Converts the values stored in this Arg that are pending.
+	 */
+	virtual void validate();
+
+	/**
+	 * Converts the values recorded in the result that are pending.
+	 * \param result - The outcome of the parse.
+	 */
+	virtual void validate(const ParseResult& result) const;
+
+	/**
+	 * Converts the values recorded in the result that are pending,
+	 * recording the error in the result if one is invalid.
+	 * \param result - The outcome of the parse.
+	 */
+	virtual bool tryValidate(ParseResult& result) const;
+
+	/**
+	 * Describes the constraint the given value doesn't meet.
+	 * \param value - The value, or the item of a list, as it was given.
+	 */
+	virtual std::string constraintFailure(const std::string& value) const;
 
 	/**
 	 * Returns the a short id string.  Used in the usage. 
@@ -224,7 +416,88 @@ public:
 	
 	virtual void reset();
 
+	/**
+	 * Makes each value given for the argument a list of values, e.g.
+	 * "--ids 17,42,99" with ','.  Empty items are kept in a list of
+	 * strings and invalid in a list of numbers.  Numbers are read
+	 * straight from the list, without a string for each item.
+	 * \param separator - The character that separates the items, '\0'
+	 * to take each value as a single value, which is the default.
+	 */
+	void setListSeparator( char separator );
+
+	char getListSeparator() const;
+
 private:
+
+	/**
+	 * Reads a number from an item of a list, without copying it unless
+	 * it is invalid.  Returns why it can't be read, if it can't.
+	 */
+	static ParseResult::ErrorCode _extractItem( T& value, const char* begin,
+	                                            const char* end,
+	                                            NumberLike nl );
+
+	/**
+	 * Assigns a string from an item, without a temporary copy.
+	 */
+	static ParseResult::ErrorCode _extractItem( T& value, const char* begin,
+	                                            const char* end,
+	                                            StringLike sl );
+
+	/**
+	 * Reads any other value from an item of a list.
+	 */
+	template<class Category>
+	static ParseResult::ErrorCode _extractItem( T& value, const char* begin,
+	                                            const char* end,
+	                                            Category c );
+
+	/**
+	 * Whether an empty item can't be read, true for numbers.
+	 */
+	static bool _rejectsEmpty( NumberLike nl );
+
+	template<class Category>
+	static bool _rejectsEmpty( Category c );
+
+	static void _assignString( std::string& value, const char* begin,
+	                           const char* end );
+
+	template<class U>
+	static void _assignString( U& value, const char* begin,
+	                           const char* end );
+
+	/**
+	 * Appends a value, moving rather than copying it where that is
+	 * possible.  The value is left unspecified.
+	 */
+	static void _moveBack( std::vector<std::string>& values,
+	                       std::string& value );
+
+	template<class U>
+	static void _moveBack( std::vector<U>& values, U& value );
+
+	/**
+	 * Checks the values from first on against the constraint and
+	 * returns the index, counted from first, of the first that fails.
+	 * A vector of bool doesn't store an array, so its values are
+	 * checked one at a time.
+	 */
+	static std::size_t _checkAll( const Constraint<bool>& constraint,
+	                              const std::vector<bool>& values,
+	                              std::size_t first );
+
+	template<class U>
+	static std::size_t _checkAll( const Constraint<U>& constraint,
+	                              const std::vector<U>& values,
+	                              std::size_t first );
+
+	/**
+	 * The type description shown in the usage, which shows a list.
+	 */
+	std::string _usageTypeDesc() const;
+
 	/**
 	 * Prevent accidental copying
 	 */
@@ -242,9 +515,12 @@ MultiArg<T>::MultiArg(const std::string& flag,
                       Visitor* v) :
    Arg( flag, name, desc, req, true, v ),
   _values(std::vector<T>()),
+  _pending(),
   _typeDesc( typeDesc ),
   _constraint( NULL ),
-  _allowMore(false)
+  _allowMore(false),
+  _listSeparator('\0'),
+  _noValues()
 { 
 	_acceptsMultipleValues = true;
 }
@@ -259,12 +535,15 @@ MultiArg<T>::MultiArg(const std::string& flag,
                       Visitor* v)
 : Arg( flag, name, desc, req, true, v ),
   _values(std::vector<T>()),
+  _pending(),
   _typeDesc( typeDesc ),
   _constraint( NULL ),
-  _allowMore(false)
+  _allowMore(false),
+  _listSeparator('\0'),
+  _noValues()
 { 
-	parser.add( this );
 	_acceptsMultipleValues = true;
+	parser.add( this );
 }
 
 /**
@@ -279,9 +558,12 @@ MultiArg<T>::MultiArg(const std::string& flag,
                       Visitor* v)
 : Arg( flag, name, desc, req, true, v ),
   _values(std::vector<T>()),
+  _pending(),
   _typeDesc( Constraint<T>::shortID(constraint) ),
   _constraint( constraint ),
-  _allowMore(false)
+  _allowMore(false),
+  _listSeparator('\0'),
+  _noValues()
 { 
 	_acceptsMultipleValues = true;
 }
@@ -296,47 +578,55 @@ MultiArg<T>::MultiArg(const std::string& flag,
                       Visitor* v)
 : Arg( flag, name, desc, req, true, v ),
   _values(std::vector<T>()),
+  _pending(),
   _typeDesc( Constraint<T>::shortID(constraint) ),
   _constraint( constraint ),
-  _allowMore(false)
+  _allowMore(false),
+  _listSeparator('\0'),
+  _noValues()
 { 
-	parser.add( this );
 	_acceptsMultipleValues = true;
+	parser.add( this );
 }
 
 template<class T>
 bool MultiArg<T>::processArg(int *i, std::vector<std::string>& args) 
 {
- 	if ( _ignoreable && Arg::ignoreRest() )
-		return false;
+	return Arg::processArg( i, args );
+}
 
-	if ( _hasBlanks( args[*i] ) )
+template<class T>
+bool MultiArg<T>::processToken(int *i, ArgTokenList& tokens,
+                               ParseResult& result) const
+{
+ 	if ( _ignoreable && result.ignoreRest() )
 		return false;
 
-	std::string flag = args[*i];
-	std::string value = "";
+	const ArgToken& token = tokens[*i];
 
-   	trimFlag( flag, value );
-
-   	if ( argMatches( flag ) )
+   	if ( tokenMatches( token ) )
    	{
-   		if ( Arg::delimiter() != ' ' && value == "" )
-			throw( ArgParseException( 
-			           "Couldn't find delimiter for this argument!",
-					   toString() ) );
+   		if ( _delimiter != ' ' && token.valueLength() == 0 )
+		{
+			result.setError( ParseResult::MISSING_DELIMITER, this );
+			return true;
+		}
+
+		LazyValueState< std::vector<T> >& state =
+			_resultState( result, tokens, *i );
 
 		// always take the first one, regardless of start string
-		if ( value == "" )
+		if ( token.valueLength() == 0 )
 		{
 			(*i)++;
-			if ( static_cast<unsigned int>(*i) < args.size() )
-				_extractValue( args[*i] );
+			if ( static_cast<unsigned int>(*i) < tokens.size() )
+				_addValue( result, state, tokens[*i].c_str(),
+				           tokens[*i].length() );
 			else
-				throw( ArgParseException("Missing a value for this argument!",
-                                         toString() ) );
+				result.setError( ParseResult::MISSING_VALUE, this );
 		} 
 		else
-			_extractValue( value );
+			_addValue( result, state, token.value(), token.valueLength() );
 
 		/*
 		// continuing taking the args until we hit one with a start string 
@@ -346,8 +636,7 @@ bool MultiArg<T>::processArg(int *i, std::vector<std::string>& args)
 				_extractValue( args[++(*i)] );
 		*/
 
-		_alreadySet = true;
-		_checkWithVisitor();
+		_checkWithVisitor( result );
 
 		return true;
 	}
@@ -355,6 +644,85 @@ bool MultiArg<T>::processArg(int *i, std::vector<std::string>& args)
 		return false;
 }
 
+template<class T>
+void MultiArg<T>::storeResult(ParseResult& result)
+{
+	Arg::storeResult( result );
+
+	ArgState* state = result.getState( _stateIndex( result ) );
+	if ( state != NULL )
+	{
+		LazyValueState< std::vector<T> >* s =
+			static_cast<LazyValueState< std::vector<T> >*>(state);
+		_values.swap( s->value );
+		_pending.swap( s->pending );
+	}
+}
+
+template<class T>
+const std::vector<T>& MultiArg<T>::getValue() const
+{
+	if ( !_pending.empty() )
+	{
+		MultiArg<T>* self = const_cast<MultiArg<T>*>(this);
+		_convertPending( self->_values, self->_pending );
+	}
+
+	return _values;
+}
+
+template<class T>
+const std::vector<T>& MultiArg<T>::getValue(const ParseResult& result) const
+{
+	ArgState* state = result.getState( _stateIndex( result ) );
+	if ( state != NULL )
+	{
+		LazyValueState< std::vector<T> >* s =
+			static_cast<LazyValueState< std::vector<T> >*>(state);
+		_convertPending( s->value, s->pending );
+		return s->value;
+	}
+	else
+		return _noValues;
+}
+
+template<class T>
+void MultiArg<T>::validate()
+{
+	_convertPending( _values, _pending );
+}
+
+template<class T>
+void MultiArg<T>::validate(const ParseResult& result) const
+{
+	getValue( result );
+}
+
+template<class T>
+bool MultiArg<T>::tryValidate(ParseResult& result) const
+{
+	ArgState* state = result.getState( _stateIndex( result ) );
+	if ( state == NULL )
+		return true;
+
+	LazyValueState< std::vector<T> >* s =
+		static_cast<LazyValueState< std::vector<T> >*>(state);
+	return _convertPending( s->value, s->pending, result );
+}
+
+template<class T>
+std::string MultiArg<T>::constraintFailure(const std::string& value) const
+{
+	if ( _constraint == NULL )
+		return "";
+
+	// read again, only when the message is put together
+	T v = T();
+	_extractItem( v, value.c_str(), value.c_str() + value.length(),
+	              typename ArgTraits<T>::ValueCategory() );
+	return _constraint->failureDescription( v );
+}
+
 /**
  *
  */
@@ -362,7 +730,7 @@ template<class T>
 std::string MultiArg<T>::shortID(const std::string& val) const
 {
 	static_cast<void>(val); // Ignore input, don't warn
-	return Arg::shortID(_typeDesc) + " ...";
+	return Arg::shortID(_usageTypeDesc()) + " ...";
 }
 
 /**
@@ -372,7 +740,16 @@ template<class T>
 std::string MultiArg<T>::longID(const std::string& val) const
 {
 	static_cast<void>(val); // Ignore input, don't warn
-	return Arg::longID(_typeDesc) + "  (accepted multiple times)";
+	return Arg::longID(_usageTypeDesc()) + "  (accepted multiple times)";
+}
+
+template<class T>
+std::string MultiArg<T>::_usageTypeDesc() const
+{
+	if ( _listSeparator == '\0' )
+		return _typeDesc;
+	else
+		return _typeDesc + _listSeparator + "...";
 }
 
 /**
@@ -397,22 +774,386 @@ bool MultiArg<T>::isRequired() const
 template<class T>
 void MultiArg<T>::_extractValue( const std::string& val ) 
 {
-    try {
-	T tmp;
-	ExtractValue(tmp, val, typename ArgTraits<T>::ValueCategory());
-	_values.push_back(tmp);
-    } catch( ArgParseException &e) {
-	throw ArgParseException(e.error(), toString());
-    }
+	_extractValue( _values, val );
+}
+
+template<class T>
+void MultiArg<T>::_extractValue( ParseResult& result,
+                                 const std::string& val ) const
+{
+	_addValue( result, _resultState( result, 1 ), val.c_str(),
+	           val.length() );
+}
 
-    if ( _constraint != NULL )
-	if ( ! _constraint->check( _values.back() ) )
-	    throw( CmdLineParseException( "Value '" + val +
-					  "' does not meet constraint: " +
-					  _constraint->description(), 
-					  toString() ) );
+template<class T>
+LazyValueState< std::vector<T> >&
+MultiArg<T>::_resultState( ParseResult& result, const ArgTokenList& tokens,
+                           int i ) const
+{
+	ArgState* state = result.getState( _stateIndex( result ) );
+	if ( state != NULL )
+		return *static_cast<LazyValueState< std::vector<T> >*>(state);
+
+	return _resultState( result, _countValues( result, tokens, i ) );
 }
-		
+
+template<class T>
+LazyValueState< std::vector<T> >&
+MultiArg<T>::_resultState( ParseResult& result, std::size_t expected ) const
+{
+	const std::size_t index = _stateIndex( result );
+	ArgState* state = result.getState( index );
+	if ( state != NULL )
+		return *static_cast<LazyValueState< std::vector<T> >*>(state);
+
+	// the state of an earlier parse is reset rather than allocated again,
+	// keeping the capacity of its vectors
+	LazyValueState< std::vector<T> >* s =
+		static_cast<LazyValueState< std::vector<T> >*>(
+			result.getSpareState( index, this ) );
+	if ( s == NULL )
+	{
+		s = result.continuesArgs()
+			? new LazyValueState< std::vector<T> >( _values, _pending )
+			: new LazyValueState< std::vector<T> >(
+				_noValues, std::vector<std::string>() );
+		s->arg = this;
+	}
+	else if ( result.continuesArgs() )
+	{
+		s->value = _values;
+		s->pending = _pending;
+	}
+	else
+	{
+		s->value.clear();
+		s->pending.clear();
+	}
+	result.setState( index, s );
+
+	if ( result.convertsLazily() )
+		s->pending.reserve( s->pending.size() + expected );
+	else
+		s->value.reserve( s->value.size() + expected );
+
+	return *s;
+}
+
+template<class T>
+void MultiArg<T>::_addValue( ParseResult& result,
+                             LazyValueState< std::vector<T> >& state,
+                             const char* s, std::size_t length ) const
+{
+	if ( result.convertsLazily() )
+	{
+		state.pending.push_back( std::string( s, length ) );
+		return;
+	}
+
+	// the values given before come first
+	if ( _convertPending( state.value, state.pending, result ) )
+		_appendValue( state.value, s, length, result );
+}
+
+template<class T>
+void MultiArg<T>::_convertPending( std::vector<T>& values,
+                                   std::vector<std::string>& pending ) const
+{
+	if ( pending.empty() )
+		return;
+
+	ParseResult errors;
+	if ( !_convertPending( values, pending, errors ) )
+		errors.throwError();
+}
+
+template<class T>
+bool MultiArg<T>::_convertPending( std::vector<T>& values,
+                                   std::vector<std::string>& pending,
+                                   ParseResult& errors ) const
+{
+	if ( pending.empty() )
+		return true;
+
+	values.reserve( values.size() + pending.size() );
+
+	for ( std::size_t k = 0; k < pending.size(); k++ )
+		if ( !_appendValue( values, pending[k].c_str(), pending[k].length(),
+		                    errors ) )
+		{
+			pending.erase( pending.begin(), pending.begin() + k );
+			return false;
+		}
+
+	pending.clear();
+	return true;
+}
+
+template<class T>
+std::size_t MultiArg<T>::_countValues( const ParseResult& result,
+                                       const ArgTokenList& tokens,
+                                       int i ) const
+{
+	static_cast<void>(tokens); // Ignore input, don't warn
+	static_cast<void>(i);
+	return result.getOccurrences( _stateIndex( result ) );
+}
+
+template<class T>
+void MultiArg<T>::_extractValue( std::vector<T>& values,
+                                 const std::string& val ) const
+{
+	ParseResult errors;
+	if ( !_appendValue( values, val.c_str(), val.length(), errors ) )
+		errors.throwError();
+}
+
+template<class T>
+bool MultiArg<T>::_appendValue( std::vector<T>& values, const char* s,
+                                std::size_t length,
+                                ParseResult& errors ) const
+{
+	if ( _listSeparator != '\0' )
+		return _appendList( values, s, s + length, errors );
+
+	T value = T();
+	if ( !_extract( value, s, s + length, errors ) )
+		return false;
+
+	if ( _constraint != NULL && !_constraint->check( value ) )
+	{
+		errors.setError( ParseResult::CONSTRAINT_FAILED, this, s, length );
+		return false;
+	}
+
+	_moveBack( values, value );
+	return true;
+}
+
+template<class T>
+bool MultiArg<T>::_extract( T& value, const char* begin, const char* end,
+                            ParseResult& errors ) const
+{
+	ParseResult::ErrorCode code;
+#if TCLAP_HAS_EXCEPTIONS
+	try {
+		code = _extractItem( value, begin, end,
+		                     typename ArgTraits<T>::ValueCategory() );
+	} catch ( ArgParseException& e ) {
+		// thrown by the operator>> of T
+		errors.setError( ParseResult::INVALID_VALUE, this, begin,
+		                 static_cast<std::size_t>(end - begin) );
+		errors.setErrorText( e.error() );
+		return false;
+	}
+#else
+	code = _extractItem( value, begin, end,
+	                     typename ArgTraits<T>::ValueCategory() );
+#endif
+
+	if ( code == ParseResult::NO_PARSE_ERROR )
+		return true;
+
+	errors.setError( code, this, begin,
+	                 static_cast<std::size_t>(end - begin) );
+	return false;
+}
+
+template<class T>
+bool MultiArg<T>::_appendList( std::vector<T>& values, const char* s,
+                               const char* end, ParseResult& errors ) const
+{
+	const std::size_t first = values.size();
+
+	// the separators are found with memchr, which is vectorized in the
+	// common C libraries.  Counting them first means the values are
+	// only allocated once, but growing at least twofold keeps many
+	// lists from reallocating for each.
+	std::size_t items = 1;
+	for ( const char* p = s;
+	      ( p = static_cast<const char*>(
+	              std::memchr( p, _listSeparator, end - p ) ) ) != NULL;
+	      p++ )
+		items++;
+	if ( values.capacity() < first + items )
+		values.reserve( std::max( first + items, 2 * values.capacity() ) );
+
+	for ( const char* p = s; p <= end; )
+	{
+		const char* sep = static_cast<const char*>(
+			std::memchr( p, _listSeparator, end - p ) );
+		if ( sep == NULL )
+			sep = end;
+
+		// an empty string is kept, but the stream would read an empty
+		// number as 0
+		T value = T();
+		if ( sep == p &&
+		     _rejectsEmpty( typename ArgTraits<T>::ValueCategory() ) )
+		{
+			errors.setError( ParseResult::INVALID_VALUE, this, p, 0 );
+			values.erase( values.begin() + first, values.end() );
+			return false;
+		}
+
+		if ( !_extract( value, p, sep, errors ) )
+		{
+			values.erase( values.begin() + first, values.end() );
+			return false;
+		}
+		_moveBack( values, value );
+		p = sep + 1;
+	}
+
+	const std::size_t count = values.size() - first;
+	if ( _constraint == NULL || count == 0 )
+		return true;
+
+	const std::size_t bad = _checkAll( *_constraint, values, first );
+	if ( bad >= count )
+		return true;
+
+	// find the item again for the message
+	const char* p = s;
+	const char* sep = s;
+	for ( std::size_t n = 0; ; p = sep + 1 )
+	{
+		sep = static_cast<const char*>(
+			std::memchr( p, _listSeparator, end - p ) );
+		if ( sep == NULL )
+			sep = end;
+
+		if ( n++ == bad )
+			break;
+	}
+
+	values.erase( values.begin() + first, values.end() );
+	errors.setError( ParseResult::CONSTRAINT_FAILED, this, p,
+	                 static_cast<std::size_t>(sep - p) );
+	return false;
+}
+
+template<class T>
+ParseResult::ErrorCode MultiArg<T>::_extractItem( T& value,
+                                                  const char* begin,
+                                                  const char* end,
+                                                  NumberLike nl )
+{
+	const char* p = begin;
+	if ( ReadNumber( p, value ) && p == end )
+		return ParseResult::NO_PARSE_ERROR;
+
+	// not a number by itself, the stream's error is given
+	return TryExtractValue( value, std::string( begin, end ), nl );
+}
+
+template<class T>
+ParseResult::ErrorCode MultiArg<T>::_extractItem( T& value,
+                                                  const char* begin,
+                                                  const char* end,
+                                                  StringLike sl )
+{
+	static_cast<void>(sl); // Ignore input, don't warn
+	_assignString( value, begin, end );
+	return ParseResult::NO_PARSE_ERROR;
+}
+
+template<class T>
+template<class Category>
+ParseResult::ErrorCode MultiArg<T>::_extractItem( T& value,
+                                                  const char* begin,
+                                                  const char* end,
+                                                  Category c )
+{
+	return TryExtractValue( value, std::string( begin, end ), c );
+}
+
+template<class T>
+bool MultiArg<T>::_rejectsEmpty( NumberLike nl )
+{
+	static_cast<void>(nl); // Ignore input, don't warn
+	return true;
+}
+
+template<class T>
+template<class Category>
+bool MultiArg<T>::_rejectsEmpty( Category c )
+{
+	static_cast<void>(c); // Ignore input, don't warn
+	return false;
+}
+
+template<class T>
+void MultiArg<T>::_assignString( std::string& value, const char* begin,
+                                 const char* end )
+{
+	value.assign( begin, end );
+}
+
+template<class T>
+template<class U>
+void MultiArg<T>::_assignString( U& value, const char* begin,
+                                 const char* end )
+{
+	SetString( value, std::string( begin, end ) );
+}
+
+template<class T>
+void MultiArg<T>::_moveBack( std::vector<std::string>& values,
+                             std::string& value )
+{
+#if __cplusplus >= 201103L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201103L)
+	values.push_back( std::move( value ) );
+#else
+	// an empty string doesn't allocate, swapping hands over the storage
+	values.push_back( std::string() );
+	values.back().swap( value );
+#endif
+}
+
+template<class T>
+template<class U>
+void MultiArg<T>::_moveBack( std::vector<U>& values, U& value )
+{
+#if __cplusplus >= 201103L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201103L)
+	values.push_back( std::move( value ) );
+#else
+	values.push_back( value );
+#endif
+}
+
+template<class T>
+std::size_t MultiArg<T>::_checkAll( const Constraint<bool>& constraint,
+                                    const std::vector<bool>& values,
+                                    std::size_t first )
+{
+	for ( std::size_t i = first; i < values.size(); i++ )
+		if ( !constraint.check( values[i] ) )
+			return i - first;
+	return values.size() - first;
+}
+
+template<class T>
+template<class U>
+std::size_t MultiArg<T>::_checkAll( const Constraint<U>& constraint,
+                                    const std::vector<U>& values,
+                                    std::size_t first )
+{
+	return constraint.checkAll( &values[first], values.size() - first );
+}
+
+template<class T>
+void MultiArg<T>::setListSeparator( char separator )
+{
+	_listSeparator = separator;
+}
+
+template<class T>
+char MultiArg<T>::getListSeparator() const
+{
+	return _listSeparator;
+}
+
 template<class T>
 bool MultiArg<T>::allowMore()
 {
@@ -426,6 +1167,7 @@ void MultiArg<T>::reset()
 {
 	Arg::reset();
 	_values.clear();
+	_pending.clear();
 }
 
 } // namespace TCLAP
@@ -108,11 +108,51 @@ class MultiSwitchArg : public SwitchArg
 		 */
 		virtual bool processArg(int* i, std::vector<std::string>& args); 
 
+		/**
+		 * Handles the processing of a classified argument.
+		 * Increments the count of the argument for the flag or name.
+		 * \param i - Pointer the the current argument in the list.
+		 * \param tokens - The classified arguments.
+		 * \param result - The outcome of the parse so far.
+		 */
+		virtual bool processToken(int* i, ArgTokenList& tokens,
+		                          ParseResult& result) const;
+
+		/**
+		 * Increments the count of the argument for every time the flag
+		 * appears among combined switches.
+		 * \param count - The number of times the flag appears.
+		 * \param result - The outcome of the parse so far.
+		 */
+		virtual bool processCombinedFlag(std::size_t count,
+		                                 ParseResult& result) const;
+
+		/**
+		 * Finds no error, the flag may appear any number of times.
+		 * \param count - The number of times the flag appears.
+		 * \param result - The outcome of the parse so far.
+		 */
+		virtual void checkCombinedFlag(std::size_t count,
+		                               ParseResult& result) const;
+
+		/**
+		 * Sets the _value of the argument to the count.
+		 * \param result - The outcome of the parse.
+		 */
+		virtual void storeResult(ParseResult& result);
+
 		/**
 		 * Returns int, the number of times the switch has been set.
 		 */
 		int getValue() const { return _value; }
 
+		/**
+		 * Returns the initial value plus the number of times the switch
+		 * was set in a parse.
+		 * \param result - The outcome of the parse.
+		 */
+		int getValue(const ParseResult& result) const;
+
 		/**
 		 * Returns the shortID for this Arg.
 		 */
@@ -122,9 +162,22 @@ class MultiSwitchArg : public SwitchArg
 		 * Returns the longID for this Arg.
 		 */
 		std::string longID(const std::string& val) const;
+
+		/**
+		 * A MultiSwitchArg counts each time it is given.
+		 */
+		virtual bool isRepeatable() const { return true; }
 		
 		void reset();
 
+	private:
+
+		/**
+		 * Adds to the count of the argument in the result.
+		 * \param result - The outcome of the parse so far.
+		 * \param n - The number of times the switch appears.
+		 */
+		void _increment(ParseResult& result, int n) const;
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -155,39 +208,89 @@ _default( init )
 
 inline bool MultiSwitchArg::processArg(int *i, std::vector<std::string>& args)
 {
-	if ( _ignoreable && Arg::ignoreRest() )
+	return Arg::processArg( i, args );
+}
+
+inline bool MultiSwitchArg::processToken(int *i, ArgTokenList& tokens,
+                                         ParseResult& result) const
+{
+	if ( _ignoreable && result.ignoreRest() )
 		return false;
 
-	if ( argMatches( args[*i] ))
-	{
-		// so the isSet() method will work
-		_alreadySet = true;
+	const ArgToken& token = tokens[*i];
 
+	if ( !token.hasValue() && tokenMatches( token ) )
+	{
 		// Matched argument: increment value.
-		++_value;
+		_increment( result, 1 );
 
-		_checkWithVisitor();
+		_checkWithVisitor( result );
 
 		return true;
 	}
-	else if ( combinedSwitchesMatch( args[*i] ) )
-	{
-		// so the isSet() method will work
-		_alreadySet = true;
+	else
+		return false;
+}
 
-		// Matched argument: increment value.
-		++_value;
+inline bool MultiSwitchArg::processCombinedFlag(std::size_t count,
+                                                ParseResult& result) const
+{
+	if ( _ignoreable && result.ignoreRest() )
+		return false;
 
-		// Check for more in argument and increment value.
-		while ( combinedSwitchesMatch( args[*i] ) ) 
-			++_value;
+	// Matched argument: increment value for each occurrence.
+	_increment( result, static_cast<int>(count) );
 
-		_checkWithVisitor();
+	_checkWithVisitor( result );
 
-		return false;
+	return true;
+}
+
+inline void MultiSwitchArg::checkCombinedFlag(std::size_t count,
+                                              ParseResult& result) const
+{
+	Arg::checkCombinedFlag( count, result );
+}
+
+inline void MultiSwitchArg::_increment(ParseResult& result, int n) const
+{
+	const std::size_t index = _stateIndex( result );
+	ArgState* state = result.getState( index );
+	if ( state == NULL )
+	{
+		const int value = result.continuesArgs() ? _value : _default;
+
+		// the state of an earlier parse is reset rather than allocated
+		state = result.getSpareState( index, this );
+		if ( state != NULL )
+			static_cast<ValueState<int>*>(state)->value = value;
+		else
+		{
+			state = new ValueState<int>( value );
+			state->arg = this;
+		}
+		result.setState( index, state );
 	}
+
+	static_cast<ValueState<int>*>(state)->value += n;
+}
+
+inline void MultiSwitchArg::storeResult(ParseResult& result)
+{
+	Arg::storeResult( result );
+
+	const ArgState* state = result.getState( _stateIndex( result ) );
+	if ( state != NULL )
+		_value = static_cast<const ValueState<int>*>(state)->value;
+}
+
+inline int MultiSwitchArg::getValue(const ParseResult& result) const
+{
+	const ArgState* state = result.getState( _stateIndex( result ) );
+	if ( state != NULL )
+		return static_cast<const ValueState<int>*>(state)->value;
 	else
-		return false;
+		return _default;
 }
 
 inline std::string 
@@ -0,0 +1,152 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+/******************************************************************************
+ *
+ *  file:  Mutex.h
+ *
+ *  Copyright (c) 2018, Google LLC
+ *  All rights reserved.
+ *
+ *  See the file COPYING in the top directory of this distribution for
+ *  more information.
+ *
+ *  THE SOFTWARE IS PROVIDED _AS IS_, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ *  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *  DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef TCLAP_MUTEX_H
+#define TCLAP_MUTEX_H
+
+// Locks with std::mutex where it is available, with POSIX threads
+// otherwise, and not at all if neither is.  Define TCLAP_NO_THREADS to
+// never lock, as for BatchParser.
+#if !defined(TCLAP_NO_THREADS)
+#if __cplusplus >= 201103L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201103L)
+#define TCLAP_STD_MUTEX
+#include <mutex>
+#elif defined(HAVE_PTHREAD_H) || defined(__unix__) || defined(__APPLE__)
+#define TCLAP_POSIX_MUTEX
+#include <pthread.h>
+#endif
+#endif
+
+namespace TCLAP {
+
+/**
+ * A mutex for the state an object shares between the threads that parse
+ * with one CmdLine, e.g. the usage StdOutput keeps.  Does nothing if
+ * there are no threads.
+ */
+class Mutex
+{
+	public:
+
+		Mutex();
+
+		~Mutex();
+
+		void lock();
+
+		void unlock();
+
+	private:
+
+		/**
+		 * Prevent accidental copying.
+		 */
+		Mutex( const Mutex& rhs );
+		Mutex& operator=( const Mutex& rhs );
+
+#if defined(TCLAP_STD_MUTEX)
+		std::mutex _mutex;
+#elif defined(TCLAP_POSIX_MUTEX)
+		pthread_mutex_t _mutex;
+#endif
+};
+
+/**
+ * Holds a Mutex locked for as long as it lives.
+ */
+class MutexLock
+{
+	public:
+
+		/**
+		 * Locks the mutex.
+		 * \param mutex - The mutex, unlocked again by the destructor.
+		 */
+		explicit MutexLock( Mutex& mutex );
+
+		~MutexLock();
+
+	private:
+
+		/**
+		 * Prevent accidental copying.
+		 */
+		MutexLock( const MutexLock& rhs );
+		MutexLock& operator=( const MutexLock& rhs );
+
+		Mutex& _mutex;
+};
+
+//////////////////////////////////////////////////////////////////////
+//BEGIN Mutex.cpp
+//////////////////////////////////////////////////////////////////////
+
+#if defined(TCLAP_STD_MUTEX)
+
+inline Mutex::Mutex() : _mutex() { }
+
+inline Mutex::~Mutex() { }
+
+inline void Mutex::lock() { _mutex.lock(); }
+
+inline void Mutex::unlock() { _mutex.unlock(); }
+
+#elif defined(TCLAP_POSIX_MUTEX)
+
+inline Mutex::Mutex() : _mutex() { pthread_mutex_init( &_mutex, NULL ); }
+
+inline Mutex::~Mutex() { pthread_mutex_destroy( &_mutex ); }
+
+inline void Mutex::lock() { pthread_mutex_lock( &_mutex ); }
+
+inline void Mutex::unlock() { pthread_mutex_unlock( &_mutex ); }
+
+#else
+
+inline Mutex::Mutex() { }
+
+inline Mutex::~Mutex() { }
+
+inline void Mutex::lock() { }
+
+inline void Mutex::unlock() { }
+
+#endif
+
+inline MutexLock::MutexLock( Mutex& mutex )
+: _mutex( mutex )
+{
+	_mutex.lock();
+}
+
+inline MutexLock::~MutexLock()
+{
+	_mutex.unlock();
+}
+
+//////////////////////////////////////////////////////////////////////
+//END Mutex.cpp
+//////////////////////////////////////////////////////////////////////
+
+} //namespace TCLAP
+
+#endif
@@ -0,0 +1,299 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+/******************************************************************************
+ *
+ *  file:  NumberParser.h
+ *
+ *  Copyright (c) 2018, Google LLC
+ *  All rights reserved.
+ *
+ *  See the file COPYING in the top directory of this distribution for
+ *  more information.
+ *
+ *  THE SOFTWARE IS PROVIDED _AS IS_, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ *  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *  DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+// This is an internal tclap file, you should probably not have to
+// include this directly
+
+#ifndef TCLAP_NUMBER_PARSER_H
+#define TCLAP_NUMBER_PARSER_H
+
+#ifdef HAVE_CONFIG_H
+#include <config.h> // To check for long long
+#endif
+
+#include <string>
+#include <limits>
+#include <clocale>
+#include <cstring>
+#include <stdlib.h>
+
+namespace TCLAP {
+
+// The functions below read a single number the way operator>> of a
+// stream with the classic locale does, i.e. they accept and reject the
+// same strings and give the same values, but without constructing a
+// stream or consulting the locale.  Each skips leading white space,
+// reads as much as the stream would and returns false if that isn't a
+// valid number.  The value is only assigned on success.
+
+// long long is only standard since C++11, for C++98 configure finds out
+// whether the compiler has it
+#if ( defined(HAVE_LONG_LONG) && HAVE_LONG_LONG ) || \
+    __cplusplus >= 201103L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201103L)
+#define TCLAP_HAS_LONG_LONG
+#endif
+
+#ifdef TCLAP_HAS_LONG_LONG
+typedef unsigned long long NumberMagnitude;
+#else
+typedef unsigned long NumberMagnitude;
+#endif
+
+inline bool IsNumberSpace( char c )
+{
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r' ||
+	       c == '\v' || c == '\f';
+}
+
+/**
+ * Reads the sign and digits of an integer.  The base is 10, or given by
+ * a "0x" or "0" prefix if TCLAP_SETBASE_ZERO is defined.
+ * \param p - Where to start, set to the first character not read.
+ * \param negative - Set to whether there was a minus sign.
+ * \param magnitude - Set to the absolute value.
+ * \param max - The largest magnitude accepted.
+ */
+inline bool ReadMagnitude( const char*& p, bool& negative,
+                           NumberMagnitude& magnitude, NumberMagnitude max )
+{
+	while ( IsNumberSpace( *p ) )
+		p++;
+
+	negative = *p == '-';
+	if ( *p == '-' || *p == '+' )
+		p++;
+
+	unsigned int base = 10;
+	bool found = false;
+#ifdef TCLAP_SETBASE_ZERO
+	if ( *p == '0' )
+	{
+		// "0x" needs hex digits to follow, a lone "0" is a digit
+		if ( p[1] == 'x' || p[1] == 'X' )
+		{
+			base = 16;
+			p += 2;
+		}
+		else
+		{
+			base = 8;
+			found = true;
+		}
+	}
+#endif
+
+	NumberMagnitude m = 0;
+	bool overflow = false;
+	for (;; p++)
+	{
+		unsigned int d;
+		if ( *p >= '0' && *p <= '9' )
+			d = static_cast<unsigned int>(*p - '0');
+		else if ( base == 16 && *p >= 'a' && *p <= 'f' )
+			d = static_cast<unsigned int>(*p - 'a' + 10);
+		else if ( base == 16 && *p >= 'A' && *p <= 'F' )
+			d = static_cast<unsigned int>(*p - 'A' + 10);
+		else
+			break;
+
+		if ( d >= base )
+			break;
+
+		found = true;
+		if ( m > ( max - d ) / base )
+			overflow = true;
+		else
+			m = m * base + d;
+	}
+
+	magnitude = m;
+	return found && !overflow;
+}
+
+/**
+ * Reads an integer of type T, signed or unsigned.  As for a stream, a
+ * negative value given for an unsigned type wraps around.
+ */
+template<typename T>
+bool ReadNumber( const char*& p, T& value )
+{
+	const NumberMagnitude max =
+		static_cast<NumberMagnitude>(std::numeric_limits<T>::max());
+
+	bool negative;
+	NumberMagnitude m;
+	if ( std::numeric_limits<T>::is_signed )
+	{
+		// the magnitude of the minimum is one more than the maximum
+		if ( !ReadMagnitude( p, negative, m, max + 1 ) ||
+		     ( !negative && m > max ) )
+			return false;
+
+		value = negative
+			? static_cast<T>( -static_cast<T>(m - 1) - 1 )
+			: static_cast<T>(m);
+	}
+	else
+	{
+		if ( !ReadMagnitude( p, negative, m, max ) )
+			return false;
+
+		value = negative ? static_cast<T>(0 - static_cast<T>(m))
+		                 : static_cast<T>(m);
+	}
+
+	return true;
+}
+
+/**
+ * Reads a bool given as 0 or 1, as a stream does without boolalpha.
+ */
+inline bool ReadNumber( const char*& p, bool& value )
+{
+	long l;
+	if ( !ReadNumber( p, l ) || ( l != 0 && l != 1 ) )
+		return false;
+
+	value = l == 1;
+	return true;
+}
+
+/**
+ * Finds the end of a floating point number, i.e. of the characters a
+ * stream reads for one, which needn't all be valid.
+ * \param p - The start of the number, white space already skipped.
+ * \param point - Set to the decimal point, or NULL if there is none.
+ */
+inline const char* ScanFloat( const char* p, const char*& point )
+{
+	point = NULL;
+	if ( *p == '-' || *p == '+' )
+		p++;
+
+	bool digits = false;
+	for (;; p++)
+	{
+		if ( *p >= '0' && *p <= '9' )
+			digits = true;
+		else if ( *p == '.' && point == NULL )
+			point = p;
+		else
+			break;
+	}
+
+	// an exponent only follows digits
+	if ( digits && ( *p == 'e' || *p == 'E' ) )
+	{
+		p++;
+		if ( *p == '-' || *p == '+' )
+			p++;
+		while ( *p >= '0' && *p <= '9' )
+			p++;
+	}
+
+	return p;
+}
+
+/**
+ * Converts the characters of a floating point number found by ScanFloat
+ * with strtod or the like, which use the decimal point of the C locale.
+ * If that isn't '.' the number is converted from a copy that uses it.
+ * \param convert - The conversion function.
+ */
+template<typename T>
+bool ConvertFloat( const char* begin, const char* end, const char* point,
+                   T (*convert)( const char*, char** ), T& value )
+{
+	if ( begin == end )
+		return false;
+
+	char* stop;
+	T v = convert( begin, &stop );
+	if ( stop != end && point != NULL )
+	{
+		const char* localePoint = std::localeconv()->decimal_point;
+		if ( std::strlen( localePoint ) != 1 || *localePoint == '.' )
+			return false;
+
+		std::string copy( begin, end );
+		copy[point - begin] = *localePoint;
+		v = convert( copy.c_str(), &stop );
+		stop = const_cast<char*>(begin) + ( stop - copy.c_str() );
+	}
+
+	// out of range is an error, as for a stream
+	if ( stop != end || v > std::numeric_limits<T>::max() ||
+	     v < -std::numeric_limits<T>::max() )
+		return false;
+
+	value = v;
+	return true;
+}
+
+inline double StrToDouble( const char* s, char** end )
+{
+	return strtod( s, end );
+}
+
+inline float StrToFloat( const char* s, char** end )
+{
+#if __cplusplus >= 201103L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201103L)
+	return strtof( s, end );
+#else
+	// strtof isn't part of C++98, the double is narrowed, out of range
+	// as strtof gives it
+	const double v = strtod( s, end );
+	if ( v > std::numeric_limits<float>::max() )
+		return std::numeric_limits<float>::infinity();
+	if ( v < -std::numeric_limits<float>::max() )
+		return -std::numeric_limits<float>::infinity();
+	return static_cast<float>( v );
+#endif
+}
+
+inline bool ReadNumber( const char*& p, double& value )
+{
+	while ( IsNumberSpace( *p ) )
+		p++;
+
+	const char* point;
+	const char* end = ScanFloat( p, point );
+	const char* begin = p;
+	p = end;
+	return ConvertFloat( begin, end, point, &StrToDouble, value );
+}
+
+inline bool ReadNumber( const char*& p, float& value )
+{
+	while ( IsNumberSpace( *p ) )
+		p++;
+
+	const char* point;
+	const char* end = ScanFloat( p, point );
+	const char* begin = p;
+	p = end;
+	return ConvertFloat( begin, end, point, &StrToFloat, value );
+}
+
+} //namespace TCLAP
+
+#endif
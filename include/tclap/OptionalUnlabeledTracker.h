@@ -30,6 +30,11 @@
 
 namespace TCLAP {
 
+/**
+ * Tracks whether an optional unlabeled Arg has been created, for the
+ * whole program.  No longer used by the unlabeled Args, CmdLine::add()
+ * checks the order of the unlabeled Args of each CmdLine.
+ */
 class OptionalUnlabeledTracker
 {
 
@@ -50,7 +55,7 @@ class OptionalUnlabeledTracker
 inline void OptionalUnlabeledTracker::check( bool req, const std::string& argName )
 {
     if ( OptionalUnlabeledTracker::alreadyOptional() )
-        throw( SpecificationException(
+        TCLAP_THROW( SpecificationException(
 	"You can't specify ANY Unlabeled Arg following an optional Unlabeled Arg",
 	                argName ) );
 
@@ -0,0 +1,955 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+/******************************************************************************
+ *
+ *  file:  ParseResult.h
+ *
+ *  Copyright (c) 2018, Google LLC
+ *  All rights reserved.
+ *
+ *  See the file COPYING in the top directory of this distribution for
+ *  more information.
+ *
+ *  THE SOFTWARE IS PROVIDED _AS IS_, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ *  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *  DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef TCLAP_PARSE_RESULT_H
+#define TCLAP_PARSE_RESULT_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstddef>
+
+#include <tclap/ShellTokenizer.h>
+
+namespace TCLAP {
+
+class Arg;
+
+/**
+ * What a parse found for an Arg beyond the fact that it was matched.
+ * Args that store a value use a ValueState.
+ */
+class ArgState
+{
+	public:
+
+		ArgState() : arg( NULL ) { }
+
+		virtual ~ArgState() { }
+
+		/**
+		 * The Arg that made the state, the only one
+		 * ParseResult::getSpareState() gives it back to.
+		 */
+		const Arg* arg;
+
+	private:
+
+		/**
+		 * Prevent accidental copying.
+		 */
+		ArgState( const ArgState& rhs );
+		ArgState& operator=( const ArgState& rhs );
+};
+
+/**
+ * The state of an Arg that stores a value of type T, e.g. the value of a
+ * ValueArg or the values of a MultiArg.
+ */
+template<class T>
+class ValueState : public ArgState
+{
+	public:
+
+		/**
+		 * \param v - The value before anything is read from the command
+		 * line.
+		 */
+		ValueState( const T& v ) : ArgState(), value( v ) { }
+
+		T value;
+};
+
+/**
+ * The state of a ValueArg or MultiArg, whose values may be kept as
+ * they were given until they are first read, see
+ * CmdLine::setLazyConversion().
+ */
+template<class T>
+class LazyValueState : public ValueState<T>
+{
+	public:
+
+		/**
+		 * \param v - The value before anything is read from the command
+		 * line.
+		 * \param p - The values given but not converted yet.
+		 */
+		LazyValueState( const T& v, const std::vector<std::string>& p )
+		: ValueState<T>( v ), pending( p ) { }
+
+		/**
+		 * The values given on the command line that haven't been
+		 * converted into value yet, in the order they were given.
+		 */
+		std::vector<std::string> pending;
+};
+
+/**
+ * The outcome of parsing one command line: which Args were matched and
+ * what was read for them.  CmdLine::parse() fills it in without
+ * modifying the CmdLine or its Args, so one CmdLine can parse in several
+ * threads at once, each with its own ParseResult.  The values are read
+ * through the Args, e.g. with ValueArg::getValue(const ParseResult&).
+ * The Args are identified by indices the CmdLine assigns when they are
+ * added, see getStateIndex().  An Arg can be added to several CmdLines,
+ * so the indices are kept by the CmdLine rather than by the Arg.
+ */
+class ParseResult
+{
+	public:
+
+		ParseResult();
+
+		~ParseResult();
+
+		/**
+		 * Forgets the outcome of the last parse, keeping the storage for
+		 * the next one.
+		 */
+		void clear();
+
+		/**
+		 * The index that identifies the Arg in the result, the one the
+		 * CmdLine that parses into the result gave it, or noIndex() if
+		 * that CmdLine doesn't have the Arg.
+		 * \param a - The Arg.
+		 */
+		std::size_t getStateIndex( const Arg* a ) const;
+
+		/**
+		 * Makes the result identify the Args by the indices of a
+		 * CmdLine.  Set by the CmdLine as it parses into the result, the
+		 * indices must stay valid while the result is read.
+		 * \param indices - The index of each Arg.
+		 */
+		void setStateIndices( const std::map<const Arg*, std::size_t>* indices );
+
+		/**
+		 * The index of the xor list the Arg belongs to in the CmdLine
+		 * that parses into the result, or -1 if it isn't xor'd there.
+		 * \param a - The Arg.
+		 */
+		int getXorGroup( const Arg* a ) const;
+
+		/**
+		 * Makes the result find the xor lists of the Args in those of a
+		 * CmdLine, see XorHandler::getXorGroups().  Set like
+		 * setStateIndices().
+		 * \param groups - The index of the xor list of each Arg.
+		 */
+		void setXorGroups( const std::map<const Arg*, int>* groups );
+
+		/**
+		 * The index of an Arg the result doesn't know, which is never
+		 * set.
+		 */
+		static std::size_t noIndex() { return static_cast<std::size_t>(-1); }
+
+		/**
+		 * Whether the Arg with the given index was matched.
+		 * \param index - The index of the Arg.
+		 */
+		bool isSet( std::size_t index ) const;
+
+		/**
+		 * The state of the Arg with the given index, or NULL if the Arg
+		 * wasn't matched or doesn't store anything.
+		 * \param index - The index of the Arg.
+		 */
+		ArgState* getState( std::size_t index ) const;
+
+		/**
+		 * The state the Arg had in an earlier parse, which clear() keeps
+		 * so the Arg can reset it and give it to setState() again
+		 * instead of allocating a new one.  NULL if there is none or the
+		 * Arg is matched already.
+		 * \param index - The index of the Arg.
+		 * \param a - The Arg, which must have made the state.
+		 */
+		ArgState* getSpareState( std::size_t index, const Arg* a ) const;
+
+		/**
+		 * Marks the Arg with the given index as matched.
+		 * \param index - The index of the Arg, nothing is recorded for
+		 * noIndex().
+		 * \param state - What was read for the Arg, if anything.  The
+		 * ParseResult deletes it.
+		 */
+		void setState( std::size_t index, ArgState* state = NULL );
+
+		/**
+		 * The indices of the Args that were matched, in the order they
+		 * were first matched.
+		 */
+		const std::vector<std::size_t>& getMatched() const;
+
+		/**
+		 * How often the Arg with the given index is given by its flag
+		 * or name, counted before the parse for Args that can be given
+		 * more than once.  0 if it wasn't counted.
+		 * \param index - The index of the Arg.
+		 */
+		std::size_t getOccurrences( std::size_t index ) const;
+
+		/**
+		 * Counts one more occurrence of the Arg with the given index.
+		 * \param index - The index of the Arg.
+		 */
+		void addOccurrence( std::size_t index );
+
+		/**
+		 * The Arg that was matched of the xor list with the given index,
+		 * or NULL if none was.
+		 * \param group - The index of the xor list.
+		 */
+		const Arg* getXorSet( int group ) const;
+
+		/**
+		 * Records which Arg of an xor list was matched.
+		 * \param group - The index of the xor list.
+		 * \param a - The Arg that was matched.
+		 */
+		void setXorSet( int group, const Arg* a );
+
+		/**
+		 * Whether the "--" argument has been seen, so ignoreable Args
+		 * no longer match.
+		 */
+		bool ignoreRest() const;
+
+		/**
+		 * Begin ignoring arguments since the "--" argument was seen.
+		 */
+		void beginIgnoring();
+
+		/**
+		 * Whether the parse continues from what is stored in the Args, as
+		 * for CmdLine::parse() without a ParseResult.  An Arg that has
+		 * been set before then counts as set.
+		 */
+		bool continuesArgs() const;
+
+		/**
+		 * \param c - Whether the parse continues from what is stored in
+		 * the Args.
+		 */
+		void setContinuesArgs( bool c );
+
+		/**
+		 * Whether the values given for ValueArgs and MultiArgs are kept
+		 * as they were given and only converted when they are first
+		 * read, see CmdLine::setLazyConversion().
+		 */
+		bool convertsLazily() const;
+
+		/**
+		 * \param lazy - Whether the values are converted when they are
+		 * first read.
+		 */
+		void setConvertsLazily( bool lazy );
+
+		/**
+		 * Whether the Visitors of the Args are run as the Args are
+		 * matched, true unless set otherwise.  IncrementalParser doesn't
+		 * run them, so --help is matched as a switch.
+		 */
+		bool runsVisitors() const;
+
+		/**
+		 * \param run - Whether the Visitors are run.
+		 */
+		void setRunsVisitors( bool run );
+
+		/**
+		 * Whether a parse that doesn't run the Visitors still stops
+		 * where one would ask it to exit, false unless set otherwise.
+		 * BatchParser sets it, so a line with --help becomes an exit
+		 * request without the usage being printed, see
+		 * Visitor::skipParse().
+		 */
+		bool exitsQuietly() const;
+
+		/**
+		 * \param quiet - Whether the parse stops where a Visitor that
+		 * isn't run would ask it to exit.
+		 */
+		void setExitsQuietly( bool quiet );
+
+		/**
+		 * The name of the program, i.e. the first argument.
+		 */
+		const std::string& getProgramName() const;
+
+		void setProgramName( const std::string& name );
+
+		/**
+		 * Splits the command strings given to CmdLine::parseCommand(),
+		 * kept so the next parse can reuse its storage.  clear() leaves
+		 * it alone.
+		 */
+		ShellTokenizer& getTokenizer() { return _tokenizer; }
+
+		/**
+		 * Why a command line is invalid, see getErrorCode().
+		 */
+		enum ErrorCode {
+			NO_PARSE_ERROR,     ///< the command line is valid
+			NO_PROGRAM_NAME,    ///< not even the program name was given
+			UNMATCHED_ARGUMENT, ///< no Arg matches the argument
+			MISSING_REQUIRED,   ///< required Args weren't given
+			TOO_MANY_ARGUMENTS, ///< more required Args than there are
+			ALREADY_SET,        ///< the Arg was given twice
+			EXCLUSIVE_SET,      ///< an Arg xor'd with the Arg was given
+			MISSING_DELIMITER,  ///< the value isn't joined by the delimiter
+			MISSING_VALUE,      ///< no value follows the Arg
+			INVALID_VALUE,      ///< the value can't be read
+			EXTRA_VALUE,        ///< more than one value was read
+			CONSTRAINT_FAILED,  ///< the value doesn't meet the constraint
+			RESPONSE_FILE_ERROR,///< a response file can't be expanded
+			UNTERMINATED_QUOTE, ///< a quote in the command string isn't closed
+			OTHER_ERROR         ///< an ArgException thrown by an Arg
+		};
+
+		/**
+		 * Whether the command line was found to be invalid, only set by
+		 * CmdLine::tryParse().
+		 */
+		bool hasError() const;
+
+		/**
+		 * Why the command line is invalid, NO_PARSE_ERROR if it isn't.
+		 */
+		ErrorCode getErrorCode() const;
+
+		/**
+		 * The index of the argument the error was found at, the program
+		 * name being 0, after response files are expanded, or -1 if the
+		 * error isn't about one argument.
+		 */
+		int getErrorToken() const;
+
+		/**
+		 * The Arg the error is about, the one getErrorArgId() names, or
+		 * NULL if there is none, e.g. for an unmatched argument.
+		 */
+		const Arg* getErrorArg() const;
+
+		/**
+		 * Why the command line is invalid, the text of the ArgException
+		 * the parse would throw.  Only put together when it is first
+		 * asked for, so a rejected command line doesn't cost more than
+		 * an accepted one.
+		 */
+		const std::string& getError() const;
+
+		/**
+		 * The Arg the error is about, as ArgException::argId() gives it.
+		 * Put together when it is first asked for, like getError().
+		 */
+		const std::string& getErrorArgId() const;
+
+		/**
+		 * The id of the Arg the error is about, as it is passed to the
+		 * ArgException, "undefined" if there is none.
+		 */
+		std::string getErrorId() const;
+
+		/**
+		 * Whether the exception for the error is an ArgParseException,
+		 * i.e. the value of an Arg was wrong, rather than a
+		 * CmdLineParseException.
+		 */
+		bool isValueError() const;
+
+		/**
+		 * Throws the ArgException the parse would have thrown for the
+		 * error, or the ExitException if the program was asked to exit.
+		 * Does nothing if the parse didn't stop.  An OTHER_ERROR is
+		 * thrown as a CmdLineParseException without an id.
+		 */
+		void throwError() const;
+
+		/**
+		 * Records that the command line is invalid.  The first error
+		 * recorded is kept.
+		 * \param code - Why it is invalid.
+		 * \param arg - The Arg the error is about, if any.
+		 * \param value - The value or argument the error is about, if
+		 * any.
+		 * \param length - The length of value.
+		 */
+		void setError( ErrorCode code, const Arg* arg = NULL,
+		               const char* value = NULL, std::size_t length = 0 );
+
+		/**
+		 * Records that the command line is invalid.  See above.
+		 * \param code - Why it is invalid.
+		 * \param arg - The Arg the error is about, if any.
+		 * \param value - The value or argument the error is about.
+		 */
+		void setError( ErrorCode code, const Arg* arg,
+		               const std::string& value );
+
+		/**
+		 * Gives the error recorded a text of its own rather than the one
+		 * for its code, e.g. the text of an ArgParseException thrown by
+		 * the operator>> of a value.
+		 * \param text - Why the command line is invalid.
+		 */
+		void setErrorText( const std::string& text );
+
+		/**
+		 * Records a RESPONSE_FILE_ERROR.
+		 * \param reason - Why the file can't be expanded, which must
+		 * stay valid, e.g. a string literal.
+		 * \param path - The name of the file.
+		 */
+		void setResponseFileError( const char* reason,
+		                           const std::string& path );
+
+		/**
+		 * Records a MISSING_REQUIRED error, or adds to the one recorded.
+		 * \param missing - A required Arg that wasn't given.
+		 */
+		void addMissing( const Arg* missing );
+
+		/**
+		 * Records an OTHER_ERROR, already put together.
+		 * \param error - Why the command line is invalid.
+		 * \param argId - The Arg the error is about.
+		 */
+		void setError( const std::string& error, const std::string& argId );
+
+		/**
+		 * \param token - The index of the argument the error was found
+		 * at.
+		 */
+		void setErrorToken( int token );
+
+		/**
+		 * Whether the parse was asked to end the program, e.g. by the
+		 * --help or --version Arg, after which the command line isn't
+		 * parsed any further.  Only set by CmdLine::tryParse(), the other
+		 * parse methods exit.
+		 */
+		bool exitRequested() const;
+
+		/**
+		 * The status the program was asked to exit with.
+		 */
+		int getExitStatus() const;
+
+		/**
+		 * Records that the program should exit, see above.
+		 * \param status - The exit status.
+		 */
+		void requestExit( int status );
+
+		/**
+		 * Whether the parse stopped early, for an error or a request to
+		 * exit.
+		 */
+		bool hasStopped() const;
+
+	private:
+
+		/**
+		 * Prevent accidental copying.
+		 */
+		ParseResult( const ParseResult& rhs );
+		ParseResult& operator=( const ParseResult& rhs );
+
+		/**
+		 * The index of each Arg, kept by the CmdLine, or NULL before
+		 * the first parse.
+		 */
+		const std::map<const Arg*, std::size_t>* _indices;
+
+		/**
+		 * The xor list of each Arg, kept by the XorHandler of the
+		 * CmdLine, or NULL before the first parse.
+		 */
+		const std::map<const Arg*, int>* _xorGroups;
+
+		/**
+		 * Whether each Arg was matched, by index.
+		 */
+		std::vector<bool> _set;
+
+		/**
+		 * The state of each Arg, by index, kept after clear() for the
+		 * next parse.
+		 */
+		std::vector<ArgState*> _states;
+
+		/**
+		 * The indices of the Args that were matched.
+		 */
+		std::vector<std::size_t> _matched;
+
+		/**
+		 * The occurrences of each Arg, by index, see getOccurrences().
+		 */
+		std::vector<std::size_t> _occurrences;
+
+		/**
+		 * The Arg that was matched of each xor list.
+		 */
+		std::vector<const Arg*> _xorSet;
+
+		bool _ignoreRest;
+
+		bool _continuesArgs;
+
+		bool _convertsLazily;
+
+		bool _runsVisitors;
+
+		bool _exitsQuietly;
+
+		std::string _progName;
+
+		ShellTokenizer _tokenizer;
+
+		/**
+		 * Puts the message and the id for the error together.
+		 */
+		void _formatError() const;
+
+		/**
+		 * Sets id to the id of the Arg the error is about, as the
+		 * exception is given it.  Returns false if there is none.
+		 */
+		bool _errorId( std::string& id ) const;
+
+		ErrorCode _errorCode;
+
+		int _errorToken;
+
+		const Arg* _errorArg;
+
+		/**
+		 * The value or argument the error is about.
+		 */
+		std::string _errorValue;
+
+		/**
+		 * Why a response file can't be expanded.
+		 */
+		const char* _errorReason;
+
+		/**
+		 * The required Args that weren't given.
+		 */
+		std::vector<const Arg*> _missing;
+
+		/**
+		 * The text given to the error, if it has one of its own.
+		 */
+		std::string _errorText;
+
+		bool _hasErrorText;
+
+		/**
+		 * Whether _error and _errorArgId have been put together.
+		 */
+		mutable bool _formatted;
+
+		mutable std::string _error;
+
+		mutable std::string _errorArgId;
+
+		bool _exitRequested;
+
+		int _exitStatus;
+};
+
+inline ParseResult::ParseResult()
+: _indices(NULL),
+  _xorGroups(NULL),
+  _set(),
+  _states(),
+  _matched(),
+  _occurrences(),
+  _xorSet(),
+  _ignoreRest(false),
+  _continuesArgs(false),
+  _convertsLazily(false),
+  _runsVisitors(true),
+  _exitsQuietly(false),
+  _progName(),
+  _tokenizer(),
+  _errorCode(NO_PARSE_ERROR),
+  _errorToken(-1),
+  _errorArg(NULL),
+  _errorValue(),
+  _errorReason(NULL),
+  _missing(),
+  _errorText(),
+  _hasErrorText(false),
+  _formatted(false),
+  _error(),
+  _errorArgId(),
+  _exitRequested(false),
+  _exitStatus(0)
+{ }
+
+inline ParseResult::~ParseResult()
+{
+	for ( std::size_t k = 0; k < _states.size(); k++ )
+		delete _states[k];
+}
+
+inline void ParseResult::clear()
+{
+	for ( std::size_t k = 0; k < _matched.size(); k++ )
+		_set[_matched[k]] = false;
+	_matched.clear();
+	_occurrences.clear();
+
+	_xorSet.assign( _xorSet.size(), NULL );
+	_ignoreRest = false;
+	_progName.clear();
+
+	if ( _errorCode != NO_PARSE_ERROR )
+	{
+		_errorCode = NO_PARSE_ERROR;
+		_errorToken = -1;
+		_errorArg = NULL;
+		_errorValue.clear();
+		_errorReason = NULL;
+		_missing.clear();
+		_errorText.clear();
+		_hasErrorText = false;
+		_formatted = false;
+		_error.clear();
+		_errorArgId.clear();
+	}
+
+	_exitRequested = false;
+	_exitStatus = 0;
+}
+
+inline std::size_t ParseResult::getStateIndex( const Arg* a ) const
+{
+	if ( _indices == NULL )
+		return noIndex();
+
+	std::map<const Arg*, std::size_t>::const_iterator it = _indices->find( a );
+	return it != _indices->end() ? it->second : noIndex();
+}
+
+inline void ParseResult::setStateIndices(
+	const std::map<const Arg*, std::size_t>* indices )
+{
+	_indices = indices;
+}
+
+inline int ParseResult::getXorGroup( const Arg* a ) const
+{
+	if ( _xorGroups == NULL )
+		return -1;
+
+	std::map<const Arg*, int>::const_iterator it = _xorGroups->find( a );
+	return it != _xorGroups->end() ? it->second : -1;
+}
+
+inline void ParseResult::setXorGroups(
+	const std::map<const Arg*, int>* groups )
+{
+	_xorGroups = groups;
+}
+
+inline bool ParseResult::isSet( std::size_t index ) const
+{
+	return index < _set.size() && _set[index];
+}
+
+inline ArgState* ParseResult::getState( std::size_t index ) const
+{
+	return isSet( index ) ? _states[index] : NULL;
+}
+
+inline ArgState* ParseResult::getSpareState( std::size_t index,
+                                             const Arg* a ) const
+{
+	if ( index >= _states.size() || _set[index] || _states[index] == NULL ||
+	     _states[index]->arg != a )
+		return NULL;
+
+	return _states[index];
+}
+
+inline void ParseResult::setState( std::size_t index, ArgState* state )
+{
+	if ( index == noIndex() )
+	{
+		delete state;
+		return;
+	}
+
+	if ( index >= _set.size() )
+	{
+		_set.resize( index + 1, false );
+		_states.resize( index + 1, NULL );
+	}
+
+	if ( !_set[index] )
+	{
+		_set[index] = true;
+		_matched.push_back( index );
+	}
+
+	if ( _states[index] != state )
+	{
+		delete _states[index];
+		_states[index] = state;
+	}
+}
+
+inline const std::vector<std::size_t>& ParseResult::getMatched() const
+{
+	return _matched;
+}
+
+inline std::size_t ParseResult::getOccurrences( std::size_t index ) const
+{
+	return index < _occurrences.size() ? _occurrences[index] : 0;
+}
+
+inline void ParseResult::addOccurrence( std::size_t index )
+{
+	if ( index == noIndex() )
+		return;
+
+	if ( index >= _occurrences.size() )
+		_occurrences.resize( index + 1, 0 );
+
+	_occurrences[index]++;
+}
+
+inline const Arg* ParseResult::getXorSet( int group ) const
+{
+	if ( group >= 0 && static_cast<std::size_t>(group) < _xorSet.size() )
+		return _xorSet[group];
+	else
+		return NULL;
+}
+
+inline void ParseResult::setXorSet( int group, const Arg* a )
+{
+	if ( static_cast<std::size_t>(group) >= _xorSet.size() )
+		_xorSet.resize( group + 1, NULL );
+
+	_xorSet[group] = a;
+}
+
+inline bool ParseResult::ignoreRest() const
+{
+	return _ignoreRest;
+}
+
+inline void ParseResult::beginIgnoring()
+{
+	_ignoreRest = true;
+}
+
+inline bool ParseResult::continuesArgs() const
+{
+	return _continuesArgs;
+}
+
+inline void ParseResult::setContinuesArgs( bool c )
+{
+	_continuesArgs = c;
+}
+
+inline bool ParseResult::convertsLazily() const
+{
+	return _convertsLazily;
+}
+
+inline void ParseResult::setConvertsLazily( bool lazy )
+{
+	_convertsLazily = lazy;
+}
+
+inline bool ParseResult::runsVisitors() const
+{
+	return _runsVisitors;
+}
+
+inline void ParseResult::setRunsVisitors( bool run )
+{
+	_runsVisitors = run;
+}
+
+inline bool ParseResult::exitsQuietly() const
+{
+	return _exitsQuietly;
+}
+
+inline void ParseResult::setExitsQuietly( bool quiet )
+{
+	_exitsQuietly = quiet;
+}
+
+inline const std::string& ParseResult::getProgramName() const
+{
+	return _progName;
+}
+
+inline void ParseResult::setProgramName( const std::string& name )
+{
+	_progName = name;
+}
+
+inline bool ParseResult::hasError() const
+{
+	return _errorCode != NO_PARSE_ERROR;
+}
+
+inline ParseResult::ErrorCode ParseResult::getErrorCode() const
+{
+	return _errorCode;
+}
+
+inline int ParseResult::getErrorToken() const
+{
+	return _errorToken;
+}
+
+inline const Arg* ParseResult::getErrorArg() const
+{
+	return _errorArg;
+}
+
+inline const std::string& ParseResult::getError() const
+{
+	if ( !_formatted )
+		_formatError();
+	return _error;
+}
+
+inline const std::string& ParseResult::getErrorArgId() const
+{
+	if ( !_formatted )
+		_formatError();
+	return _errorArgId;
+}
+
+inline bool ParseResult::isValueError() const
+{
+	return _errorCode == MISSING_DELIMITER || _errorCode == MISSING_VALUE ||
+	       _errorCode == INVALID_VALUE || _errorCode == EXTRA_VALUE;
+}
+
+inline void ParseResult::setError( ErrorCode code, const Arg* arg,
+                                   const char* value, std::size_t length )
+{
+	if ( _errorCode != NO_PARSE_ERROR )
+		return;
+
+	_errorCode = code;
+	_errorArg = arg;
+	if ( value != NULL )
+		_errorValue.assign( value, length );
+}
+
+inline void ParseResult::setError( ErrorCode code, const Arg* arg,
+                                   const std::string& value )
+{
+	setError( code, arg, value.c_str(), value.length() );
+}
+
+inline void ParseResult::setErrorText( const std::string& text )
+{
+	_errorText = text;
+	_hasErrorText = true;
+	_formatted = false;
+}
+
+inline void ParseResult::setResponseFileError( const char* reason,
+                                               const std::string& path )
+{
+	if ( _errorCode != NO_PARSE_ERROR )
+		return;
+
+	setError( RESPONSE_FILE_ERROR, NULL, path );
+	_errorReason = reason;
+}
+
+inline void ParseResult::addMissing( const Arg* missing )
+{
+	setError( MISSING_REQUIRED );
+	if ( _errorCode == MISSING_REQUIRED )
+		_missing.push_back( missing );
+}
+
+inline void ParseResult::setError( const std::string& error,
+                                   const std::string& argId )
+{
+	if ( _errorCode != NO_PARSE_ERROR )
+		return;
+
+	_errorCode = OTHER_ERROR;
+	_formatted = true;
+	_error = error;
+	_errorArgId = argId;
+}
+
+inline void ParseResult::setErrorToken( int token )
+{
+	_errorToken = token;
+}
+
+inline bool ParseResult::exitRequested() const
+{
+	return _exitRequested;
+}
+
+inline int ParseResult::getExitStatus() const
+{
+	return _exitStatus;
+}
+
+inline void ParseResult::requestExit( int status )
+{
+	if ( _exitRequested )
+		return;
+
+	_exitRequested = true;
+	_exitStatus = status;
+}
+
+inline bool ParseResult::hasStopped() const
+{
+	return _errorCode != NO_PARSE_ERROR || _exitRequested;
+}
+
+// _formatError(), _errorId() and throwError() need the Arg, they are
+// defined in Arg.h
+
+} //namespace TCLAP
+
+#endif
@@ -0,0 +1,818 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+/******************************************************************************
+ *
+ *  file:  PatternConstraint.h
+ *
+ *  Copyright (c) 2018, Google LLC
+ *  All rights reserved.
+ *
+ *  See the file COPYING in the top directory of this distribution for
+ *  more information.
+ *
+ *  THE SOFTWARE IS PROVIDED _AS IS_, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ *  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *  DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef TCLAP_PATTERN_CONSTRAINT_H
+#define TCLAP_PATTERN_CONSTRAINT_H
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <map>
+#include <bitset>
+#include <algorithm>
+#include <cstddef>
+#include <tclap/Constraint.h>
+#include <tclap/ArgException.h>
+
+namespace TCLAP {
+
+/**
+ * A Constraint that constrains the Arg to the strings that match a
+ * regular expression as a whole.  The pattern is compiled once, when
+ * the constraint is constructed, and checking a value takes time linear
+ * in its length, whatever the pattern, so a hostile value can't make
+ * it backtrack.
+ *
+ * The syntax is a subset of that of ECMAScript, i.e. of std::regex:
+ * literals, ".", classes such as "[a-z_]" or "[^/]", the escapes \\d,
+ * \\w, \\s and their negations, groups, "|", and the quantifiers "*",
+ * "+", "?" and "{m,n}".  There are no back references or assertions,
+ * except "^" and "$" at the ends of the pattern, which are implied
+ * anyway.  The pattern matches bytes, not UTF-8 characters.  An invalid
+ * pattern throws a SpecificationException.
+ */
+class PatternConstraint : public Constraint<std::string>
+{
+
+	public:
+
+		/**
+		 * Constructor.
+		 * \param pattern - The regular expression values must match.
+		 * \param typeDesc - What the values are, e.g. "hostname", shown
+		 * in the usage.  If it is empty the pattern is shown.
+		 */
+		PatternConstraint( const std::string& pattern,
+		                   const std::string& typeDesc = "" );
+
+		virtual ~PatternConstraint() {}
+
+		/**
+		 * Returns a description of the Constraint, the type description
+		 * if there is one, otherwise the pattern.
+		 */
+		virtual std::string description() const;
+
+		/**
+		 * Returns the short ID for the Constraint, the same as the
+		 * description.
+		 */
+		virtual std::string shortID() const;
+
+		/**
+		 * The method used to verify that the value parsed from the command
+		 * line meets the constraint.
+		 * \param value - The value that will be checked.
+		 */
+		virtual bool check( const std::string& value ) const;
+
+		/**
+		 * Describes the Constraint and, if it has a type description,
+		 * the pattern.
+		 * \param value - The value that failed check().
+		 */
+		virtual std::string failureDescription( const std::string& value ) const;
+
+		/**
+		 * Whether the characters match the pattern.
+		 * \param begin - The first character.
+		 * \param end - The end of the characters.
+		 */
+		bool matches( const char* begin, const char* end ) const;
+
+		const std::string& getPattern() const { return _pattern; }
+
+	private:
+
+		/**
+		 * The limits that keep a pattern from taking too much memory.
+		 * If the DFA would have more states the NFA is simulated.
+		 */
+		enum { MAX_DEPTH = 100, MAX_REPEAT = 1000,
+		       MAX_INSTRUCTIONS = 10000, MAX_DFA_STATES = 1000 };
+
+		enum NodeType { SET_NODE, CONCAT_NODE, ALT_NODE, REPEAT_NODE };
+
+		/**
+		 * A node of the syntax tree of the pattern.  A repeat has one
+		 * child and max is -1 if there is no upper bound.
+		 */
+		struct Node
+		{
+			Node( NodeType t, int s = -1, int lo = 0, int hi = 0 )
+			: type( t ), set( s ), min( lo ), max( hi ), children()
+			{ }
+
+			NodeType type;
+			int set;
+			int min;
+			int max;
+			std::vector<int> children;
+		};
+
+		enum Op { CHAR_OP, SPLIT_OP, JMP_OP, MATCH_OP };
+
+		/**
+		 * An instruction of the NFA: match a character of the set x and
+		 * go on, go on at both x and y, go on at x, or match.
+		 */
+		struct Instruction
+		{
+			Instruction( Op o, int a = 0, int b = 0 )
+			: op( o ), x( a ), y( b )
+			{ }
+
+			Op op;
+			int x;
+			int y;
+		};
+
+		typedef std::bitset<256> CharSet;
+
+		int _parseAlt( std::vector<Node>& nodes, std::size_t& i,
+		               int depth );
+
+		int _parseConcat( std::vector<Node>& nodes, std::size_t& i,
+		                  int depth );
+
+		int _parseAtom( std::vector<Node>& nodes, std::size_t& i,
+		                int depth );
+
+		int _parseRepeat( std::vector<Node>& nodes, std::size_t& i,
+		                  int atom );
+
+		int _parseCount( std::size_t& i ) const;
+
+		void _parseClass( std::size_t& i, CharSet& set ) const;
+
+		/**
+		 * Adds the characters of an escape, the backslash at i - 1.
+		 */
+		void _parseEscape( std::size_t& i, CharSet& set ) const;
+
+		int _addSet( std::vector<Node>& nodes, const CharSet& set );
+
+		void _emit( const std::vector<Node>& nodes, int n );
+
+		int _push( Op op, int x = 0, int y = 0 );
+
+		/**
+		 * Groups the characters no set tells apart, so the DFA has a
+		 * transition per group rather than per character.
+		 */
+		void _buildClasses();
+
+		/**
+		 * Builds the DFA by the subset construction, unless it gets too
+		 * large.
+		 */
+		void _buildDfa();
+
+		/**
+		 * Adds the instruction at pc and those it leads to without
+		 * matching a character to the list, unless they are marked.
+		 */
+		void _addState( std::vector<int>& list, std::vector<int>& mark,
+		                int gen, int pc ) const;
+
+		bool _simulate( const char* begin, const char* end ) const;
+
+		void _fail( const std::string& message ) const;
+
+		std::string _pattern;
+
+		std::string _typeDesc;
+
+		/**
+		 * The character sets the instructions match.
+		 */
+		std::vector<CharSet> _sets;
+
+		std::vector<Instruction> _program;
+
+		/**
+		 * The group of each character, and the number of groups.
+		 */
+		std::vector<int> _classOf;
+
+		int _classes;
+
+		/**
+		 * The transitions of the DFA, a row of _classes per state with
+		 * -1 for no match, and whether each state accepts.  Empty if the
+		 * NFA is simulated.
+		 */
+		std::vector<int> _dfa;
+
+		std::vector<bool> _accepting;
+};
+
+inline PatternConstraint::PatternConstraint( const std::string& pattern,
+                                             const std::string& typeDesc )
+: _pattern( pattern ),
+  _typeDesc( typeDesc ),
+  _sets(),
+  _program(),
+  _classOf( 256 ),
+  _classes( 0 ),
+  _dfa(),
+  _accepting()
+{
+	std::vector<Node> nodes;
+	std::size_t i = 0;
+
+	// the whole value is matched, so anchors at the ends are no-ops
+	if ( i < _pattern.length() && _pattern[i] == '^' )
+		i++;
+
+	const int root = _parseAlt( nodes, i, 0 );
+	if ( i < _pattern.length() )
+		_fail( "unmatched ')'" );
+
+	_emit( nodes, root );
+	_push( MATCH_OP );
+	_buildClasses();
+	_buildDfa();
+}
+
+inline std::string PatternConstraint::description() const
+{
+	return _typeDesc.empty() ? _pattern : _typeDesc;
+}
+
+inline std::string PatternConstraint::shortID() const
+{
+	return description();
+}
+
+inline bool PatternConstraint::check( const std::string& value ) const
+{
+	return matches( value.data(), value.data() + value.length() );
+}
+
+inline std::string
+PatternConstraint::failureDescription( const std::string& value ) const
+{
+	static_cast<void>(value); // Ignore input, don't warn
+
+	if ( _typeDesc.empty() )
+		return _pattern;
+
+	return _typeDesc + " (pattern '" + _pattern + "')";
+}
+
+inline bool PatternConstraint::matches( const char* begin,
+                                        const char* end ) const
+{
+	if ( _dfa.empty() )
+		return _simulate( begin, end );
+
+	int state = 0;
+	for ( const char* p = begin; p != end; p++ )
+	{
+		state = _dfa[state * _classes +
+		             _classOf[static_cast<unsigned char>(*p)]];
+		if ( state < 0 )
+			return false;
+	}
+
+	return _accepting[state];
+}
+
+inline int PatternConstraint::_parseAlt( std::vector<Node>& nodes,
+                                         std::size_t& i, int depth )
+{
+	if ( depth > MAX_DEPTH )
+		_fail( "groups nested too deeply" );
+
+	const int first = _parseConcat( nodes, i, depth );
+	if ( i >= _pattern.length() || _pattern[i] != '|' )
+		return first;
+
+	const int alt = static_cast<int>(nodes.size());
+	nodes.push_back( Node( ALT_NODE ) );
+	nodes[alt].children.push_back( first );
+	while ( i < _pattern.length() && _pattern[i] == '|' )
+	{
+		i++;
+		const int next = _parseConcat( nodes, i, depth );
+		nodes[alt].children.push_back( next );
+	}
+
+	return alt;
+}
+
+inline int PatternConstraint::_parseConcat( std::vector<Node>& nodes,
+                                            std::size_t& i, int depth )
+{
+	const int concat = static_cast<int>(nodes.size());
+	nodes.push_back( Node( CONCAT_NODE ) );
+	while ( i < _pattern.length() && _pattern[i] != '|' &&
+	        _pattern[i] != ')' )
+	{
+		// a "$" ending the pattern is a no-op too
+		if ( _pattern[i] == '$' && i + 1 == _pattern.length() )
+		{
+			i++;
+			break;
+		}
+
+		const int atom = _parseAtom( nodes, i, depth );
+		const int repeat = _parseRepeat( nodes, i, atom );
+		nodes[concat].children.push_back( repeat );
+	}
+
+	return concat;
+}
+
+inline int PatternConstraint::_parseAtom( std::vector<Node>& nodes,
+                                          std::size_t& i, int depth )
+{
+	CharSet set;
+	const char c = _pattern[i++];
+	switch ( c )
+	{
+		case '(':
+		{
+			if ( _pattern.compare( i, 2, "?:" ) == 0 )
+				i += 2;
+
+			const int group = _parseAlt( nodes, i, depth + 1 );
+			if ( i >= _pattern.length() || _pattern[i] != ')' )
+				_fail( "missing ')'" );
+
+			i++;
+			return group;
+		}
+		case '[':
+			_parseClass( i, set );
+			break;
+		case '.':
+			set.set();
+			set.reset( '\n' );
+			break;
+		case '\\':
+			_parseEscape( i, set );
+			break;
+		case '*':
+		case '+':
+		case '?':
+		case '{':
+			_fail( std::string( "nothing to repeat before '" ) + c + "'" );
+			break;
+		case '^':
+		case '$':
+			_fail( "'^' and '$' are only allowed at the ends" );
+			break;
+		default:
+			set.set( static_cast<unsigned char>(c) );
+			break;
+	}
+
+	return _addSet( nodes, set );
+}
+
+inline int PatternConstraint::_parseRepeat( std::vector<Node>& nodes,
+                                            std::size_t& i, int atom )
+{
+	while ( i < _pattern.length() )
+	{
+		int lo;
+		int hi;
+		const char c = _pattern[i];
+		if ( c == '*' )
+		{
+			lo = 0;
+			hi = -1;
+			i++;
+		}
+		else if ( c == '+' )
+		{
+			lo = 1;
+			hi = -1;
+			i++;
+		}
+		else if ( c == '?' )
+		{
+			lo = 0;
+			hi = 1;
+			i++;
+		}
+		else if ( c == '{' )
+		{
+			i++;
+			lo = _parseCount( i );
+			hi = lo;
+			if ( i < _pattern.length() && _pattern[i] == ',' )
+			{
+				i++;
+				hi = i < _pattern.length() && _pattern[i] == '}'
+					? -1 : _parseCount( i );
+			}
+
+			if ( i >= _pattern.length() || _pattern[i] != '}' )
+				_fail( "missing '}'" );
+			if ( hi != -1 && hi < lo )
+				_fail( "the count in '{}' is out of order" );
+			i++;
+		}
+		else
+			break;
+
+		// a lazy quantifier matches the same strings
+		if ( i < _pattern.length() && _pattern[i] == '?' )
+			i++;
+
+		const int repeat = static_cast<int>(nodes.size());
+		nodes.push_back( Node( REPEAT_NODE, -1, lo, hi ) );
+		nodes[repeat].children.push_back( atom );
+		atom = repeat;
+	}
+
+	return atom;
+}
+
+inline int PatternConstraint::_parseCount( std::size_t& i ) const
+{
+	int n = 0;
+	const std::size_t start = i;
+	for ( ; i < _pattern.length() && _pattern[i] >= '0' &&
+	        _pattern[i] <= '9'; i++ )
+	{
+		n = n * 10 + ( _pattern[i] - '0' );
+		if ( n > MAX_REPEAT )
+			_fail( "the count in '{}' is too large" );
+	}
+
+	if ( i == start )
+		_fail( "missing count in '{}'" );
+
+	return n;
+}
+
+inline void PatternConstraint::_parseClass( std::size_t& i,
+                                            CharSet& set ) const
+{
+	bool negated = false;
+	if ( i < _pattern.length() && _pattern[i] == '^' )
+	{
+		negated = true;
+		i++;
+	}
+
+	// as in ECMAScript "[]" is empty, a ']' member is escaped
+	while ( i < _pattern.length() && _pattern[i] != ']' )
+	{
+		unsigned char lo = static_cast<unsigned char>(_pattern[i++]);
+		if ( lo == '\\' )
+		{
+			CharSet escaped;
+			_parseEscape( i, escaped );
+			if ( escaped.count() != 1 )
+			{
+				set |= escaped;
+				continue;
+			}
+
+			for ( lo = 0; !escaped.test( lo ); lo++ )
+				;
+		}
+
+		unsigned char hi = lo;
+		if ( i + 1 < _pattern.length() && _pattern[i] == '-' &&
+		     _pattern[i + 1] != ']' )
+		{
+			i++;
+			hi = static_cast<unsigned char>(_pattern[i++]);
+			if ( hi == '\\' )
+			{
+				CharSet escaped;
+				_parseEscape( i, escaped );
+				if ( escaped.count() != 1 )
+					_fail( "a class escape ends a range" );
+
+				for ( hi = 0; !escaped.test( hi ); hi++ )
+					;
+			}
+
+			if ( hi < lo )
+				_fail( "a range in '[]' is out of order" );
+		}
+
+		for ( unsigned int c = lo; c <= hi; c++ )
+			set.set( c );
+	}
+
+	if ( i >= _pattern.length() )
+		_fail( "missing ']'" );
+
+	i++;
+	if ( negated )
+		set.flip();
+}
+
+inline void PatternConstraint::_parseEscape( std::size_t& i,
+                                             CharSet& set ) const
+{
+	if ( i >= _pattern.length() )
+		_fail( "'\\' ends the pattern" );
+
+	const char c = _pattern[i++];
+	switch ( c )
+	{
+		case 'd':
+		case 'D':
+			for ( unsigned int d = '0'; d <= '9'; d++ )
+				set.set( d );
+			break;
+		case 'w':
+		case 'W':
+			for ( unsigned int w = 0; w < 256; w++ )
+				if ( ( w >= 'a' && w <= 'z' ) || ( w >= 'A' && w <= 'Z' ) ||
+				     ( w >= '0' && w <= '9' ) || w == '_' )
+					set.set( w );
+			break;
+		case 's':
+		case 'S':
+			set.set( ' ' );
+			set.set( '\t' );
+			set.set( '\n' );
+			set.set( '\r' );
+			set.set( '\v' );
+			set.set( '\f' );
+			break;
+		case 't':
+			set.set( '\t' );
+			break;
+		case 'n':
+			set.set( '\n' );
+			break;
+		case 'r':
+			set.set( '\r' );
+			break;
+		case 'f':
+			set.set( '\f' );
+			break;
+		case 'v':
+			set.set( '\v' );
+			break;
+		default:
+			if ( ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ) ||
+			     ( c >= '0' && c <= '9' ) )
+				_fail( std::string( "unknown escape '\\" ) + c + "'" );
+
+			set.set( static_cast<unsigned char>(c) );
+			return;
+	}
+
+	if ( c == 'D' || c == 'W' || c == 'S' )
+		set.flip();
+}
+
+inline int PatternConstraint::_addSet( std::vector<Node>& nodes,
+                                       const CharSet& set )
+{
+	_sets.push_back( set );
+	nodes.push_back( Node( SET_NODE, static_cast<int>(_sets.size()) - 1 ) );
+	return static_cast<int>(nodes.size()) - 1;
+}
+
+inline void PatternConstraint::_emit( const std::vector<Node>& nodes, int n )
+{
+	const Node& node = nodes[n];
+	switch ( node.type )
+	{
+		case SET_NODE:
+			_push( CHAR_OP, node.set );
+			break;
+		case CONCAT_NODE:
+			for ( std::size_t c = 0; c < node.children.size(); c++ )
+				_emit( nodes, node.children[c] );
+			break;
+		case ALT_NODE:
+		{
+			std::vector<int> jumps;
+			for ( std::size_t c = 0; c + 1 < node.children.size(); c++ )
+			{
+				const int split = _push( SPLIT_OP );
+				_program[split].x = split + 1;
+				_emit( nodes, node.children[c] );
+				jumps.push_back( _push( JMP_OP ) );
+				_program[split].y = static_cast<int>(_program.size());
+			}
+
+			_emit( nodes, node.children.back() );
+			for ( std::size_t j = 0; j < jumps.size(); j++ )
+				_program[jumps[j]].x = static_cast<int>(_program.size());
+			break;
+		}
+		case REPEAT_NODE:
+		{
+			for ( int r = 0; r < node.min; r++ )
+				_emit( nodes, node.children[0] );
+
+			if ( node.max == -1 )
+			{
+				const int split = _push( SPLIT_OP );
+				_program[split].x = split + 1;
+				_emit( nodes, node.children[0] );
+				_push( JMP_OP, split );
+				_program[split].y = static_cast<int>(_program.size());
+				break;
+			}
+
+			// each optional copy skips to the end, not to the next one
+			std::vector<int> splits;
+			for ( int r = node.min; r < node.max; r++ )
+			{
+				splits.push_back( _push( SPLIT_OP ) );
+				_program[splits.back()].x = splits.back() + 1;
+				_emit( nodes, node.children[0] );
+			}
+
+			for ( std::size_t s = 0; s < splits.size(); s++ )
+				_program[splits[s]].y = static_cast<int>(_program.size());
+			break;
+		}
+	}
+}
+
+inline int PatternConstraint::_push( Op op, int x, int y )
+{
+	if ( _program.size() >= MAX_INSTRUCTIONS )
+		_fail( "the pattern is too large" );
+
+	_program.push_back( Instruction( op, x, y ) );
+	return static_cast<int>(_program.size()) - 1;
+}
+
+inline void PatternConstraint::_buildClasses()
+{
+	std::map<std::vector<bool>, int> classes;
+	for ( unsigned int c = 0; c < 256; c++ )
+	{
+		std::vector<bool> in( _sets.size() );
+		for ( std::size_t s = 0; s < _sets.size(); s++ )
+			in[s] = _sets[s].test( c );
+
+		std::map<std::vector<bool>, int>::iterator it = classes.find( in );
+		if ( it == classes.end() )
+			it = classes.insert( std::make_pair( in, _classes++ ) ).first;
+		_classOf[c] = it->second;
+	}
+}
+
+inline void PatternConstraint::_buildDfa()
+{
+	// a character of each group
+	std::vector<unsigned int> member( _classes );
+	for ( unsigned int c = 256; c-- > 0; )
+		member[_classOf[c]] = c;
+
+	std::vector<int> mark( _program.size(), -1 );
+	int gen = 0;
+
+	std::vector< std::vector<int> > states( 1 );
+	_addState( states[0], mark, gen++, 0 );
+	std::sort( states[0].begin(), states[0].end() );
+
+	std::map<std::vector<int>, int> ids;
+	ids[states[0]] = 0;
+
+	std::vector<int> dfa;
+	for ( std::size_t s = 0; s < states.size(); s++ )
+	{
+		for ( int k = 0; k < _classes; k++ )
+		{
+			std::vector<int> next;
+			for ( std::size_t j = 0; j < states[s].size(); j++ )
+			{
+				const Instruction& in = _program[states[s][j]];
+				if ( in.op == CHAR_OP && _sets[in.x].test( member[k] ) )
+					_addState( next, mark, gen, states[s][j] + 1 );
+			}
+			gen++;
+
+			if ( next.empty() )
+			{
+				dfa.push_back( -1 );
+				continue;
+			}
+
+			std::sort( next.begin(), next.end() );
+			std::map<std::vector<int>, int>::iterator it = ids.find( next );
+			if ( it == ids.end() )
+			{
+				// too many states, the NFA is simulated instead
+				if ( states.size() >= MAX_DFA_STATES )
+					return;
+
+				it = ids.insert(
+					std::make_pair( next, static_cast<int>(states.size()) ) )
+					.first;
+				states.push_back( next );
+			}
+
+			dfa.push_back( it->second );
+		}
+	}
+
+	_accepting.resize( states.size() );
+	for ( std::size_t s = 0; s < states.size(); s++ )
+		for ( std::size_t j = 0; j < states[s].size(); j++ )
+			if ( _program[states[s][j]].op == MATCH_OP )
+				_accepting[s] = true;
+
+	_dfa.swap( dfa );
+}
+
+inline void PatternConstraint::_addState( std::vector<int>& list,
+                                          std::vector<int>& mark, int gen,
+                                          int pc ) const
+{
+	// a stack rather than recursion, a long repeat is a long chain
+	std::vector<int> stack( 1, pc );
+	while ( !stack.empty() )
+	{
+		pc = stack.back();
+		stack.pop_back();
+		if ( mark[pc] == gen )
+			continue;
+
+		mark[pc] = gen;
+		const Instruction& in = _program[pc];
+		if ( in.op == JMP_OP )
+			stack.push_back( in.x );
+		else if ( in.op == SPLIT_OP )
+		{
+			stack.push_back( in.y );
+			stack.push_back( in.x );
+		}
+		else
+			list.push_back( pc );
+	}
+}
+
+inline bool PatternConstraint::_simulate( const char* begin,
+                                          const char* end ) const
+{
+	std::vector<int> mark( _program.size(), -1 );
+	int gen = 0;
+
+	std::vector<int> current;
+	std::vector<int> next;
+	_addState( current, mark, gen++, 0 );
+	for ( const char* p = begin; p != end; p++ )
+	{
+		const unsigned char c = static_cast<unsigned char>(*p);
+		next.clear();
+		for ( std::size_t j = 0; j < current.size(); j++ )
+		{
+			const Instruction& in = _program[current[j]];
+			if ( in.op == CHAR_OP && _sets[in.x].test( c ) )
+				_addState( next, mark, gen, current[j] + 1 );
+		}
+
+		gen++;
+		current.swap( next );
+		if ( current.empty() )
+			return false;
+	}
+
+	for ( std::size_t j = 0; j < current.size(); j++ )
+		if ( _program[current[j]].op == MATCH_OP )
+			return true;
+
+	return false;
+}
+
+inline void PatternConstraint::_fail( const std::string& message ) const
+{
+	TCLAP_THROW( SpecificationException( "Invalid pattern '" + _pattern +
+	                                     "': " + message ) );
+}
+
+} //namespace TCLAP
+#endif
@@ -0,0 +1,232 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+/******************************************************************************
+ *
+ *  file:  RangeConstraint.h
+ *
+ *  Copyright (c) 2018, Google LLC
+ *  All rights reserved.
+ *
+ *  See the file COPYING in the top directory of this distribution for
+ *  more information.
+ *
+ *  THE SOFTWARE IS PROVIDED _AS IS_, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ *  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *  DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef TCLAP_RANGE_CONSTRAINT_H
+#define TCLAP_RANGE_CONSTRAINT_H
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string>
+#include <cstddef>
+#include <tclap/Constraint.h>
+#include <tclap/sstream.h>
+
+namespace TCLAP {
+
+/**
+ * A Constraint that constrains the Arg to the values between two
+ * bounds, each of which may be included or not.  T needs the operators
+ * < and <=, and operator<< for the usage, which shows the range as
+ * "lo..hi", with a "<" on the side of a bound that isn't included, e.g.
+ * "0..<1".  A NaN is never in range.
+ */
+template<class T>
+class RangeConstraint : public Constraint<T>
+{
+
+	public:
+
+		/**
+		 * Constructor.
+		 * \param low - The lower bound.
+		 * \param high - The upper bound.
+		 * \param lowIncluded - Whether the lower bound is in range.
+		 * \param highIncluded - Whether the upper bound is in range.
+		 */
+		RangeConstraint( const T& low, const T& high,
+		                 bool lowIncluded = true, bool highIncluded = true );
+
+		virtual ~RangeConstraint() {}
+
+		/**
+		 * Returns a description of the Constraint, the range.
+		 */
+		virtual std::string description() const;
+
+		/**
+		 * Returns the short ID for the Constraint, the range.
+		 */
+		virtual std::string shortID() const;
+
+		/**
+		 * The method used to verify that the value parsed from the command
+		 * line meets the constraint.
+		 * \param value - The value that will be checked.
+		 */
+		virtual bool check( const T& value ) const;
+
+		/**
+		 * Checks many values in a single pass without branches, which
+		 * the compiler can vectorize, and only looks for the value that
+		 * is out of range if there is one.
+		 * \param values - The values that will be checked.
+		 * \param count - The number of values.
+		 */
+		virtual std::size_t checkAll( const T* values,
+		                              std::size_t count ) const;
+
+		const T& getLow() const { return _low; }
+
+		const T& getHigh() const { return _high; }
+
+	protected:
+
+		T _low;
+
+		T _high;
+
+		bool _lowIncluded;
+
+		bool _highIncluded;
+
+	private:
+
+		/**
+		 * The number of values out of range, with the inclusion of the
+		 * bounds fixed so the loop doesn't test it.
+		 */
+		template<bool LowIncluded, bool HighIncluded>
+		std::size_t _countOutside( const T* values, std::size_t count ) const;
+};
+
+template<class T>
+RangeConstraint<T>::RangeConstraint( const T& low, const T& high,
+                                     bool lowIncluded, bool highIncluded )
+: _low( low ),
+  _high( high ),
+  _lowIncluded( lowIncluded ),
+  _highIncluded( highIncluded )
+{ }
+
+template<class T>
+std::string RangeConstraint<T>::description() const
+{
+	std::ostringstream os;
+	os << _low << ( _lowIncluded ? ".." : "<.." )
+	   << ( _highIncluded ? "" : "<" ) << _high;
+	return os.str();
+}
+
+template<class T>
+std::string RangeConstraint<T>::shortID() const
+{
+	return description();
+}
+
+template<class T>
+bool RangeConstraint<T>::check( const T& value ) const
+{
+	return ( _lowIncluded ? _low <= value : _low < value ) &&
+	       ( _highIncluded ? value <= _high : value < _high );
+}
+
+template<class T>
+std::size_t RangeConstraint<T>::checkAll( const T* values,
+                                          std::size_t count ) const
+{
+	std::size_t outside;
+	if ( _lowIncluded )
+		outside = _highIncluded ? _countOutside<true, true>( values, count )
+		                        : _countOutside<true, false>( values, count );
+	else
+		outside = _highIncluded ? _countOutside<false, true>( values, count )
+		                        : _countOutside<false, false>( values, count );
+
+	if ( outside == 0 )
+		return count;
+
+	for ( std::size_t i = 0; i < count; i++ )
+		if ( !check( values[i] ) )
+			return i;
+	return count;
+}
+
+template<class T>
+template<bool LowIncluded, bool HighIncluded>
+std::size_t RangeConstraint<T>::_countOutside( const T* values,
+                                               std::size_t count ) const
+{
+	const T low = _low;
+	const T high = _high;
+
+	// counting rather than stopping at the first leaves nothing to
+	// branch on, so the loop can be vectorized
+	std::size_t outside = 0;
+	for ( std::size_t i = 0; i < count; i++ )
+		outside +=
+			( LowIncluded ? low <= values[i] : low < values[i] ) &&
+			( HighIncluded ? values[i] <= high : values[i] < high ) ? 0 : 1;
+	return outside;
+}
+
+/**
+ * A RangeConstraint with bounds fixed at compile time, both of them
+ * included, for integral types.  The bounds are constants in check()
+ * and checkAll(), which the compiler can fold into the comparisons.
+ */
+template<class T, T Low, T High>
+class StaticRangeConstraint : public RangeConstraint<T>
+{
+
+	public:
+
+		StaticRangeConstraint() : RangeConstraint<T>( Low, High ) { }
+
+		virtual ~StaticRangeConstraint() {}
+
+		virtual bool check( const T& value ) const
+		{
+			return _inRange( value );
+		}
+
+		virtual std::size_t checkAll( const T* values,
+		                              std::size_t count ) const
+		{
+			std::size_t outside = 0;
+			for ( std::size_t i = 0; i < count; i++ )
+				outside += _inRange( values[i] ) ? 0 : 1;
+			if ( outside == 0 )
+				return count;
+
+			for ( std::size_t i = 0; i < count; i++ )
+				if ( !_inRange( values[i] ) )
+					return i;
+			return count;
+		}
+
+	private:
+
+		/**
+		 * Compares through parameters, so a bound that is the limit of
+		 * the type, e.g. 0 for an unsigned type, doesn't warn that a
+		 * comparison is always true.
+		 */
+		static bool _inRange( T value, T low = Low, T high = High )
+		{
+			return low <= value && value <= high;
+		}
+};
+
+} //namespace TCLAP
+#endif
@@ -0,0 +1,309 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+/******************************************************************************
+ *
+ *  file:  ResponseFile.h
+ *
+ *  Copyright (c) 2018, Google LLC
+ *  All rights reserved.
+ *
+ *  See the file COPYING in the top directory of this distribution for
+ *  more information.
+ *
+ *  THE SOFTWARE IS PROVIDED _AS IS_, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ *  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *  DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+// This is an internal tclap file, you should probably not have to
+// include this directly
+
+#ifndef TCLAP_RESPONSE_FILE_H
+#define TCLAP_RESPONSE_FILE_H
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstring>
+
+#include <tclap/ShellTokenizer.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define TCLAP_MMAP
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace TCLAP {
+
+/**
+ * The contents of a response file, i.e. a file named by an "@file"
+ * argument that stands for the arguments in the file.  The file is
+ * mapped into memory where possible and read into a single buffer
+ * otherwise.  The arguments are split in place, each terminated by a
+ * NUL, so they are passed on without copying them.  See
+ * CmdLine::setResponseFiles().
+ */
+class ResponseFile
+{
+	public:
+
+		/**
+		 * How the arguments in a response file are separated.
+		 */
+		enum Format {
+			NONE,   ///< "@file" arguments aren't expanded
+			LINES,  ///< one argument per line, empty lines are skipped
+			SHELL   ///< separated by white space and quoted as in sh,
+			        ///< "#" starts a comment
+		};
+
+		/**
+		 * Maps or reads the file.  If it can't be read or is too large
+		 * error() says why.
+		 * \param path - The name of the file.
+		 * \param maxSize - The largest size accepted, in bytes.
+		 */
+		ResponseFile( const std::string& path, std::size_t maxSize );
+
+		~ResponseFile();
+
+		/**
+		 * The size of the file in bytes.
+		 */
+		std::size_t size() const { return _size; }
+
+		/**
+		 * The name of the file.
+		 */
+		const std::string& path() const { return _path; }
+
+		/**
+		 * Why the file can't be read or split into arguments, or NULL if
+		 * nothing went wrong.
+		 */
+		const char* error() const { return _error; }
+
+		/**
+		 * Splits the contents into arguments, modifying them in place, and
+		 * passes each to sink.addArgument(const char* s, std::size_t
+		 * length), which returns false to stop.  The arguments stay
+		 * valid while the ResponseFile exists.  Returns false if it
+		 * stopped or for an unterminated quote, see error().
+		 * \param format - How the arguments are separated, LINES or SHELL.
+		 * \param sink - What is given the arguments.
+		 */
+		template<class Sink>
+		bool tokenize( Format format, Sink& sink );
+
+	private:
+
+		/**
+		 * Prevent accidental copying.
+		 */
+		ResponseFile( const ResponseFile& rhs );
+		ResponseFile& operator=( const ResponseFile& rhs );
+
+		/**
+		 * Reads the file into _buffer, for files that can't be mapped.
+		 * \param maxSize - The largest size accepted.
+		 */
+		void _read( std::size_t maxSize );
+
+		template<class Sink>
+		bool _tokenizeLines( Sink& sink );
+
+		template<class Sink>
+		bool _tokenizeShell( Sink& sink );
+
+		std::string _path;
+
+		/**
+		 * The contents, followed by a writable byte so the last argument
+		 * can be NUL terminated too.
+		 */
+		char* _data;
+
+		std::size_t _size;
+
+		/**
+		 * The length of the mapping, 0 if the file was read into _buffer.
+		 */
+		std::size_t _mapped;
+
+		std::vector<char> _buffer;
+
+		const char* _error;
+};
+
+inline ResponseFile::ResponseFile( const std::string& path,
+                                   std::size_t maxSize )
+: _path( path ),
+  _data( NULL ),
+  _size( 0 ),
+  _mapped( 0 ),
+  _buffer(),
+  _error( NULL )
+{
+#if defined(TCLAP_MMAP)
+	int fd = open( path.c_str(), O_RDONLY );
+	if ( fd < 0 )
+	{
+		_error = "Couldn't read response file";
+		return;
+	}
+
+	struct stat st;
+	if ( fstat( fd, &st ) == 0 && S_ISREG( st.st_mode ) )
+	{
+		if ( st.st_size < 0 )
+		{
+			close( fd );
+			_error = "Couldn't read response file";
+			return;
+		}
+
+		// a size that doesn't fit std::size_t doesn't survive the cast
+		const std::size_t size = static_cast<std::size_t>(st.st_size);
+		if ( static_cast<off_t>(size) != st.st_size || size > maxSize )
+		{
+			close( fd );
+			_error = "Response files exceed the size limit";
+			return;
+		}
+
+		// the rest of the last page is zero filled and can hold the
+		// final NUL, unless the file fills the page
+		const long page = sysconf( _SC_PAGESIZE );
+		if ( size > 0 && page > 0 && size % page != 0 )
+		{
+			void* p = mmap( NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+			                fd, 0 );
+			if ( p != MAP_FAILED )
+			{
+				_data = static_cast<char*>(p);
+				_size = size;
+				_mapped = size;
+			}
+		}
+	}
+	close( fd );
+
+	if ( _mapped == 0 )
+		_read( maxSize );
+#else
+	_read( maxSize );
+#endif
+}
+
+inline ResponseFile::~ResponseFile()
+{
+#if defined(TCLAP_MMAP)
+	if ( _mapped > 0 )
+		munmap( _data, _mapped );
+#endif
+}
+
+inline void ResponseFile::_read( std::size_t maxSize )
+{
+	std::ifstream in( _path.c_str(), std::ios::in | std::ios::binary );
+	if ( !in )
+	{
+		_error = "Couldn't read response file";
+		return;
+	}
+
+	const std::size_t chunk = 65536;
+	std::size_t size = 0;
+	for (;;)
+	{
+		_buffer.resize( size + chunk );
+		in.read( &_buffer[size], chunk );
+		size += static_cast<std::size_t>(in.gcount());
+
+		if ( size > maxSize )
+		{
+			_error = "Response files exceed the size limit";
+			_buffer.clear();
+			return;
+		}
+		if ( !in )
+			break;
+	}
+
+	if ( in.bad() )
+	{
+		_error = "Couldn't read response file";
+		_buffer.clear();
+		return;
+	}
+
+	_buffer.resize( size + 1 );
+	_buffer[size] = '\0';
+	_data = &_buffer[0];
+	_size = size;
+}
+
+template<class Sink>
+bool ResponseFile::tokenize( Format format, Sink& sink )
+{
+	if ( format == LINES )
+		return _tokenizeLines( sink );
+	else if ( format == SHELL )
+		return _tokenizeShell( sink );
+	else
+		return true;
+}
+
+template<class Sink>
+bool ResponseFile::_tokenizeLines( Sink& sink )
+{
+	char* p = _data;
+	char* const end = _data + _size;
+	while ( p < end )
+	{
+		char* eol = static_cast<char*>(std::memchr( p, '\n', end - p ));
+		if ( eol == NULL )
+			eol = end;
+
+		char* e = eol;
+		if ( e > p && e[-1] == '\r' )
+			e--;
+
+		*e = '\0';
+		if ( e > p && !sink.addArgument( p, static_cast<std::size_t>(e - p) ) )
+			return false;
+
+		p = eol + 1;
+	}
+
+	return true;
+}
+
+template<class Sink>
+bool ResponseFile::_tokenizeShell( Sink& sink )
+{
+	const ShellTokenizer::Status status =
+		ShellTokenizer::split( _data, _size, sink, true );
+
+	if ( status == ShellTokenizer::UNTERMINATED_QUOTE )
+		_error = "Unterminated quote in response file";
+
+	return status == ShellTokenizer::COMPLETE;
+}
+
+} //namespace TCLAP
+
+#endif
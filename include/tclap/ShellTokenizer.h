@@ -0,0 +1,254 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+/******************************************************************************
+ *
+ *  file:  ShellTokenizer.h
+ *
+ *  Copyright (c) 2018, Google LLC
+ *  All rights reserved.
+ *
+ *  See the file COPYING in the top directory of this distribution for
+ *  more information.
+ *
+ *  THE SOFTWARE IS PROVIDED _AS IS_, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ *  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *  DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef TCLAP_SHELL_TOKENIZER_H
+#define TCLAP_SHELL_TOKENIZER_H
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <cstring>
+
+namespace TCLAP {
+
+/**
+ * Splits a command string into words by the quoting rules of sh: words
+ * are separated by white space, characters between single quotes are
+ * taken as they are, and a backslash escapes the next character, or
+ * only ", \, $, ` and a newline between double quotes.  Nothing is
+ * expanded.  The words are unquoted in place, each terminated by a NUL,
+ * so splitting a string allocates nothing per word.  Used for response
+ * files and by CmdLine::parseCommand().
+ */
+class ShellTokenizer
+{
+	public:
+
+		/**
+		 * How splitting a string ended.
+		 */
+		enum Status {
+			COMPLETE,          ///< all words were passed on
+			STOPPED,           ///< the sink didn't take a word
+			UNTERMINATED_QUOTE ///< a quote isn't closed
+		};
+
+		ShellTokenizer();
+
+		/**
+		 * Splits a copy of the command, which is kept in a buffer that
+		 * is reused by the next call.  Returns false for an
+		 * unterminated quote, the words before it are kept.
+		 * \param command - The command string.
+		 */
+		bool tokenize( const std::string& command );
+
+		/**
+		 * Splits the command in place, which modifies it.  Returns false
+		 * for an unterminated quote, the words before it are kept.
+		 * \param s - The command string, s[length] must be writable.
+		 * The words refer to it, so it must stay valid while they are
+		 * used.
+		 * \param length - The length of the command string.
+		 */
+		bool tokenize( char* s, std::size_t length );
+
+		/**
+		 * The number of words.
+		 */
+		std::size_t size() const { return _words.size(); }
+
+		/**
+		 * The i'th word, NUL terminated.
+		 */
+		const char* word( std::size_t i ) const { return _words[i].str; }
+
+		/**
+		 * The length of the i'th word.
+		 */
+		std::size_t length( std::size_t i ) const { return _words[i].length; }
+
+		/**
+		 * Whether the whole command was split, false for an unterminated
+		 * quote.
+		 */
+		bool complete() const { return _complete; }
+
+		/**
+		 * Adds a word, called by split().
+		 */
+		bool addArgument( const char* s, std::size_t length );
+
+		/**
+		 * Splits the string in place and passes each word to
+		 * sink.addArgument(const char* s, std::size_t length), which
+		 * returns false to stop.  The words only shrink as they are
+		 * unquoted, so they stay within the string.
+		 * \param s - The string, s[length] must be writable.
+		 * \param length - The length of the string.
+		 * \param sink - What is given the words.
+		 * \param comments - Whether a "#" at the start of a word starts
+		 * a comment that runs to the end of the line.
+		 */
+		template<class Sink>
+		static Status split( char* s, std::size_t length, Sink& sink,
+		                     bool comments );
+
+		static bool isSpace( char c )
+		{
+			return c == ' ' || c == '\t' || c == '\n' || c == '\r' ||
+			       c == '\v' || c == '\f';
+		}
+
+	private:
+
+		struct Word
+		{
+			const char* str;
+			std::size_t length;
+		};
+
+		/**
+		 * The copy of the last command given as a string.
+		 */
+		std::vector<char> _buffer;
+
+		std::vector<Word> _words;
+
+		bool _complete;
+};
+
+inline ShellTokenizer::ShellTokenizer()
+: _buffer(),
+  _words(),
+  _complete( true )
+{ }
+
+inline bool ShellTokenizer::tokenize( const std::string& command )
+{
+	_buffer.assign( command.begin(), command.end() );
+	_buffer.push_back( '\0' );
+	return tokenize( &_buffer[0], command.length() );
+}
+
+inline bool ShellTokenizer::tokenize( char* s, std::size_t length )
+{
+	_words.clear();
+	_complete = split( s, length, *this, false ) == COMPLETE;
+	return _complete;
+}
+
+inline bool ShellTokenizer::addArgument( const char* s, std::size_t length )
+{
+	Word w = { s, length };
+	_words.push_back( w );
+	return true;
+}
+
+template<class Sink>
+ShellTokenizer::Status ShellTokenizer::split( char* s, std::size_t length,
+                                              Sink& sink, bool comments )
+{
+	char* r = s;
+	char* const end = s + length;
+	for (;;)
+	{
+		while ( r < end && isSpace( *r ) )
+			r++;
+
+		if ( r == end )
+			break;
+
+		if ( comments && *r == '#' )
+		{
+			while ( r < end && *r != '\n' )
+				r++;
+			continue;
+		}
+
+		// the word is unquoted into its own place, it only shrinks
+		char* const begin = r;
+		char* w = r;
+		while ( r < end && !isSpace( *r ) )
+		{
+			const char c = *r++;
+			if ( c == '\'' )
+			{
+				char* q = static_cast<char*>(std::memchr( r, '\'', end - r ));
+				if ( q == NULL )
+					return UNTERMINATED_QUOTE;
+
+				std::memmove( w, r, q - r );
+				w += q - r;
+				r = q + 1;
+			}
+			else if ( c == '"' )
+			{
+				while ( r < end && *r != '"' )
+				{
+					if ( *r == '\\' && r + 1 < end &&
+					     std::memchr( "\"\\$`\n", r[1], 5 ) != NULL )
+					{
+						r++;
+						if ( *r == '\n' )
+						{
+							r++;
+							continue;
+						}
+					}
+					*w++ = *r++;
+				}
+
+				if ( r == end )
+					return UNTERMINATED_QUOTE;
+				r++;
+			}
+			else if ( c == '\\' )
+			{
+				// a backslash at the end is kept, as sh does
+				if ( r == end )
+					*w++ = c;
+				else if ( *r++ != '\n' )
+					*w++ = r[-1];
+			}
+			else
+				*w++ = c;
+		}
+
+		// step over the separator before it is overwritten
+		if ( r < end )
+			r++;
+
+		*w = '\0';
+		if ( !sink.addArgument( begin, static_cast<std::size_t>(w - begin) ) )
+			return STOPPED;
+	}
+
+	return COMPLETE;
+}
+
+} //namespace TCLAP
+
+#endif
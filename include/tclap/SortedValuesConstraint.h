@@ -0,0 +1,304 @@
+// -*- Mode: c++; c-basic-offset: 4; tab-width: 4; -*-
+
+/******************************************************************************
+ *
+ *  file:  SortedValuesConstraint.h
+ *
+ *  Copyright (c) 2018, Google LLC
+ *  All rights reserved.
+ *
+ *  See the file COPYING in the top directory of this distribution for
+ *  more information.
+ *
+ *  THE SOFTWARE IS PROVIDED _AS IS_, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ *  OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *  DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef TCLAP_SORTED_VALUES_CONSTRAINT_H
+#define TCLAP_SORTED_VALUES_CONSTRAINT_H
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <tclap/Constraint.h>
+#include <tclap/ArgTraits.h>
+#include <tclap/StandardTraits.h>
+#include <tclap/sstream.h>
+
+namespace TCLAP {
+
+/**
+ * A Constraint that constrains the Arg to the values of a set, like
+ * ValuesConstraint, for large sets of, e.g., thousands of identifiers.
+ * The values are sorted once so check() is a binary search, which needs
+ * an operator< for T.  The usage and the error message only show the
+ * first few values, rendered when they are first needed, and the error
+ * message names the allowed value nearest to the one given.
+ */
+template<class T>
+class SortedValuesConstraint : public Constraint<T>
+{
+
+	public:
+
+		/**
+		 * Constructor.
+		 * \param allowed - vector of allowed values.
+		 * \param maxShown - The number of values shown in the usage and
+		 * in error messages, in the order they are given.
+		 */
+		SortedValuesConstraint( const std::vector<T>& allowed,
+		                        std::size_t maxShown = 10 );
+
+		virtual ~SortedValuesConstraint() {}
+
+		/**
+		 * Returns a description of the Constraint, the values shown
+		 * followed by "..." if there are more.
+		 */
+		virtual std::string description() const;
+
+		/**
+		 * Returns the short ID for the Constraint, the same as the
+		 * description.
+		 */
+		virtual std::string shortID() const;
+
+		/**
+		 * The method used to verify that the value parsed from the command
+		 * line meets the constraint.
+		 * \param value - The value that will be checked.
+		 */
+		virtual bool check( const T& value ) const;
+
+		/**
+		 * Describes the Constraint and names the allowed value nearest
+		 * to the one given.
+		 * \param value - The value that failed check().
+		 */
+		virtual std::string failureDescription( const T& value ) const;
+
+		/**
+		 * The allowed value nearest to the given one: the one closest in
+		 * value for numbers, the one with the fewest edits for strings,
+		 * and the next one in order otherwise.
+		 * \param value - The value to look up, there must be an allowed
+		 * value.
+		 */
+		const T& nearest( const T& value ) const;
+
+	protected:
+
+		/**
+		 * The allowed values, sorted and without duplicates.
+		 */
+		std::vector<T> _sorted;
+
+		/**
+		 * The first values as given, those shown in the description.
+		 */
+		std::vector<T> _shown;
+
+		/**
+		 * Whether there are more values than are shown.
+		 */
+		bool _truncated;
+
+		/**
+		 * The description, rendered when it is first needed.
+		 */
+		mutable std::string _typeDesc;
+
+	private:
+
+		const T& _nearest( const T& value, NumberLike nl ) const;
+
+		const T& _nearest( const T& value, StringLike sl ) const;
+
+		const T& _nearest( const T& value, ValueLike vl ) const;
+
+		/**
+		 * The number of single character insertions, deletions and
+		 * substitutions that make one string the other, or more than
+		 * limit if that is less.
+		 */
+		static std::size_t _editDistance( const std::string& a,
+		                                  const std::string& b,
+		                                  std::size_t limit );
+
+		static std::string _render( const T& value );
+};
+
+template<class T>
+SortedValuesConstraint<T>::SortedValuesConstraint(
+	const std::vector<T>& allowed, std::size_t maxShown )
+: _sorted( allowed ),
+  _shown( allowed.begin(),
+          allowed.begin() + std::min( maxShown, allowed.size() ) ),
+  _truncated( allowed.size() > maxShown ),
+  _typeDesc()
+{
+	std::sort( _sorted.begin(), _sorted.end() );
+	_sorted.erase( std::unique( _sorted.begin(), _sorted.end() ),
+	               _sorted.end() );
+}
+
+template<class T>
+bool SortedValuesConstraint<T>::check( const T& value ) const
+{
+	return std::binary_search( _sorted.begin(), _sorted.end(), value );
+}
+
+template<class T>
+std::string SortedValuesConstraint<T>::description() const
+{
+	if ( _typeDesc.empty() && !_shown.empty() )
+	{
+		std::ostringstream os;
+		for ( std::size_t i = 0; i < _shown.size(); i++ )
+		{
+			if ( i > 0 )
+				os << "|";
+			os << _shown[i];
+		}
+
+		if ( _truncated )
+			os << "|...";
+		_typeDesc = os.str();
+	}
+
+	return _typeDesc;
+}
+
+template<class T>
+std::string SortedValuesConstraint<T>::shortID() const
+{
+	return description();
+}
+
+template<class T>
+std::string SortedValuesConstraint<T>::failureDescription(
+	const T& value ) const
+{
+	if ( _sorted.empty() )
+		return description();
+
+	return description() + " (nearest is '" + _render( nearest( value ) ) +
+	       "')";
+}
+
+template<class T>
+const T& SortedValuesConstraint<T>::nearest( const T& value ) const
+{
+	return _nearest( value, typename ArgTraits<T>::ValueCategory() );
+}
+
+template<class T>
+const T& SortedValuesConstraint<T>::_nearest( const T& value,
+                                              NumberLike nl ) const
+{
+	static_cast<void>(nl); // Ignore input, don't warn
+
+	typename std::vector<T>::const_iterator hi =
+		std::lower_bound( _sorted.begin(), _sorted.end(), value );
+	if ( hi == _sorted.begin() )
+		return *hi;
+	if ( hi == _sorted.end() )
+		return _sorted.back();
+
+	// both differences are positive, even for unsigned types
+	const T& lo = *(hi - 1);
+	return value - lo <= *hi - value ? lo : *hi;
+}
+
+template<class T>
+const T& SortedValuesConstraint<T>::_nearest( const T& value,
+                                              StringLike sl ) const
+{
+	static_cast<void>(sl); // Ignore input, don't warn
+
+	const std::string given = _render( value );
+	std::size_t best = 0;
+	std::size_t bestDistance = std::string::npos;
+	for ( std::size_t i = 0; i < _sorted.size() && bestDistance > 0; i++ )
+	{
+		const std::size_t d =
+			_editDistance( given, _render( _sorted[i] ), bestDistance );
+		if ( d < bestDistance )
+		{
+			best = i;
+			bestDistance = d;
+		}
+	}
+
+	return _sorted[best];
+}
+
+template<class T>
+const T& SortedValuesConstraint<T>::_nearest( const T& value,
+                                              ValueLike vl ) const
+{
+	static_cast<void>(vl); // Ignore input, don't warn
+
+	typename std::vector<T>::const_iterator it =
+		std::lower_bound( _sorted.begin(), _sorted.end(), value );
+	return it != _sorted.end() ? *it : _sorted.back();
+}
+
+template<class T>
+std::size_t SortedValuesConstraint<T>::_editDistance( const std::string& a,
+                                                      const std::string& b,
+                                                      std::size_t limit )
+{
+	const std::size_t la = a.length();
+	const std::size_t lb = b.length();
+	if ( ( la > lb ? la - lb : lb - la ) >= limit )
+		return limit;
+
+	// one row of the table at a time
+	std::vector<std::size_t> row( lb + 1 );
+	for ( std::size_t j = 0; j <= lb; j++ )
+		row[j] = j;
+
+	for ( std::size_t i = 1; i <= la; i++ )
+	{
+		std::size_t diagonal = row[0];
+		row[0] = i;
+		std::size_t rowMin = row[0];
+		for ( std::size_t j = 1; j <= lb; j++ )
+		{
+			const std::size_t above = row[j];
+			const std::size_t cost = a[i - 1] == b[j - 1] ? 0 : 1;
+			row[j] = std::min( std::min( above, row[j - 1] ) + 1,
+			                   diagonal + cost );
+			diagonal = above;
+			rowMin = std::min( rowMin, row[j] );
+		}
+
+		if ( rowMin >= limit )
+			return limit;
+	}
+
+	return row[lb];
+}
+
+template<class T>
+std::string SortedValuesConstraint<T>::_render( const T& value )
+{
+	std::ostringstream os;
+	os << value;
+	return os.str();
+}
+
+} //namespace TCLAP
+#endif
@@ -31,6 +31,8 @@
 #include <config.h> // To check for long long
 #endif
 
+#include <tclap/NumberParser.h>
+
 // If Microsoft has already typedef'd wchar_t as an unsigned 
 // short, then compiles will break because it's as if we're
 // creating ArgTraits twice for unsigned short. Thus...
@@ -43,7 +45,65 @@
 namespace TCLAP {
 
 // Integer types (signed, unsigned and bool) and floating point types all
-// have value-like semantics.
+// have value-like semantics.  Those that NumberParser.h can read are
+// number like, so their values are read without a stream.
+
+template<>
+struct ArgTraits<bool> {
+    typedef NumberLike ValueCategory;
+};
+
+template<>
+struct ArgTraits<short> {
+    typedef NumberLike ValueCategory;
+};
+
+template<>
+struct ArgTraits<unsigned short> {
+    typedef NumberLike ValueCategory;
+};
+
+template<>
+struct ArgTraits<int> {
+    typedef NumberLike ValueCategory;
+};
+
+template<>
+struct ArgTraits<unsigned int> {
+    typedef NumberLike ValueCategory;
+};
+
+template<>
+struct ArgTraits<long> {
+    typedef NumberLike ValueCategory;
+};
+
+template<>
+struct ArgTraits<unsigned long> {
+    typedef NumberLike ValueCategory;
+};
+
+#ifdef TCLAP_HAS_LONG_LONG
+template<>
+struct ArgTraits<long long> {
+    typedef NumberLike ValueCategory;
+};
+
+template<>
+struct ArgTraits<unsigned long long> {
+    typedef NumberLike ValueCategory;
+};
+#endif
+
+template<>
+struct ArgTraits<float> {
+    typedef NumberLike ValueCategory;
+};
+
+template<>
+struct ArgTraits<double> {
+    typedef NumberLike ValueCategory;
+};
 
 // Strings have string like argument traits.
 template<>
@@ -34,18 +34,34 @@
 #include <tclap/CmdLineOutput.h>
 #include <tclap/XorHandler.h>
 #include <tclap/Arg.h>
+#include <tclap/Mutex.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define TCLAP_TERMINAL_WIDTH
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
 
 namespace TCLAP {
 
 /**
  * A class that isolates any output from the CmdLine object so that it
- * may be easily modified.
+ * may be easily modified.  The messages are rendered into a buffer and
+ * written at once, wrapped to the width of the terminal they go to.
+ * The usage is kept until the Args of the CmdLine change, so printing
+ * it again doesn't render it again.
  */
 class StdOutput : public CmdLineOutput
 {
 
 	public:
 
+		StdOutput();
+
+		StdOutput( const StdOutput& rhs );
+
+		StdOutput& operator=( const StdOutput& rhs );
+
 		/**
 		 * Prints the usage to stdout.  Can be overridden to 
 		 * produce alternative behavior.
@@ -69,6 +85,27 @@ class StdOutput : public CmdLineOutput
 		virtual void failure(CmdLineInterface& c, 
 				     ArgException& e );
 
+		/**
+		 * Makes usage() print the given text, e.g. the usage rendered
+		 * at build time from a header written by a TCLAP_GENERATE
+		 * build, instead of rendering it.  The text is only used while
+		 * the program name is progName, and is printed as it was
+		 * rendered, whatever the width of the terminal.  Both strings
+		 * must outlive the output.
+		 * \param progName - The program name the text was rendered for.
+		 * \param text - The usage, or NULL to render it again.
+		 */
+		void setUsage( const char* progName, const char* text );
+
+		/**
+		 * Appends the usage, as usage() prints it, wrapped at width to
+		 * out.
+		 * \param c - The CmdLine object the output is generated for.
+		 * \param width - The width the usage is wrapped at.
+		 * \param out - The string the usage is appended to.
+		 */
+		void renderUsage( CmdLineInterface& c, int width, std::string& out );
+
 	protected:
 
         /**
@@ -78,6 +115,15 @@ class StdOutput : public CmdLineOutput
          */
         void _shortUsage( CmdLineInterface& c, std::ostream& os ) const;
 
+        /**
+         * Appends a brief usage message with short args to out.
+		 * \param c - The CmdLine object the output is generated for. 
+		 * \param width - The width the message is wrapped at.
+         * \param out - The string the message is appended to.
+         */
+        void _shortUsage( CmdLineInterface& c, int width,
+                          std::string& out ) const;
+
         /**
 		 * Writes a longer usage message with long and short args, 
 		 * provides descriptions and prints message.
@@ -86,6 +132,16 @@ class StdOutput : public CmdLineOutput
 		 */
 		void _longUsage( CmdLineInterface& c, std::ostream& os ) const;
 
+        /**
+		 * Appends a longer usage message with long and short args, 
+		 * descriptions and the message to out.
+		 * \param c - The CmdLine object the output is generated for. 
+		 * \param width - The width the message is wrapped at.
+		 * \param out - The string the message is appended to.
+		 */
+		void _longUsage( CmdLineInterface& c, int width,
+		                 std::string& out ) const;
+
 		/**
 		 * This function inserts line breaks and indents long strings 
 		 * according the  params input. It will only break lines at spaces, 
@@ -103,8 +159,110 @@ class StdOutput : public CmdLineOutput
 						 int indentSpaces, 
 						 int secondLineOffset ) const;
 
+		/**
+		 * Like spacePrint(std::ostream&, ...), but appends the lines to
+		 * out.
+		 */
+		void spacePrint( std::string& out, 
+						 const std::string& s, 
+						 int maxWidth, 
+						 int indentSpaces, 
+						 int secondLineOffset ) const;
+
+		/**
+		 * Returns the width to wrap the output to a file descriptor at:
+		 * one less than the columns of the terminal it refers to, or 75
+		 * if it isn't a terminal or one narrower than 40 columns.
+		 * \param fd - The file descriptor, 1 for stdout, 2 for stderr.
+		 */
+		static int _terminalWidth( int fd );
+
+	private:
+
+		/**
+		 * Appends the usage of c, wrapped at width, to out.
+		 */
+		void _renderUsage( CmdLineInterface& c, int width,
+		                   std::string& out ) const;
+
+		/**
+		 * Whether _usage holds the usage of c at the given width.  Must
+		 * be called with _cacheMutex locked.
+		 */
+		bool _isCached( CmdLineInterface& c, int width ) const;
+
+		/**
+		 * Guards the cached usage, so that several threads parsing with
+		 * one CmdLine can print it, see CmdLine::parse().  The usage is
+		 * rendered and printed without holding it.
+		 */
+		Mutex _cacheMutex;
+
+		/**
+		 * What the cached usage was rendered for.  A revision of 0
+		 * means it isn't kept.
+		 */
+		const CmdLineInterface* _cachedCmd;
+		unsigned long _cachedRevision;
+		int _cachedWidth;
+		std::string _cachedProgName;
+		std::string _cachedMessage;
+
+		/**
+		 * The rendered usage.
+		 */
+		std::string _usage;
+
+		/**
+		 * The usage given to setUsage(), and the program name it was
+		 * rendered for.
+		 */
+		const char* _textProgName;
+		const char* _text;
 };
 
+inline StdOutput::StdOutput()
+: CmdLineOutput(),
+  _cacheMutex(),
+  _cachedCmd( NULL ),
+  _cachedRevision( 0 ),
+  _cachedWidth( 0 ),
+  _cachedProgName(),
+  _cachedMessage(),
+  _usage(),
+  _textProgName( NULL ),
+  _text( NULL )
+{ }
+
+// a copy renders the usage anew
+inline StdOutput::StdOutput( const StdOutput& rhs )
+: CmdLineOutput( rhs ),
+  _cacheMutex(),
+  _cachedCmd( NULL ),
+  _cachedRevision( 0 ),
+  _cachedWidth( 0 ),
+  _cachedProgName(),
+  _cachedMessage(),
+  _usage(),
+  _textProgName( rhs._textProgName ),
+  _text( rhs._text )
+{ }
+
+inline StdOutput& StdOutput::operator=( const StdOutput& rhs )
+{
+	if ( this != &rhs )
+	{
+		CmdLineOutput::operator=( rhs );
+
+		MutexLock lock( _cacheMutex );
+		_cachedCmd = NULL;
+		_cachedRevision = 0;
+		_usage.clear();
+		_textProgName = rhs._textProgName;
+		_text = rhs._text;
+	}
+	return *this;
+}
 
 inline void StdOutput::version(CmdLineInterface& _cmd) 
 {
@@ -115,18 +273,77 @@ inline void StdOutput::version(CmdLineInterface& _cmd)
 			  << xversion << std::endl << std::endl;
 }
 
-inline void StdOutput::usage(CmdLineInterface& _cmd ) 
+inline void StdOutput::setUsage( const char* progName, const char* text )
 {
-	std::cout << std::endl << "USAGE: " << std::endl << std::endl; 
-
-	_shortUsage( _cmd, std::cout );
+	_textProgName = progName;
+	_text = text;
+}
 
-	std::cout << std::endl << std::endl << "Where: " << std::endl << std::endl;
+inline void StdOutput::renderUsage( CmdLineInterface& _cmd, int width,
+                                    std::string& out )
+{
+	_renderUsage( _cmd, width, out );
+}
 
-	_longUsage( _cmd, std::cout );
+inline void StdOutput::usage(CmdLineInterface& _cmd ) 
+{
+	// the usage rendered at build time
+	if ( _text != NULL && _textProgName != NULL &&
+	     _cmd.getProgramName() == _textProgName )
+	{
+		std::cout << _text;
+		std::cout.flush();
+		return;
+	}
+
+	const int width = _terminalWidth( 1 );
+
+	// the usage is only copied out of the cache and into it under the
+	// lock, it is rendered and printed from a buffer of this call
+	std::string out;
+	{
+		MutexLock lock( _cacheMutex );
+		if ( _isCached( _cmd, width ) )
+			out = _usage;
+	}
+
+	if ( out.empty() )
+	{
+		// about two lines per Arg
+		out.reserve( _cmd.getArgList().size() * 2 * width +
+		             _cmd.getMessage().length() + 64 );
+		_renderUsage( _cmd, width, out );
+
+		MutexLock lock( _cacheMutex );
+		_usage = out;
+		_cachedCmd = &_cmd;
+		_cachedRevision = _cmd.getRevision();
+		_cachedWidth = width;
+		_cachedProgName = _cmd.getProgramName();
+		_cachedMessage = _cmd.getMessage();
+	}
+
+	std::cout.write( out.data(), static_cast<std::streamsize>(out.size()) );
+	std::cout.flush();
+}
 
-	std::cout << std::endl; 
+inline void StdOutput::_renderUsage( CmdLineInterface& _cmd, int width,
+                                     std::string& out ) const
+{
+	out += "\nUSAGE: \n\n";
+	_shortUsage( _cmd, width, out );
+	out += "\n\nWhere: \n\n";
+	_longUsage( _cmd, width, out );
+	out += "\n";
+}
 
+inline bool StdOutput::_isCached( CmdLineInterface& _cmd, int width ) const
+{
+	return _cachedCmd == &_cmd && _cachedRevision != 0 &&
+	       _cachedRevision == _cmd.getRevision() &&
+	       _cachedWidth == width &&
+	       _cachedProgName == _cmd.getProgramName() &&
+	       _cachedMessage == _cmd.getMessage();
 }
 
 inline void StdOutput::failure( CmdLineInterface& _cmd,
@@ -134,34 +351,45 @@ inline void StdOutput::failure( CmdLineInterface& _cmd,
 {
 	std::string progName = _cmd.getProgramName();
 
-	std::cerr << "PARSE ERROR: " << e.argId() << std::endl
-		      << "             " << e.error() << std::endl << std::endl;
+	std::string s = "PARSE ERROR: " + e.argId() + "\n" +
+	                "             " + e.error() + "\n\n";
 
 	if ( _cmd.hasHelpAndVersion() )
 		{
-			std::cerr << "Brief USAGE: " << std::endl;
+			s += "Brief USAGE: \n";
 
-			_shortUsage( _cmd, std::cerr );	
+			_shortUsage( _cmd, _terminalWidth( 2 ), s );
 
-			std::cerr << std::endl << "For complete USAGE and HELP type: " 
-					  << std::endl << "   " << progName << " "
-					  << Arg::nameStartString() << "help"
-					  << std::endl << std::endl;
+			s += "\nFor complete USAGE and HELP type: \n   " + progName +
+			     " " + Arg::nameStartString() + "help\n\n";
+			std::cerr.write( s.data(), static_cast<std::streamsize>(s.size()) );
 		}
 	else
-		usage(_cmd);
+		{
+			std::cerr.write( s.data(), static_cast<std::streamsize>(s.size()) );
+			usage(_cmd);
+		}
 
-	throw ExitException(1);
+	TCLAP_THROW( ExitException(1) );
 }
 
 inline void 
 StdOutput::_shortUsage( CmdLineInterface& _cmd, 
 						std::ostream& os ) const
 {
-	std::list<Arg*> argList = _cmd.getArgList();
-	std::string progName = _cmd.getProgramName();
-	XorHandler xorHandler = _cmd.getXorHandler();
-	std::vector< std::vector<Arg*> > xorList = xorHandler.getXorList();
+	std::string out;
+	_shortUsage( _cmd, 75, out );
+	os << out;
+}
+
+inline void 
+StdOutput::_shortUsage( CmdLineInterface& _cmd, int width,
+						std::string& out ) const
+{
+	const std::list<Arg*>& argList = _cmd.getArgList();
+	const std::string& progName = _cmd.getProgramName();
+	XorHandler& xorHandler = _cmd.getXorHandler();
+	const std::vector< std::vector<Arg*> >& xorList = xorHandler.getXorList();
 
 	std::string s = progName + " ";
 
@@ -183,20 +411,29 @@ StdOutput::_shortUsage( CmdLineInterface& _cmd,
 
 	// if the program name is too long, then adjust the second line offset 
 	int secondLineOffset = static_cast<int>(progName.length()) + 2;
-	if ( secondLineOffset > 75/2 )
-		secondLineOffset = static_cast<int>(75/2);
+	if ( secondLineOffset > width/2 )
+		secondLineOffset = static_cast<int>(width/2);
 
-	spacePrint( os, s, 75, 3, secondLineOffset );
+	spacePrint( out, s, width, 3, secondLineOffset );
 }
 
 inline void 
 StdOutput::_longUsage( CmdLineInterface& _cmd, 
 					   std::ostream& os ) const
 {
-	std::list<Arg*> argList = _cmd.getArgList();
-	std::string message = _cmd.getMessage();
-	XorHandler xorHandler = _cmd.getXorHandler();
-	std::vector< std::vector<Arg*> > xorList = xorHandler.getXorList();
+	std::string out;
+	_longUsage( _cmd, 75, out );
+	os << out;
+}
+
+inline void 
+StdOutput::_longUsage( CmdLineInterface& _cmd, int width,
+					   std::string& out ) const
+{
+	const std::list<Arg*>& argList = _cmd.getArgList();
+	const std::string& message = _cmd.getMessage();
+	XorHandler& xorHandler = _cmd.getXorHandler();
+	const std::vector< std::vector<Arg*> >& xorList = xorHandler.getXorList();
 
 	// first the xor 
 	for ( int i = 0; static_cast<unsigned int>(i) < xorList.size(); i++ )
@@ -205,27 +442,27 @@ StdOutput::_longUsage( CmdLineInterface& _cmd,
 				  it != xorList[i].end(); 
 				  it++ )
 				{
-					spacePrint( os, (*it)->longID(), 75, 3, 3 );
-					spacePrint( os, (*it)->getDescription(), 75, 5, 0 );
+					spacePrint( out, (*it)->longID(), width, 3, 3 );
+					spacePrint( out, (*it)->getDescription(), width, 5, 0 );
 
 					if ( it+1 != xorList[i].end() )
-						spacePrint(os, "-- OR --", 75, 9, 0);
+						spacePrint( out, "-- OR --", width, 9, 0 );
 				}
-			os << std::endl << std::endl;
+			out += "\n\n";
 		}
 
 	// then the rest
 	for (ArgListIterator it = argList.begin(); it != argList.end(); it++)
 		if ( !xorHandler.contains( (*it) ) )
 			{
-				spacePrint( os, (*it)->longID(), 75, 3, 3 ); 
-				spacePrint( os, (*it)->getDescription(), 75, 5, 0 ); 
-				os << std::endl;
+				spacePrint( out, (*it)->longID(), width, 3, 3 ); 
+				spacePrint( out, (*it)->getDescription(), width, 5, 0 ); 
+				out += '\n';
 			}
 
-	os << std::endl;
+	out += '\n';
 
-	spacePrint( os, message, 75, 3, 0 );
+	spacePrint( out, message, width, 3, 0 );
 }
 
 inline void StdOutput::spacePrint( std::ostream& os, 
@@ -233,6 +470,17 @@ inline void StdOutput::spacePrint( std::ostream& os,
 						           int maxWidth, 
 						           int indentSpaces, 
 						           int secondLineOffset ) const
+{
+	std::string out;
+	spacePrint( out, s, maxWidth, indentSpaces, secondLineOffset );
+	os << out;
+}
+
+inline void StdOutput::spacePrint( std::string& out, 
+						           const std::string& s, 
+						           int maxWidth, 
+						           int indentSpaces, 
+						           int secondLineOffset ) const
 {
 	int len = static_cast<int>(s.length());
 
@@ -267,8 +515,7 @@ inline void StdOutput::spacePrint( std::ostream& os,
 							stringLen = i+1;
 
 					// print the indent	
-					for ( int i = 0; i < indentSpaces; i++ )
-						os << " ";
+					out.append( indentSpaces, ' ' );
 
 					if ( start == 0 )
 						{
@@ -279,7 +526,8 @@ inline void StdOutput::spacePrint( std::ostream& os,
 							allowedLen -= secondLineOffset;
 						}
 
-					os << s.substr(start,stringLen) << std::endl;
+					out.append( s, start, stringLen );
+					out += '\n';
 
 					// so we don't start a line with a space
 					while ( s[stringLen+start] == ' ' && start < len )
@@ -290,11 +538,24 @@ inline void StdOutput::spacePrint( std::ostream& os,
 		}
 	else
 		{
-			for ( int i = 0; i < indentSpaces; i++ )
-				os << " ";
-			os << s << std::endl;
+			out.append( indentSpaces, ' ' );
+			out += s;
+			out += '\n';
 		}
 }
 
+inline int StdOutput::_terminalWidth( int fd )
+{
+#if defined(TCLAP_TERMINAL_WIDTH) && defined(TIOCGWINSZ)
+	struct winsize ws;
+	if ( isatty( fd ) && ioctl( fd, TIOCGWINSZ, &ws ) == 0 &&
+	     ws.ws_col >= 40 )
+		return ws.ws_col - 1;
+#endif
+
+	static_cast<void>(fd); // Ignore input, don't warn
+	return 75;
+}
+
 } //namespace TCLAP
-#endif 
+#endif
@@ -105,9 +105,44 @@ public:
    */
   virtual bool processArg(int* i, std::vector<std::string>& args); 
 
+  /**
+   * Handles the processing of a classified argument.
+   * Marks the argument as set when the token is the flag or name.
+   * \param i - Pointer the the current argument in the list.
+   * \param tokens - The classified arguments.
+   * \param result - The outcome of the parse so far.
+   */
+  virtual bool processToken(int* i, ArgTokenList& tokens,
+                            ParseResult& result) const;
+
+  /**
+   * Marks the argument as set when the flag is combined with
+   * other switches.  The flag may only appear once.
+   * \param count - The number of times the flag appears.
+   * \param result - The outcome of the parse so far.
+   */
+  virtual bool processCombinedFlag(std::size_t count,
+                                   ParseResult& result) const;
+
+  /**
+   * Records the error processCombinedFlag() would report: the switch
+   * being excluded or already set, or appearing more than once.
+   * \param count - The number of times the flag appears.
+   * \param result - The outcome of the parse so far.
+   */
+  virtual void checkCombinedFlag(std::size_t count,
+                                 ParseResult& result) const;
+
+  /**
+   * Sets the _value of the argument.
+   * \param result - The outcome of the parse.
+   */
+  virtual void storeResult(ParseResult& result);
+
   /**
    * Checks a string to see if any of the chars in the string
-   * match the flag for this Switch.
+   * match the flag for this Switch.  Not used by CmdLine, which decodes
+   * combined switches itself, see processCombinedFlag().
    */
   bool combinedSwitchesMatch(std::string& combined);
 
@@ -122,20 +157,22 @@ public:
    * same as calling getValue()
    */
   operator bool() const { return _value; }
-                
-  virtual void reset();
 
-private:
   /**
-   * Checks to see if we've found the last match in
-   * a combined string.
+   * Returns whether or not the switch was set in a parse, i.e. the
+   * opposite of the default if it was.
+   * \param result - The outcome of the parse.
    */
-  bool lastCombined(std::string& combined);
+  bool getValue(const ParseResult& result) const
+  { return isSet( result ) ? !_default : _default; }
+                
+  virtual void reset();
 
+private:
   /**
-   * Does the common processing of processArg.
+   * Does the common processing of processToken and processCombinedFlag.
    */
-  void commonProcessing();
+  void commonProcessing(ParseResult& result) const;
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -164,15 +201,6 @@ inline SwitchArg::SwitchArg(const std::string& flag,
   parser.add( this );
 }
 
-inline bool SwitchArg::lastCombined(std::string& combinedSwitches ) 
-{
-  for ( unsigned int i = 1; i < combinedSwitches.length(); i++ )
-    if ( combinedSwitches[i] != Arg::blankChar() )
-      return false;
-        
-  return true;
-}
-
 inline bool SwitchArg::combinedSwitchesMatch(std::string& combinedSwitches )
 {
   // make sure this is actually a combined switch
@@ -186,7 +214,7 @@ inline bool SwitchArg::combinedSwitchesMatch(std::string& combinedSwitches )
     return false;
 
   // make sure the delimiter isn't in the string 
-  if ( combinedSwitches.find_first_of(Arg::delimiter()) != std::string::npos)
+  if ( combinedSwitches.find_first_of(_delimiter) != std::string::npos)
     return false;
 
   // ok, we're not specifying a ValueArg, so we know that we have
@@ -208,55 +236,74 @@ inline bool SwitchArg::combinedSwitchesMatch(std::string& combinedSwitches )
   return false;   
 }
 
-inline void SwitchArg::commonProcessing()
+inline void SwitchArg::commonProcessing(ParseResult& result) const
 {
-  if ( _xorSet )
-    throw(CmdLineParseException(
-				"Mutually exclusive argument already set!", toString()));
-
-  if ( _alreadySet ) 
-    throw(CmdLineParseException("Argument already set!", toString()));
-
-  _alreadySet = true;
-
-  if ( _value == true )
-    _value = false;
+  if ( _isXorSet( result ) )
+    result.setError( ParseResult::EXCLUSIVE_SET, this );
+  else if ( isSet( result ) ) 
+    result.setError( ParseResult::ALREADY_SET, this );
   else
-    _value = true;
-
-  _checkWithVisitor();
+    {
+      result.setState( _stateIndex( result ) );
+      _checkWithVisitor( result );
+    }
 }
 
 inline bool SwitchArg::processArg(int *i, std::vector<std::string>& args)
 {
-  if ( _ignoreable && Arg::ignoreRest() )
+  return Arg::processArg( i, args );
+}
+
+inline bool SwitchArg::processToken(int *i, ArgTokenList& tokens,
+                                    ParseResult& result) const
+{
+  if ( _ignoreable && result.ignoreRest() )
     return false;
 
+  const ArgToken& token = tokens[*i];
+
   // if the whole string matches the flag or name string
-  if ( argMatches( args[*i] ) )
+  if ( !token.hasValue() && tokenMatches( token ) )
     {
-      commonProcessing();
+      commonProcessing( result );
 
       return true;
     }
-  // if a substring matches the flag as part of a combination
-  else if ( combinedSwitchesMatch( args[*i] ) )
-    {
-      // check again to ensure we don't misinterpret 
-      // this as a MultiSwitchArg 
-      if ( combinedSwitchesMatch( args[*i] ) )
-	throw(CmdLineParseException("Argument already set!", 
-				    toString()));
-
-      commonProcessing();
-
-      // We only want to return true if we've found the last combined
-      // match in the string, otherwise we return true so that other 
-      // switches in the combination will have a chance to match.
-      return lastCombined( args[*i] );
-    }
-  else
+
+  return false;
+}
+
+inline bool SwitchArg::processCombinedFlag(std::size_t count,
+                                           ParseResult& result) const
+{
+  if ( _ignoreable && result.ignoreRest() )
     return false;
+
+  // don't misinterpret this as a MultiSwitchArg 
+  if ( count > 1 )
+    result.setError( ParseResult::ALREADY_SET, this );
+  else
+    commonProcessing( result );
+
+  return true;
+}
+
+inline void SwitchArg::checkCombinedFlag(std::size_t count,
+                                         ParseResult& result) const
+{
+  if ( _ignoreable && result.ignoreRest() )
+    return;
+
+  if ( _isXorSet( result ) )
+    result.setError( ParseResult::EXCLUSIVE_SET, this );
+  else if ( count > 1 || isSet( result ) )
+    result.setError( ParseResult::ALREADY_SET, this );
+}
+
+inline void SwitchArg::storeResult(ParseResult& result)
+{
+  Arg::storeResult( result );
+  _value = !_default;
 }
 
 inline void SwitchArg::reset()
@@ -46,8 +46,9 @@ class UnlabeledMultiArg : public MultiArg<T>
 	// If compiler has two stage name lookup (as gcc >= 3.4 does)
 	// this is required to prevent undef. symbols
 	using MultiArg<T>::_ignoreable;
-	using MultiArg<T>::_hasBlanks;
 	using MultiArg<T>::_extractValue;
+	using MultiArg<T>::_addValue;
+	using MultiArg<T>::_resultState;
 	using MultiArg<T>::_typeDesc;
 	using MultiArg<T>::_name;
 	using MultiArg<T>::_description;
@@ -161,6 +162,16 @@ class UnlabeledMultiArg : public MultiArg<T>
 		 */
 		virtual bool processArg(int* i, std::vector<std::string>& args); 
 
+		/**
+		 * Handles the processing of a classified argument.  Takes any
+		 * argument that isn't part of a combination of switches.
+		 * \param i - Pointer the the current argument in the list.
+		 * \param tokens - The classified arguments.
+		 * \param result - The outcome of the parse so far.
+		 */
+		virtual bool processToken(int* i, ArgTokenList& tokens,
+		                          ParseResult& result) const;
+
 		/**
 		 * Returns the a short id string.  Used in the usage.
 		 * \param val - value to be used.
@@ -184,6 +195,18 @@ class UnlabeledMultiArg : public MultiArg<T>
 		 * \param argList - The list this should be added to.
 		 */
 		virtual void addToList( std::list<Arg*>& argList ) const;
+
+	protected:
+
+		/**
+		 * Any of the tokens left may be a value.
+		 * \param result - The outcome of the parse so far.
+		 * \param tokens - The classified arguments.
+		 * \param i - The index of the first token.
+		 */
+		virtual std::size_t _countValues( const ParseResult& result,
+		                                  const ArgTokenList& tokens,
+		                                  int i ) const;
 };
 
 template<class T>
@@ -196,7 +219,6 @@ UnlabeledMultiArg<T>::UnlabeledMultiArg(const std::string& name,
 : MultiArg<T>("", name, desc,  req, typeDesc, v)
 { 
 	_ignoreable = ignoreable;
-	OptionalUnlabeledTracker::check(true, toString());
 }
 
 template<class T>
@@ -210,7 +232,6 @@ UnlabeledMultiArg<T>::UnlabeledMultiArg(const std::string& name,
 : MultiArg<T>("", name, desc,  req, typeDesc, v)
 { 
 	_ignoreable = ignoreable;
-	OptionalUnlabeledTracker::check(true, toString());
 	parser.add( this );
 }
 
@@ -225,7 +246,6 @@ UnlabeledMultiArg<T>::UnlabeledMultiArg(const std::string& name,
 : MultiArg<T>("", name, desc,  req, constraint, v)
 { 
 	_ignoreable = ignoreable;
-	OptionalUnlabeledTracker::check(true, toString());
 }
 
 template<class T>
@@ -239,7 +259,6 @@ UnlabeledMultiArg<T>::UnlabeledMultiArg(const std::string& name,
 : MultiArg<T>("", name, desc,  req, constraint, v)
 { 
 	_ignoreable = ignoreable;
-	OptionalUnlabeledTracker::check(true, toString());
 	parser.add( this );
 }
 
@@ -247,15 +266,23 @@ UnlabeledMultiArg<T>::UnlabeledMultiArg(const std::string& name,
 template<class T>
 bool UnlabeledMultiArg<T>::processArg(int *i, std::vector<std::string>& args) 
 {
+	return Arg::processArg( i, args );
+}
 
-	if ( _hasBlanks( args[*i] ) )
+template<class T>
+bool UnlabeledMultiArg<T>::processToken(int *i, ArgTokenList& tokens,
+                                        ParseResult& result) const
+{
+
+	if ( tokens[*i].consumed() > 0 )
 		return false;
 
 	// never ignore an unlabeled multi arg
 
 
 	// always take the first value, regardless of the start string 
-	_extractValue( args[(*i)] );
+	_addValue( result, _resultState( result, tokens, *i ), tokens[*i].c_str(),
+	           tokens[*i].length() );
 
 	/*
 	// continue taking args until we hit the end or a start string 
@@ -265,11 +292,18 @@ bool UnlabeledMultiArg<T>::processArg(int *i, std::vector<std::string>& args)
 		_extractValue( args[++(*i)] );
 	*/
 
-	_alreadySet = true;
-
 	return true;
 }
 
+template<class T>
+std::size_t UnlabeledMultiArg<T>::_countValues( const ParseResult& result,
+                                                const ArgTokenList& tokens,
+                                                int i ) const
+{
+	static_cast<void>(result); // Ignore input, don't warn
+	return tokens.size() - static_cast<std::size_t>(i);
+}
+
 template<class T>
 std::string UnlabeledMultiArg<T>::shortID(const std::string& val) const
 {
@@ -49,7 +49,6 @@ class UnlabeledValueArg : public ValueArg<T>
 	// If compiler has two stage name lookup (as gcc >= 3.4 does)
 	// this is required to prevent undef. symbols
 	using ValueArg<T>::_ignoreable;
-	using ValueArg<T>::_hasBlanks;
 	using ValueArg<T>::_extractValue;
 	using ValueArg<T>::_typeDesc;
 	using ValueArg<T>::_name;
@@ -186,6 +185,16 @@ class UnlabeledValueArg : public ValueArg<T>
 		 */
 		virtual bool processArg(int* i, std::vector<std::string>& args); 
 
+		/**
+		 * Handles the processing of a classified argument.  Takes any
+		 * argument that isn't part of a combination of switches.
+		 * \param i - Pointer the the current argument in the list.
+		 * \param tokens - The classified arguments.
+		 * \param result - The outcome of the parse so far.
+		 */
+		virtual bool processToken(int* i, ArgTokenList& tokens,
+		                          ParseResult& result) const;
+
 		/**
 		 * Overrides shortID for specific behavior.
 		 */
@@ -223,9 +232,6 @@ UnlabeledValueArg<T>::UnlabeledValueArg(const std::string& name,
 : ValueArg<T>("", name, desc, req, val, typeDesc, v)
 { 
 	_ignoreable = ignoreable;
-
-	OptionalUnlabeledTracker::check(req, toString());
-
 }
 
 template<class T>
@@ -240,7 +246,6 @@ UnlabeledValueArg<T>::UnlabeledValueArg(const std::string& name,
 : ValueArg<T>("", name, desc, req, val, typeDesc, v)
 { 
 	_ignoreable = ignoreable;
-	OptionalUnlabeledTracker::check(req, toString());
 	parser.add( this );
 }
 
@@ -258,7 +263,6 @@ UnlabeledValueArg<T>::UnlabeledValueArg(const std::string& name,
 : ValueArg<T>("", name, desc, req, val, constraint, v)
 { 
 	_ignoreable = ignoreable;
-	OptionalUnlabeledTracker::check(req, toString());
 }
 
 template<class T>
@@ -273,7 +277,6 @@ UnlabeledValueArg<T>::UnlabeledValueArg(const std::string& name,
 : ValueArg<T>("", name, desc, req, val, constraint,  v)
 { 
 	_ignoreable = ignoreable;
-	OptionalUnlabeledTracker::check(req, toString());
 	parser.add( this );
 }
 
@@ -282,18 +285,27 @@ UnlabeledValueArg<T>::UnlabeledValueArg(const std::string& name,
  */
 template<class T>
 bool UnlabeledValueArg<T>::processArg(int *i, std::vector<std::string>& args) 
+{
+	return Arg::processArg( i, args );
+}
+
+/**
+ * Implementation of processToken().
+ */
+template<class T>
+bool UnlabeledValueArg<T>::processToken(int *i, ArgTokenList& tokens,
+                                        ParseResult& result) const
 {
 	
-	if ( _alreadySet )
+	if ( this->isSet( result ) )
 		return false;
 	
-	if ( _hasBlanks( args[*i] ) )
+	if ( tokens[*i].consumed() > 0 )
 		return false;
 
 	// never ignore an unlabeled arg
 	
-	_extractValue( args[*i] );
-	_alreadySet = true;
+	_extractValue( result, tokens[*i].str() );
 	return true;
 }
 
@@ -28,6 +28,7 @@
 
 #include <string>
 #include <vector>
+#include <algorithm>
 
 #include <tclap/Arg.h>
 #include <tclap/Constraint.h>
@@ -74,6 +75,12 @@ protected:
    */
   Constraint<T>* _constraint;
 
+  /**
+   * The value given on the command line while it hasn't been converted
+   * into _value, see CmdLine::setLazyConversion().
+   */
+  std::vector<std::string> _pending;
+
   /**
    * Extracts the value from the string.
    * Attempts to parse string as type T, if this fails an exception
@@ -82,6 +89,51 @@ protected:
    */
   void _extractValue( const std::string& val );
 
+  /**
+   * Extracts the value from the string into the given variable,
+   * throwing an ArgException if it is invalid.
+   * \param value - Where the value is stored.
+   * \param val - value to be parsed. 
+   */
+  void _extractValue( T& value, const std::string& val ) const;
+
+  /**
+   * Extracts the value from the string into the given variable.  If it
+   * is invalid the error is recorded and false is returned.
+   * \param value - Where the value is stored.
+   * \param val - value to be parsed. 
+   * \param errors - Where an error is recorded.
+   */
+  bool _extractValue( T& value, const std::string& val,
+                      ParseResult& errors ) const;
+
+  /**
+   * Extracts the value from the string and records it as the value of
+   * this argument in the result, or records the error if it is invalid.
+   * \param result - The outcome of the parse so far.
+   * \param val - value to be parsed. 
+   */
+  void _extractValue( ParseResult& result, const std::string& val ) const;
+
+  /**
+   * Converts the value given on the command line, if it is still
+   * pending, throwing an ArgException if it is invalid.  If it is
+   * invalid it stays pending, so reading it again fails again.
+   * \param value - Where the value is stored.
+   * \param pending - The value given, if it hasn't been converted.
+   */
+  void _convertPending( T& value, std::vector<std::string>& pending ) const;
+
+  /**
+   * Converts the value given on the command line, if it is still
+   * pending, recording the error if it is invalid.  See above.
+   * \param value - Where the value is stored.
+   * \param pending - The value given, if it hasn't been converted.
+   * \param errors - Where an error is recorded.
+   */
+  bool _convertPending( T& value, std::vector<std::string>& pending,
+                        ParseResult& errors ) const;
+
 public:
 
   /**
@@ -221,13 +273,63 @@ public:
   virtual bool processArg(int* i, std::vector<std::string>& args); 
 
   /**
-   * Returns the value of the argument.
+   * Handles the processing of a classified argument.
+   * Reads the value of the argument from the value following the
+   * delimiter or from the next argument.
+   * \param i - Pointer the the current argument in the list.
+   * \param tokens - The classified arguments.
+   * \param result - The outcome of the parse so far.
+   */
+  virtual bool processToken(int* i, ArgTokenList& tokens,
+                            ParseResult& result) const;
+
+  /**
+   * Sets the _value of the argument to the value that was read.
+   * \param result - The outcome of the parse.
    */
-  const T& getValue() const { return _value; }
+  virtual void storeResult(ParseResult& result);
+
+  /**
+   * Returns the value of the argument.  A value that is converted
+   * lazily is converted now, which throws an ArgException if it is
+   * invalid.
+   */
+  const T& getValue() const;
+
+  /**
+   * Returns the value of the argument read in a parse, or the default
+   * if the argument wasn't matched.  See above.
+   * \param result - The outcome of the parse.
+   */
+  const T& getValue(const ParseResult& result) const;
 
   // TODO(macbishop): Non-const variant is deprecated, don't
   // use. Remove in next major.
-  T& getValue() { return _value; }
+  T& getValue();
+
+  /**
+   * Converts the value stored in this Arg if it is pending.
+   */
+  virtual void validate();
+
+  /**
+   * Converts the value recorded in the result if it is pending.
+   * \param result - The outcome of the parse.
+   */
+  virtual void validate(const ParseResult& result) const;
+
+  /**
+   * Converts the value recorded in the result if it is pending,
+   * recording the error in the result if it is invalid.
+   * \param result - The outcome of the parse.
+   */
+  virtual bool tryValidate(ParseResult& result) const;
+
+  /**
+   * Describes the constraint the given value doesn't meet.
+   * \param value - The value as it was given.
+   */
+  virtual std::string constraintFailure(const std::string& value) const;
 
   /**
    * A ValueArg can be used as as its value type (T) This is the
@@ -273,7 +375,8 @@ ValueArg<T>::ValueArg(const std::string& flag,
     _value( val ),
     _default( val ),
     _typeDesc( typeDesc ),
-    _constraint( NULL )
+    _constraint( NULL ),
+    _pending()
 { }
 
 template<class T>
@@ -289,7 +392,8 @@ ValueArg<T>::ValueArg(const std::string& flag,
     _value( val ),
     _default( val ),
     _typeDesc( typeDesc ),
-    _constraint( NULL )
+    _constraint( NULL ),
+    _pending()
 { 
   parser.add( this );
 }
@@ -306,7 +410,8 @@ ValueArg<T>::ValueArg(const std::string& flag,
     _value( val ),
     _default( val ),
     _typeDesc( Constraint<T>::shortID(constraint) ),
-    _constraint( constraint )
+    _constraint( constraint ),
+    _pending()
 { }
 
 template<class T>
@@ -323,7 +428,8 @@ ValueArg<T>::ValueArg(const std::string& flag,
     _default( val ),
     _typeDesc( Constraint<T>::shortID(constraint) ),  // TODO(macbishop): Will crash
     // if constraint is NULL
-    _constraint( constraint )
+    _constraint( constraint ),
+    _pending()
 { 
   parser.add( this );
 }
@@ -334,53 +440,129 @@ ValueArg<T>::ValueArg(const std::string& flag,
 template<class T>
 bool ValueArg<T>::processArg(int *i, std::vector<std::string>& args)
 {
-  if ( _ignoreable && Arg::ignoreRest() )
-    return false;
+  return Arg::processArg( i, args );
+}
 
-  if ( _hasBlanks( args[*i] ) )
+/**
+ * Implementation of processToken().
+ */
+template<class T>
+bool ValueArg<T>::processToken(int *i, ArgTokenList& tokens,
+                               ParseResult& result) const
+{
+  if ( _ignoreable && result.ignoreRest() )
     return false;
 
-  std::string flag = args[*i];
-
-  std::string value = "";
-  trimFlag( flag, value );
+  const ArgToken& token = tokens[*i];
 
-  if ( argMatches( flag ) )
+  if ( tokenMatches( token ) )
     {
-      if ( _alreadySet )
-        {
-          if ( _xorSet )
-            throw( CmdLineParseException("Mutually exclusive argument"
-                                         " already set!", toString()));
-          else
-            throw( CmdLineParseException("Argument already set!", 
-                                         toString()) );
-        }
-
-      if ( Arg::delimiter() != ' ' && value == "" )
-        throw( ArgParseException("Couldn't find delimiter for this argument!",
-                                 toString() ) );
-
-      if ( value == "" )
+      if ( _isXorSet( result ) )
+        result.setError( ParseResult::EXCLUSIVE_SET, this );
+      else if ( isSet( result ) )
+        result.setError( ParseResult::ALREADY_SET, this );
+      else if ( _delimiter != ' ' && token.valueLength() == 0 )
+        result.setError( ParseResult::MISSING_DELIMITER, this );
+      else if ( token.valueLength() == 0 )
         {
           (*i)++;
-          if ( static_cast<unsigned int>(*i) < args.size() ) 
-            _extractValue( args[*i] );
+          if ( static_cast<unsigned int>(*i) < tokens.size() ) 
+            _extractValue( result, tokens[*i].str() );
           else
-            throw( ArgParseException("Missing a value for this argument!",
-                                     toString() ) );
+            result.setError( ParseResult::MISSING_VALUE, this );
         }
       else
-        _extractValue( value );
+        _extractValue( result, token.value() );
                                 
-      _alreadySet = true;
-      _checkWithVisitor();
+      _checkWithVisitor( result );
       return true;
     }   
   else
     return false;
 }
 
+template<class T>
+void ValueArg<T>::storeResult(ParseResult& result)
+{
+  Arg::storeResult( result );
+
+  ArgState* state = result.getState( _stateIndex( result ) );
+  if ( state != NULL )
+    {
+      LazyValueState<T>* s = static_cast<LazyValueState<T>*>(state);
+      std::swap( _value, s->value );
+      _pending.swap( s->pending );
+    }
+}
+
+template<class T>
+const T& ValueArg<T>::getValue() const
+{
+  if ( !_pending.empty() )
+    {
+      ValueArg<T>* self = const_cast<ValueArg<T>*>(this);
+      _convertPending( self->_value, self->_pending );
+    }
+
+  return _value;
+}
+
+template<class T>
+T& ValueArg<T>::getValue()
+{
+  _convertPending( _value, _pending );
+  return _value;
+}
+
+template<class T>
+const T& ValueArg<T>::getValue(const ParseResult& result) const
+{
+  ArgState* state = result.getState( _stateIndex( result ) );
+  if ( state != NULL )
+    {
+      LazyValueState<T>* s = static_cast<LazyValueState<T>*>(state);
+      _convertPending( s->value, s->pending );
+      return s->value;
+    }
+  else
+    return _default;
+}
+
+template<class T>
+void ValueArg<T>::validate()
+{
+  _convertPending( _value, _pending );
+}
+
+template<class T>
+void ValueArg<T>::validate(const ParseResult& result) const
+{
+  getValue( result );
+}
+
+template<class T>
+bool ValueArg<T>::tryValidate(ParseResult& result) const
+{
+  ArgState* state = result.getState( _stateIndex( result ) );
+  if ( state == NULL )
+    return true;
+
+  LazyValueState<T>* s = static_cast<LazyValueState<T>*>(state);
+  return _convertPending( s->value, s->pending, result );
+}
+
+template<class T>
+std::string ValueArg<T>::constraintFailure(const std::string& value) const
+{
+  if ( _constraint == NULL )
+    return "";
+
+  // read again, only when the message is put together
+  T v = _default;
+  TryExtractValue( v, value, typename ArgTraits<T>::ValueCategory() );
+  return _constraint->failureDescription( v );
+}
+
 /**
  * Implementation of shortID.
  */
@@ -404,18 +586,109 @@ std::string ValueArg<T>::longID(const std::string& val) const
 template<class T>
 void ValueArg<T>::_extractValue( const std::string& val ) 
 {
+  _extractValue( _value, val );
+}
+
+template<class T>
+void ValueArg<T>::_extractValue( T& value, const std::string& val ) const
+{
+  ParseResult errors;
+  if ( !_extractValue( value, val, errors ) )
+    errors.throwError();
+}
+
+template<class T>
+bool ValueArg<T>::_extractValue( T& value, const std::string& val,
+                                 ParseResult& errors ) const
+{
+  ParseResult::ErrorCode code;
+#if TCLAP_HAS_EXCEPTIONS
   try {
-    ExtractValue(_value, val, typename ArgTraits<T>::ValueCategory());
-  } catch( ArgParseException &e) {
-    throw ArgParseException(e.error(), toString());
+    code = TryExtractValue( value, val,
+                            typename ArgTraits<T>::ValueCategory() );
+  } catch ( ArgParseException& e ) {
+    // thrown by the operator>> of T
+    errors.setError( ParseResult::INVALID_VALUE, this, val );
+    errors.setErrorText( e.error() );
+    return false;
   }
-    
-  if ( _constraint != NULL )
-    if ( ! _constraint->check( _value ) )
-      throw( CmdLineParseException( "Value '" + val + 
-                                    + "' does not meet constraint: " 
-                                    + _constraint->description(),
-                                    toString() ) );
+#else
+  code = TryExtractValue( value, val, typename ArgTraits<T>::ValueCategory() );
+#endif
+
+  if ( code != ParseResult::NO_PARSE_ERROR )
+    {
+      errors.setError( code, this, val );
+      return false;
+    }
+
+  if ( _constraint != NULL && !_constraint->check( value ) )
+    {
+      errors.setError( ParseResult::CONSTRAINT_FAILED, this, val );
+      return false;
+    }
+
+  return true;
+}
+
+template<class T>
+void ValueArg<T>::_extractValue( ParseResult& result,
+                                 const std::string& val ) const
+{
+  // the state of an earlier parse is reset rather than allocated again
+  const std::size_t index = _stateIndex( result );
+  LazyValueState<T>* state = static_cast<LazyValueState<T>*>(
+    result.getSpareState( index, this ) );
+  const bool spare = state != NULL;
+  if ( spare )
+    {
+      state->value = _default;
+      state->pending.clear();
+    }
+  else
+    {
+      state = new LazyValueState<T>( _default, std::vector<std::string>() );
+      state->arg = this;
+    }
+
+  if ( result.convertsLazily() )
+    state->pending.push_back( val );
+  else if ( !_extractValue( state->value, val, result ) )
+    {
+      // only recorded once the value is valid
+      if ( !spare )
+        delete state;
+      return;
+    }
+
+  result.setState( index, state );
+}
+
+template<class T>
+void ValueArg<T>::_convertPending( T& value,
+                                   std::vector<std::string>& pending ) const
+{
+  if ( pending.empty() )
+    return;
+
+  ParseResult errors;
+  if ( !_convertPending( value, pending, errors ) )
+    errors.throwError();
+}
+
+template<class T>
+bool ValueArg<T>::_convertPending( T& value,
+                                   std::vector<std::string>& pending,
+                                   ParseResult& errors ) const
+{
+  if ( pending.empty() )
+    return true;
+
+  if ( !_extractValue( value, pending.front(), errors ) )
+    return false;
+
+  pending.clear();
+  return true;
 }
 
 template<class T>
@@ -423,6 +696,7 @@ void ValueArg<T>::reset()
 {
   Arg::reset();
   _value = _default;
+  _pending.clear();
 }
 
 } // namespace TCLAP
@@ -94,17 +94,16 @@ ValuesConstraint<T>::ValuesConstraint(std::vector<T> const& allowed)
 : _allowed(allowed),
   _typeDesc("")
 { 
+    // one stream for all the values, see SortedValuesConstraint for
+    // large sets
+    std::ostringstream os;
     for ( unsigned int i = 0; i < _allowed.size(); i++ )
     {
-        std::ostringstream os;
-        os << _allowed[i];
-
-        std::string temp( os.str() ); 
-
         if ( i > 0 )
-			_typeDesc += "|";
-        _typeDesc += temp;
+            os << "|";
+        os << _allowed[i];
     }
+    _typeDesc = os.str();
 }
 
 template<class T>
@@ -27,6 +27,8 @@
 #include <tclap/CmdLineInterface.h>
 #include <tclap/CmdLineOutput.h>
 #include <tclap/Visitor.h>
+#include <tclap/ArgException.h>
+#include <tclap/ParseResult.h>
 
 namespace TCLAP {
 
@@ -71,9 +73,25 @@ class VersionVisitor: public Visitor
 		 */
 		void visit() { 
 		    (*_out)->version(*_cmd); 
-		    throw ExitException(0); 
+		    TCLAP_THROW( ExitException(0) ); 
 		}
 
+		/**
+		 * Calls the version method and asks the parse to exit.
+		 * \param result - The outcome of the parse so far.
+		 */
+		void visitParse( ParseResult& result )
+		{
+			(*_out)->version(*_cmd);
+			result.requestExit(0);
+		}
+
+		/**
+		 * Asks the parse to exit without printing the version.
+		 * \param result - The outcome of the parse so far.
+		 */
+		void skipParse( ParseResult& result ) { result.requestExit(0); }
+
 };
 
 }
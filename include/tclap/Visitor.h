@@ -28,6 +28,8 @@
 
 namespace TCLAP {
 
+class ParseResult;
+
 /**
  * A base class that defines the interface for visitors.
  */
@@ -50,6 +52,32 @@ class Visitor
 		 * called when the visitor is visited.
 		 */
 		virtual void visit() = 0;
+
+		/**
+		 * Called instead of visit() when the visitor is visited during a
+		 * parse, so the visitor can ask the parse to stop rather than
+		 * throw, see ParseResult::requestExit().  Calls visit() by
+		 * default.
+		 * \param result - The outcome of the parse so far.
+		 */
+		virtual void visitParse( ParseResult& result )
+		{
+			static_cast<void>(result); // Ignore input, don't warn
+			visit();
+		}
+
+		/**
+		 * Called instead of visitParse() when the parse doesn't run
+		 * the Visitors but exits where they would, see
+		 * ParseResult::setExitsQuietly().  A Visitor that prints
+		 * something and exits only asks the parse to exit.  Does
+		 * nothing by default.
+		 * \param result - The outcome of the parse so far.
+		 */
+		virtual void skipParse( ParseResult& result )
+		{
+			static_cast<void>(result); // Ignore input, don't warn
+		}
 };
 
 }
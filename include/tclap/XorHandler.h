@@ -28,6 +28,7 @@
 #include <tclap/Arg.h>
 #include <string>
 #include <vector>
+#include <map>
 #include <algorithm>
 #include <iostream>
 
@@ -46,15 +47,25 @@ class XorHandler
 		 */
 		std::vector< std::vector<Arg*> > _orList;
 
+		/**
+		 * The index in _orList of the list each Arg belongs to.  Kept
+		 * here rather than in the Arg, which can be xor'd in other
+		 * CmdLines too.
+		 */
+		std::map<const Arg*, int> _groups;
+
 	public:
 
 		/**
 		 * Constructor.  Does nothing.
 		 */
-		XorHandler( ) : _orList(std::vector< std::vector<Arg*> >()) {}
+		XorHandler( ) : _orList(std::vector< std::vector<Arg*> >()),
+		                _groups(std::map<const Arg*, int>()) {}
 
 		/**
-		 * Add a list of Arg*'s that will be xor'd together.
+		 * Add a list of Arg*'s that will be xor'd together.  An Arg can
+		 * only be part of one list of the handler, the first it is
+		 * added to.
 		 * \param ors - list of Arg* that will be xor'd.
 		 */
 		void add( const std::vector<Arg*>& ors );
@@ -62,11 +73,15 @@ class XorHandler
 		/**
 		 * Checks whether the specified Arg is in one of the xor lists and
 		 * if it does match one, returns the size of the xor list that the
-		 * Arg matched.  If the Arg matches, then it also sets the rest of
-		 * the Arg's in the list. You shouldn't use this.  
+		 * Arg matched.  If the Arg matches, then it is recorded as the
+		 * one set of the list in the result.  Returns 1 for a required Arg
+		 * that isn't xor'd.  If another Arg of the list was matched, the
+		 * error is recorded in the result and 0 is returned.  Called
+		 * when the Arg is first matched.  You shouldn't use this.
 		 * \param a - The Arg to be checked.
+		 * \param result - The outcome of the parse so far.
 		 */
-		int check( const Arg* a );
+		int check( const Arg* a, ParseResult& result ) const;
 
 		/**
 		 * Returns the XOR specific short usage.
@@ -84,7 +99,20 @@ class XorHandler
 		 * lists.
 		 * \param a - The Arg to be checked.
 		 */
-		bool contains( const Arg* a );
+		bool contains( const Arg* a ) const;
+
+		/**
+		 * Returns the index in getXorList() of the list that contains
+		 * the Arg, or -1 if the Arg isn't xor'd.
+		 * \param a - The Arg to be checked.
+		 */
+		int getXorGroup( const Arg* a ) const;
+
+		/**
+		 * The index of the list of each Arg that is xor'd, which the
+		 * ParseResults of the CmdLine look the Args up in.
+		 */
+		const std::map<const Arg*, int>& getXorGroups() const;
 
 		const std::vector< std::vector<Arg*> >& getXorList() const;
 
@@ -96,60 +124,67 @@ class XorHandler
 //////////////////////////////////////////////////////////////////////
 inline void XorHandler::add( const std::vector<Arg*>& ors )
 {
+	const int group = static_cast<int>(_orList.size());
+
 	_orList.push_back( ors );
+
+	for ( ArgVectorIterator it = ors.begin(); it != ors.end(); it++ )
+		_groups.insert( std::make_pair( static_cast<const Arg*>(*it),
+		                                group ) );
 }
 
-inline int XorHandler::check( const Arg* a ) 
+inline int XorHandler::check( const Arg* a, ParseResult& result ) const
 {
-	// iterate over each XOR list
-	for ( int i = 0; static_cast<unsigned int>(i) < _orList.size(); i++ )
+	const int group = getXorGroup( a );
+
+	if ( group < 0 )
 	{
-		// if the XOR list contains the arg..
-		ArgVectorIterator ait = std::find( _orList[i].begin(), 
-		                                   _orList[i].end(), a );
-		if ( ait != _orList[i].end() )
-		{
-			// first check to see if a mutually exclusive switch
-			// has not already been set
-			for ( ArgVectorIterator it = _orList[i].begin(); 
-				  it != _orList[i].end(); 
-				  it++ )
-				if ( a != (*it) && (*it)->isSet() )
-					throw(CmdLineParseException(
-					      "Mutually exclusive argument already set!",
-					      (*it)->toString()));
-
-			// go through and set each arg that is not a
-			for ( ArgVectorIterator it = _orList[i].begin(); 
-				  it != _orList[i].end(); 
-				  it++ )
-				if ( a != (*it) )
-					(*it)->xorSet();
-
-			// return the number of required args that have now been set
-			if ( (*ait)->allowMore() )
-				return 0;
-			else
-				return static_cast<int>(_orList[i].size());
-		}
+		if ( a->isRequired() )
+			return 1;
+		else
+			return 0;
 	}
 
-	if ( a->isRequired() )
-		return 1;
-	else
+	// first check to see if a mutually exclusive arg has not already
+	// been set, possibly before the parse if it continues from the Args
+	const Arg* set = result.getXorSet( group );
+	if ( set == NULL && result.continuesArgs() )
+		for ( ArgVectorIterator it = _orList[group].begin(); 
+			  it != _orList[group].end(); 
+			  it++ )
+			if ( a != (*it) && (*it)->isSet() )
+				set = *it;
+
+	if ( set != NULL && set != a )
+	{
+		result.setError( ParseResult::EXCLUSIVE_SET, set );
 		return 0;
+	}
+
+	result.setXorSet( group, a );
+
+	// return the number of required args that have now been set
+	return static_cast<int>(_orList[group].size());
+}
+
+inline bool XorHandler::contains( const Arg* a ) const
+{
+	return getXorGroup( a ) >= 0;
+}
+
+inline int XorHandler::getXorGroup( const Arg* a ) const
+{
+	std::map<const Arg*, int>::const_iterator it = _groups.find( a );
+
+	if ( it != _groups.end() )
+		return it->second;
+	else
+		return -1;
 }
 
-inline bool XorHandler::contains( const Arg* a )
+inline const std::map<const Arg*, int>& XorHandler::getXorGroups() const
 {
-	for ( int i = 0; static_cast<unsigned int>(i) < _orList.size(); i++ )
-		for ( ArgVectorIterator it = _orList[i].begin(); 
-			  it != _orList[i].end(); 
-			  it++ )	
-			if ( a == (*it) )
-				return true;
-
-	return false;
+	return _groups;
 }
 
 inline const std::vector< std::vector<Arg*> >& XorHandler::getXorList() const
@@ -87,11 +87,17 @@ class ZshCompletionOutput : public CmdLineOutput
 
 		std::map<std::string, std::string> common;
 		char theDelimiter;
+
+		/**
+		 * The number of the next unlabeled Arg printed by printArg().
+		 */
+		int argCount;
 };
 
-ZshCompletionOutput::ZshCompletionOutput()
+inline ZshCompletionOutput::ZshCompletionOutput()
 : common(std::map<std::string, std::string>()),
-  theDelimiter('=')
+  theDelimiter('='),
+  argCount(1)
 {
 	common["host"] = "_hosts";
 	common["hostname"] = "_hosts";
@@ -115,6 +121,7 @@ inline void ZshCompletionOutput::usage(CmdLineInterface& _cmd )
 	std::string progName = _cmd.getProgramName();
 	std::string xversion = _cmd.getVersion();
 	theDelimiter = _cmd.getDelimiter();
+	argCount = 1;
 	basename(progName);
 
 	std::cout << "#compdef " << progName << std::endl << std::endl <<
@@ -169,13 +176,11 @@ inline void ZshCompletionOutput::basename( std::string& s )
 
 inline void ZshCompletionOutput::printArg(Arg* a)
 {
-	static int count = 1;
-
 	std::cout << " \\" << std::endl << "  '";
 	if ( a->acceptsMultipleValues() )
 		std::cout << '*';
 	else
-		std::cout << count++;
+		std::cout << argCount++;
 	std::cout << ':';
 	if ( !a->isRequired() )
 		std::cout << ':';
@@ -283,8 +288,8 @@ inline void ZshCompletionOutput::printOption(Arg* a, std::string mutex)
 
 inline std::string ZshCompletionOutput::getMutexList( CmdLineInterface& _cmd, Arg* a)
 {
-	XorHandler xorHandler = _cmd.getXorHandler();
-	std::vector< std::vector<Arg*> > xorList = xorHandler.getXorList();
+	XorHandler& xorHandler = _cmd.getXorHandler();
+	const std::vector< std::vector<Arg*> >& xorList = xorHandler.getXorList();
 	
 	if (a->getName() == "help" || a->getName() == "version")
 	{
@@ -297,30 +302,25 @@ inline std::string ZshCompletionOutput::getMutexList( CmdLineInterface& _cmd, Ar
 		list << '*';
 	}
 
-	for ( int i = 0; static_cast<unsigned int>(i) < xorList.size(); i++ )
+	const int i = xorHandler.getXorGroup( a );
+	if ( i >= 0 )
 	{
-		for ( ArgVectorIterator it = xorList[i].begin();
-			it != xorList[i].end();
-			it++)
-		if ( a == (*it) )
+		list << '(';
+		for ( ArgVectorIterator iu = xorList[i].begin();
+			iu != xorList[i].end();
+			iu++ )
 		{
-			list << '(';
-			for ( ArgVectorIterator iu = xorList[i].begin();
-				iu != xorList[i].end();
-				iu++ )
-			{
-				bool notCur = (*iu) != a;
-				bool hasFlag = !(*iu)->getFlag().empty();
-				if ( iu != xorList[i].begin() && (notCur || hasFlag) )
-					list << ' ';
-				if (hasFlag)
-					list << (*iu)->flagStartChar() << (*iu)->getFlag() << ' ';
-				if ( notCur || hasFlag )
-					list << (*iu)->nameStartString() << (*iu)->getName();
-			}
-			list << ')';
-			return list.str();
+			bool notCur = (*iu) != a;
+			bool hasFlag = !(*iu)->getFlag().empty();
+			if ( iu != xorList[i].begin() && (notCur || hasFlag) )
+				list << ' ';
+			if (hasFlag)
+				list << (*iu)->flagStartChar() << (*iu)->getFlag() << ' ';
+			if ( notCur || hasFlag )
+				list << (*iu)->nameStartString() << (*iu)->getName();
 		}
+		list << ')';
+		return list.str();
 	}
 	
 	// wasn't found in xor list
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# failure, a list item doesn't meet the constraint
+./simple-test.sh `basename $0 .sh` test35 -i 3,17,300,42
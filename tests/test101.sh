@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# failure, a list item isn't a number
+./simple-test.sh `basename $0 .sh` test35 -w 1.5:2.5.5
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# this tests values that are converted when they are read
+./simple-test.sh `basename $0 .sh` test36 -n 3 -s 2.5 -l 1 -l 3
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# failure, an invalid value is only reported when it is read
+./simple-test.sh `basename $0 .sh` test36 -l 2 -s abc -n 4
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# failure, validateAll() reports an invalid value before any is read
+./simple-test.sh `basename $0 .sh` test36 -a -l 2 -l 7 -n 4
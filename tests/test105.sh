@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# this tests a large set of allowed values
+./simple-test.sh `basename $0 .sh` test37 -r eu-west-7 -r us-central-100 -p 8420
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# failure, the nearest allowed string is named
+./simple-test.sh `basename $0 .sh` test37 -r eu-wset-7
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# failure, the nearest allowed number is named
+./simple-test.sh `basename $0 .sh` test37 -r us-east-1 -p 8427
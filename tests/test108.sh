@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# this tests values checked against ranges
+./simple-test.sh `basename $0 .sh` test38 -p 443 -w 0.25,1,0.5 -w 0.125 -l 0
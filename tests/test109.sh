@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# failure, one item of a list is out of range
+./simple-test.sh `basename $0 .sh` test38 -w 0.5,0,0.25
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# the usage shows the ranges
+./simple-test.sh `basename $0 .sh` test38 --help
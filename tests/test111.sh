@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# this tests values that match patterns
+./simple-test.sh `basename $0 .sh` test39 -H build-01.example.com -t CORE-42 -t UI-7
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# failure, the pattern is named with the type description
+./simple-test.sh `basename $0 .sh` test39 -H build_01.example.com
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# failure, the pattern is shown
+./simple-test.sh `basename $0 .sh` test39 -H example.com -t core-42
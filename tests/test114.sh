@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# this tests a parse that doesn't throw, with valid values
+./simple-test.sh `basename $0 .sh` test40 -n homer -l 9 -w 1.5 -w 2
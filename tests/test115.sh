@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# failure without exceptions, the value doesn't meet the constraint
+./simple-test.sh `basename $0 .sh` test40 -n homer -l 101
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# failure without exceptions, a required arg is missing
+./simple-test.sh `basename $0 .sh` test40 -l 5
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# this tests a command string split as sh would do it
+./simple-test.sh `basename $0 .sh` test41 "copy -n 'two words' -f \"a \\\"b\\\"\" c\\ d ''"
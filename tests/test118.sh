@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# failure, a quote in the command string is not closed
+./simple-test.sh `basename $0 .sh` test41 "copy -n \"open -f"
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# failure, a required arg is missing from the command string
+./simple-test.sh `basename $0 .sh` test41 "copy -f"
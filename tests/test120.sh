@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# this tests parsing one argument at a time
+./simple-test.sh `basename $0 .sh` test42 -v -c 3 -vv -f a.txt b.txt
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# failure one argument at a time, xor'd args
+./simple-test.sh `basename $0 .sh` test42 -f a.txt -s
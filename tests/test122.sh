@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# failure one argument at a time, the value never comes
+./simple-test.sh `basename $0 .sh` test42 -v -c
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# bash completion script
+./simple-test.sh `basename $0 .sh` test43 -h
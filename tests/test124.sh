@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# fish completion script
+./simple-test.sh `basename $0 .sh` test43 -h x
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# completing the flags and names
+./simple-test.sh `basename $0 .sh` test44 --__complete 1 test44 -
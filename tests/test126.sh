@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# completing the names left after a xor'd switch
+./simple-test.sh `basename $0 .sh` test44 --__complete 2 test44 -q --
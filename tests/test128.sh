@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# completing the values of a CompletionProvider
+./simple-test.sh `basename $0 .sh` test44 --__complete 2 test44 --job
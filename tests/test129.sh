@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# completing an unlabeled arg
+./simple-test.sh `basename $0 .sh` test44 --__complete 3 test44 -m fast st
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# an ordinary parse of the completion example
+./simple-test.sh `basename $0 .sh` test44 -v -j job-3 start
@@ -0,0 +1,14 @@
+#!/bin/sh
+
+# the usage rendered when test45 was built, which needs the program name
+# it was rendered for
+PATH=../examples:$PATH
+export PATH
+test45 -h > tmp.out 2>&1
+
+if cmp -s tmp.out $srcdir/test131.out; then
+	exit 0
+else
+	exit 1
+fi
+
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# the usage rendered when it is printed, for another program name
+./simple-test.sh `basename $0 .sh` test45 -h
@@ -0,0 +1,13 @@
+#!/bin/sh
+
+# the man page written by the generator build of test45
+../examples/test45-gen test45 > tmp.out 2>&1 && cat test45.1 >> tmp.out
+rm -f test45.1 test45.xml test45.bash test45.fish test45.zsh test45.txt \
+	test45_usage.h
+
+if cmp -s tmp.out $srcdir/test133.out; then
+	exit 0
+else
+	exit 1
+fi
+
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# --__complete is an unknown argument unless setCompletion(true) is called
+./simple-test.sh `basename $0 .sh` test1 --__complete 1 test1 -
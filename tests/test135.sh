@@ -0,0 +1,4 @@
+#!/bin/sh
+# failure  validates that the exclusion of a combined switch by a switch
+# set earlier is reported for the excluded switch
+./simple-test.sh `basename $0 .sh` test20 -a -ab
@@ -0,0 +1,4 @@
+#!/bin/sh
+# failure  validates that a combined switch already set is reported
+# before the Visitor of another switch in the same token is checked
+./simple-test.sh `basename $0 .sh` test22 -rn -hr
@@ -0,0 +1,3 @@
+#!/bin/sh
+# failure  validates that an empty item of a list of numbers is invalid
+./simple-test.sh `basename $0 .sh` test35 -i 3,,17
@@ -0,0 +1,3 @@
+#!/bin/sh
+# success  a backslash at the end of the command string is kept, as sh does
+./simple-test.sh `basename $0 .sh` test41 "copy -n a -f b\\"
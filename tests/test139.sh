@@ -0,0 +1,19 @@
+#!/bin/sh
+
+# the completion cache is written for an account without a ~/.cache,
+# under a file name with the Arg name escaped
+HOME=`mktemp -d` || exit 1
+export HOME
+unset XDG_CACHE_HOME
+
+../examples/test44 --__complete 2 test44 --host/port > tmp.out 2>&1
+ls -ld "$HOME/.cache" | cut -c1-10 >> tmp.out
+ls "$HOME/.cache" >> tmp.out
+sed 1d "$HOME/.cache/tclap-test44-host%2Fport" >> tmp.out
+rm -rf "$HOME"
+
+if cmp -s tmp.out $srcdir/test139.out; then
+	exit 0
+else
+	exit 1
+fi
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# this tests adding several args at once
+./simple-test.sh `basename $0 .sh` test31 -c 3 --name bart
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# this tests parsing into separate ParseResults
+./simple-test.sh `basename $0 .sh` test32 -v -n homer -n marge file.txt
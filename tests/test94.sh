@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# this tests parsing a manifest of command lines in several threads
+./simple-test.sh `basename $0 .sh` test33 3
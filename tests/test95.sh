@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# this tests expanding response files
+./simple-test.sh `basename $0 .sh` test34 @test34-shell.rsp
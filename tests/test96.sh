@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# failure, int out of range
+./simple-test.sh `basename $0 .sh` test2 -i 2147483648 -f 4.2 -s asdf asdf
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# failure, float out of range
+./simple-test.sh `basename $0 .sh` test2 -i 2 -f 1e999 -s asdf asdf
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# success, signs and exponents
+./simple-test.sh `basename $0 .sh` test2 -i +7 -f -2.5e3 -s asdf asdf
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# this tests lists of values
+./simple-test.sh `basename $0 .sh` test35 -i 17,42,99 -i 3 -w 0.5:1e-3:-2 -t red,,green, -t blue